@@ -1,3 +1,7 @@
+#if !defined(_WIN32) && !defined(_POSIX_C_SOURCE)
+    #define _POSIX_C_SOURCE 200112L
+#endif
+
 #include <stdio.h>
 #include <stdlib.h>
 #include <stddef.h>
@@ -5,15 +9,45 @@
 #include <math.h>
 #include "truety.h"
 
+#ifdef _WIN32
+    #define WIN32_LEAN_AND_MEAN
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+    #define TTY_SSE2
+    #include <emmintrin.h>
+#endif
+
+// Computed gotos let each instruction jump straight to the next instruction's
+// handler. Other compilers dispatch the same decoded instructions through a
+// switch.
+#if defined(__GNUC__) && !defined(TTY_NO_COMPUTED_GOTO)
+    #define TTY_COMPUTED_GOTO
+#endif
+
 
 /* --------- */
 /* Constants */
 /* --------- */
-#define TTY_SCALAR_VERSION         40
-#define TTY_NUM_PHANTOM_POINTS     4
-#define TTY_ACTIVE_EDGES_PER_CHUNK 10
-#define TTY_SUBDIVIDE_SQRD_ERROR   0x1  /* 26.6 */
-#define TTY_PIXELS_PER_SCANLINE    0x10 /* 26.6 */
+#define TTY_SCALAR_VERSION                40
+#define TTY_NUM_PHANTOM_POINTS            4
+#define TTY_ACTIVE_EDGES_PER_CHUNK        10
+#define TTY_SUBDIVIDE_SQRD_ERROR          0x1  /* 26.6 */
+#define TTY_PIXELS_PER_SCANLINE           0x10 /* 26.6 */
+#define TTY_CMAP_PAGE_SIZE                256
+#define TTY_CMAP_NUM_PAGES                0x1100 /* Enough pages to cover U+0000 to U+10FFFF */
+#define TTY_CMAP_BMP_SIZE                 0x10000
+#define TTY_SNAPSHOT_VERSION              3
+#define TTY_SNAPSHOT_NULL_FUNC            0xFFFFFFFF
+#define TTY_FONT_SNAPSHOT_HEADER_SIZE     24
+#define TTY_INSTANCE_SNAPSHOT_HEADER_SIZE 32
+#define TTY_MAX_COMPONENT_DEPTH           16 /* Deeper nesting is treated as a cycle */
 
 
 /* --------- */
@@ -77,10 +111,10 @@
     #define TTY_LOGF(format, ...)\
         printf("\t"format"\n", __VA_ARGS__)
 
-    #define TTY_LOG_ZONE1_POINTS(font)\
+    #define TTY_LOG_ZONE1_POINTS(render)\
         printf("\n-- Results --\n");\
-        for (TTY_U32 i = 0; i < font->hint.zone1.numPoints; i++) {\
-            printf("%u) (%d, %d)\n", (unsigned int)i, (int)font->hint.zone1.cur[i].x, (int)font->hint.zone1.cur[i].y);\
+        for (TTY_U32 i = 0; i < render->zone1.numPoints; i++) {\
+            printf("%u) (%d, %d)\n", (unsigned int)i, (int)render->zone1.cur[i].x, (int)render->zone1.cur[i].y);\
         }\
         printf("\n");
 
@@ -92,7 +126,57 @@
     #define TTY_LOG_VALUE(val)
     #define TTY_LOG_INTERP_STACK_TOP(stack)
     #define TTY_LOGF(format, ...)
-    #define TTY_LOG_ZONE1_POINTS(font)
+    #define TTY_LOG_ZONE1_POINTS(render)
+#endif
+
+
+/* --------- */
+/* Profiling */
+/* --------- */
+// #define TTY_PROFILING
+
+#ifdef TTY_PROFILING
+    #ifndef _WIN32
+        #include <time.h>
+    #endif
+
+    static TTY_U64 tty_get_time_ns(void) {
+    #ifdef _WIN32
+        LARGE_INTEGER counter, freq;
+        QueryPerformanceCounter(&counter);
+        QueryPerformanceFrequency(&freq);
+        return (TTY_U64)((double)counter.QuadPart * 1e9 / (double)freq.QuadPart);
+    #else
+        struct timespec ts;
+        clock_gettime(CLOCK_MONOTONIC, &ts);
+        return (TTY_U64)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+    #endif
+    }
+
+    #define TTY_PROFILE_START(timer)\
+        TTY_U64 timer = tty_get_time_ns()
+
+    #define TTY_PROFILE_LAP(timer, result)\
+        do {\
+            TTY_U64 now = tty_get_time_ns();\
+            (result)   += now - (timer);\
+            (timer)     = now;\
+        } while (0)
+
+    #define TTY_PROFILE_ADD(result, val)\
+        (result) += (val)
+
+    #define TTY_PROFILE_INIT_CTX(ctx)\
+        (ctx).numInsExecuted = 0
+
+    #define TTY_PROFILE_INS(ctx)\
+        (ctx)->numInsExecuted++
+#else
+    #define TTY_PROFILE_START(timer)
+    #define TTY_PROFILE_LAP(timer, result)
+    #define TTY_PROFILE_ADD(result, val)
+    #define TTY_PROFILE_INIT_CTX(ctx)
+    #define TTY_PROFILE_INS(ctx)
 #endif
 
 
@@ -102,6 +186,8 @@
 #define TTY_TAG_EQUALS(tag, val)\
     !memcmp(tag, val, 4)
 
+#define TTY_HASH(key) (177573 + key)
+
 #ifdef __cplusplus
     #include <type_traits>
     #define TTY_ALIGN_OF(type) std::alignment_of<type>::value
@@ -109,22 +195,124 @@
     #define TTY_ALIGN_OF(type) _Alignof(type)
 #endif
 
-static TTY_U16 tty_get_u16(TTY_U8* data) {
+static TTY_U16 tty_get_u16(const TTY_U8* data) {
     return data[0] << 8 | data[1];
 }
 
-static TTY_U32 tty_get_u32(TTY_U8* data) {
+static TTY_U32 tty_get_u32(const TTY_U8* data) {
     return (data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
 }
 
-static TTY_S16 tty_get_s16(TTY_U8* data) {
+static TTY_S16 tty_get_s16(const TTY_U8* data) {
     return data[0] << 8 | data[1];
 }
 
-// static TTY_S32 tty_get_s32(TTY_U8* data) {
+static void tty_set_u16(TTY_U8* data, TTY_U16 val) {
+    data[0] = val >> 8;
+    data[1] = val & 0xFF;
+}
+
+static void tty_set_u32(TTY_U8* data, TTY_U32 val) {
+    data[0] = val >> 24;
+    data[1] = (val >> 16) & 0xFF;
+    data[2] = (val >>  8) & 0xFF;
+    data[3] = val & 0xFF;
+}
+
+static TTY_U64 tty_get_u64(const TTY_U8* data) {
+    return ((TTY_U64)tty_get_u32(data) << 32) | tty_get_u32(data + 4);
+}
+
+static void tty_set_u64(TTY_U8* data, TTY_U64 val) {
+    tty_set_u32(data, val >> 32);
+    tty_set_u32(data + 4, val & 0xFFFFFFFF);
+}
+
+// 64-bit FNV-1a
+static TTY_U64 tty_hash_bytes(TTY_U64 hash, const TTY_U8* data, TTY_U32 size) {
+    for (TTY_U32 i = 0; i < size; i++) {
+        hash ^= data[i];
+        hash *= 0x100000001B3ull;
+    }
+    return hash;
+}
+
+// static TTY_S32 tty_get_s32(const TTY_U8* data) {
 //     return (data[0] << 24) | (data[1] << 16) | (data[2] << 8) | data[3];
 // }
 
+// Returns the number of leading bytes that are ASCII
+static TTY_U32 tty_get_ascii_run_length(const TTY_U8* data, TTY_U32 len) {
+    TTY_U32 i = 0;
+
+#ifdef TTY_SSE2
+    for (; i + 16 <= len; i += 16) {
+        __m128i bytes = _mm_loadu_si128((const __m128i*)(data + i));
+        if (_mm_movemask_epi8(bytes) != 0) {
+            break;
+        }
+    }
+#else
+    for (; i + 8 <= len; i += 8) {
+        TTY_U64 bytes;
+        memcpy(&bytes, data + i, 8);
+        if (bytes & 0x8080808080808080ull) {
+            break;
+        }
+    }
+#endif
+
+    while (i < len && data[i] < 0x80) {
+        i++;
+    }
+
+    return i;
+}
+
+// Decodes a single non-ASCII code point and returns the number of bytes 
+// consumed. Malformed sequences decode to U+FFFD and consume their longest
+// valid prefix, or one byte if the lead byte is invalid.
+static TTY_U32 tty_decode_utf8(const TTY_U8* data, TTY_U32 len, TTY_U32* cp) {
+    TTY_U32 numContBytes;
+    TTY_U8  contMin = 0x80;
+    TTY_U8  contMax = 0xBF;
+
+    if (data[0] >= 0xC2 && data[0] <= 0xDF) {
+        numContBytes = 1;
+        *cp          = data[0] & 0x1F;
+    }
+    else if (data[0] >= 0xE0 && data[0] <= 0xEF) {
+        // Reject overlong encodings and surrogates
+        numContBytes = 2;
+        *cp          = data[0] & 0x0F;
+        contMin      = data[0] == 0xE0 ? 0xA0 : 0x80;
+        contMax      = data[0] == 0xED ? 0x9F : 0xBF;
+    }
+    else if (data[0] >= 0xF0 && data[0] <= 0xF4) {
+        // Reject overlong encodings and code points above U+10FFFF
+        numContBytes = 3;
+        *cp          = data[0] & 0x07;
+        contMin      = data[0] == 0xF0 ? 0x90 : 0x80;
+        contMax      = data[0] == 0xF4 ? 0x8F : 0xBF;
+    }
+    else {
+        *cp = 0xFFFD;
+        return 1;
+    }
+
+    for (TTY_U32 i = 1; i <= numContBytes; i++) {
+        if (i >= len || data[i] < contMin || data[i] > contMax) {
+            *cp = 0xFFFD;
+            return i;
+        }
+        *cp     = (*cp << 6) | (data[i] & 0x3F);
+        contMin = 0x80;
+        contMax = 0xBF;
+    }
+
+    return numContBytes + 1;
+}
+
 static size_t tty_pad_to_align(size_t size, size_t alignment) {
     if (alignment == 1 || size % alignment == 0) {
         return size;
@@ -134,7 +322,7 @@ static size_t tty_pad_to_align(size_t size, size_t alignment) {
 
 static size_t tty_calc_mem_size(size_t* total, size_t amount, size_t alignment) {
     size_t totalCopy = ((*total) += amount);
-    (*total) += tty_pad_to_align(*total, alignment);
+    (*total)  = tty_pad_to_align(*total, alignment);
     amount   += *total - totalCopy;
     return amount;
 }
@@ -383,6 +571,28 @@ static void tty_normalize_f26dot6_to_f2dot14(TTY_V2* v) {
     }
 }
 
+static TTY_U32 tty_isqrt(TTY_U64 val) {
+    TTY_U64 root = 0;
+    TTY_U64 bit  = (TTY_U64)1 << 62;
+
+    while (bit > val) {
+        bit >>= 2;
+    }
+
+    while (bit != 0) {
+        if (val >= root + bit) {
+            val  -= root + bit;
+            root  = (root >> 1) + bit;
+        }
+        else {
+            root >>= 1;
+        }
+        bit >>= 2;
+    }
+
+    return (TTY_U32)root;
+}
+
 static void tty_max_min(TTY_S32 a, TTY_S32 b, TTY_S32* max, TTY_S32* min) {
     if (a > b) {
         *max = a;
@@ -532,95 +742,423 @@ enum {
     TTY_WS         = 0x42,
 };
 
-struct TTY_Program_Context;
-
-typedef struct {
-    void     (*execute_next_ins)(struct TTY_Program_Context*);
-    TTY_U8*  buff;
-    TTY_U32  off;
-    TTY_U32  cap;
-} TTY_Ins_Stream;
+/* Instructions are decoded into ops whose codes select the function that 
+   executes them. The codes are ordered so that the ops each kind of program 
+   can use form a contiguous range: the font program can only use FDEF and 
+   PUSH, the CV program can use FDEF and the shared ops, and glyph programs 
+   can use PUSH, the shared ops, and the glyph ops. */
+enum {
+    TTY_OP_FDEF,
+    TTY_OP_PUSH, /* PUSHB, PUSHW, NPUSHB, and NPUSHW */
+
+    // Shared ops
+    TTY_OP_ABS,
+    TTY_OP_ADD,
+    TTY_OP_AND,
+    TTY_OP_CALL,
+    TTY_OP_CINDEX,
+    TTY_OP_DELTAC1,
+    TTY_OP_DELTAC2,
+    TTY_OP_DELTAC3,
+    TTY_OP_DEPTH,
+    TTY_OP_DIV,
+    TTY_OP_DUP,
+    TTY_OP_EIF,
+    TTY_OP_ELSE,
+    TTY_OP_EQ,
+    TTY_OP_FLOOR,
+    TTY_OP_GETINFO,
+    TTY_OP_GPV,
+    TTY_OP_GT,
+    TTY_OP_GTEQ,
+    TTY_OP_IF,
+    TTY_OP_JMPR,
+    TTY_OP_JROT,
+    TTY_OP_LOOPCALL,
+    TTY_OP_LT,
+    TTY_OP_LTEQ,
+    TTY_OP_MAX,
+    TTY_OP_MIN,
+    TTY_OP_MINDEX,
+    TTY_OP_MPPEM,
+    TTY_OP_MUL,
+    TTY_OP_NEG,
+    TTY_OP_NEQ,
+    TTY_OP_NOT,
+    TTY_OP_OR,
+    TTY_OP_POP,
+    TTY_OP_RCVT,
+    TTY_OP_RDTG,
+    TTY_OP_ROFF,
+    TTY_OP_ROLL,
+    TTY_OP_ROUND,
+    TTY_OP_RS,
+    TTY_OP_RTDG,
+    TTY_OP_RTG,
+    TTY_OP_RTHG,
+    TTY_OP_RUTG,
+    TTY_OP_SCANCTRL,
+    TTY_OP_SCANTYPE,
+    TTY_OP_SCVTCI,
+    TTY_OP_SDB,
+    TTY_OP_SDS,
+    TTY_OP_SFVTCA,
+    TTY_OP_SFVTPV,
+    TTY_OP_SLOOP,
+    TTY_OP_SPVTCA,
+    TTY_OP_SUB,
+    TTY_OP_SVTCA,
+    TTY_OP_SWAP,
+    TTY_OP_WCVTF,
+    TTY_OP_WCVTP,
+    TTY_OP_WS,
+
+    // Glyph ops
+    TTY_OP_ALIGNRP,
+    TTY_OP_DELTAP1,
+    TTY_OP_DELTAP2,
+    TTY_OP_DELTAP3,
+    TTY_OP_GC,
+    TTY_OP_IP,
+    TTY_OP_ISECT,
+    TTY_OP_IUP,
+    TTY_OP_MD,
+    TTY_OP_MDAP,
+    TTY_OP_MDRP,
+    TTY_OP_MIAP,
+    TTY_OP_MIRP,
+    TTY_OP_SDPVTL,
+    TTY_OP_SFVTL,
+    TTY_OP_SHP,
+    TTY_OP_SHPIX,
+    TTY_OP_SMD,
+    TTY_OP_SRP0,
+    TTY_OP_SRP1,
+    TTY_OP_SRP2,
+    TTY_OP_SZPS,
+    TTY_OP_SZP0,
+    TTY_OP_SZP1,
+    TTY_OP_SZP2,
+
+    TTY_OP_UNKNOWN, /* Also used for instructions that are truncated */
+    TTY_NUM_OP_CODES,
+
+    TTY_OP_LAST_SHARED = TTY_OP_WS,
+    TTY_OP_LAST_GLYPH  = TTY_OP_SZP2,
+};
 
 typedef struct TTY_Program_Context {
-    TTY_Font*        font;
-    TTY_Instance*    instance;
-    TTY_Glyph*       glyph;
-    TTY_Ins_Stream   stream;
-    TTY_U8           iupState;
-    TTY_Bool         foundUnknownIns; /* TODO: This can be removed once all instructions are implemented. */
+    TTY_Font*            font;
+    TTY_Instance*        instance;
+    TTY_Glyph*           glyph;
+    TTY_Render_Context*  render;    /* Provides zone1, the stack, and the graphics state */
+    TTY_CVT*             cvt;       /* The instance's, or the render context's copy while a glyph program executes */
+    TTY_Storage_Area*    storage;   /* Same as cvt */
+    TTY_Zone*            zone0;     /* Same as cvt */
+    TTY_Program*         program;   /* The program or function body that is executing */
+    TTY_U32              opIdx;     /* The index of the next op to execute */
+    TTY_U8               firstCode; /* Ops with codes outside of [firstCode, lastCode] are unknown to the program */
+    TTY_U8               lastCode;
+    TTY_U8               iupState;
+    TTY_Bool             foundUnknownIns; /* TODO: This can be removed once all instructions are implemented. */
+#ifdef TTY_PROFILING
+    TTY_U32              numInsExecuted;
+#endif
 } TTY_Program_Context;
 
 
-static TTY_Bool tty_ins_stream_has_next(TTY_Ins_Stream* stream) {
-    return stream->off < stream->cap;
-}
+static TTY_U8 tty_get_op_code(TTY_U8 ins) {
+    switch (ins) {
+        case TTY_ABS:      return TTY_OP_ABS;
+        case TTY_ADD:      return TTY_OP_ADD;
+        case TTY_ALIGNRP:  return TTY_OP_ALIGNRP;
+        case TTY_AND:      return TTY_OP_AND;
+        case TTY_CALL:     return TTY_OP_CALL;
+        case TTY_CINDEX:   return TTY_OP_CINDEX;
+        case TTY_DELTAC1:  return TTY_OP_DELTAC1;
+        case TTY_DELTAC2:  return TTY_OP_DELTAC2;
+        case TTY_DELTAC3:  return TTY_OP_DELTAC3;
+        case TTY_DELTAP1:  return TTY_OP_DELTAP1;
+        case TTY_DELTAP2:  return TTY_OP_DELTAP2;
+        case TTY_DELTAP3:  return TTY_OP_DELTAP3;
+        case TTY_DEPTH:    return TTY_OP_DEPTH;
+        case TTY_DIV:      return TTY_OP_DIV;
+        case TTY_DUP:      return TTY_OP_DUP;
+        case TTY_EIF:      return TTY_OP_EIF;
+        case TTY_ELSE:     return TTY_OP_ELSE;
+        case TTY_EQ:       return TTY_OP_EQ;
+        case TTY_FDEF:     return TTY_OP_FDEF;
+        case TTY_FLOOR:    return TTY_OP_FLOOR;
+        case TTY_GETINFO:  return TTY_OP_GETINFO;
+        case TTY_GPV:      return TTY_OP_GPV;
+        case TTY_GT:       return TTY_OP_GT;
+        case TTY_GTEQ:     return TTY_OP_GTEQ;
+        case TTY_IF:       return TTY_OP_IF;
+        case TTY_IP:       return TTY_OP_IP;
+        case TTY_ISECT:    return TTY_OP_ISECT;
+        case TTY_JMPR:     return TTY_OP_JMPR;
+        case TTY_JROT:     return TTY_OP_JROT;
+        case TTY_LOOPCALL: return TTY_OP_LOOPCALL;
+        case TTY_LT:       return TTY_OP_LT;
+        case TTY_LTEQ:     return TTY_OP_LTEQ;
+        case TTY_MAX:      return TTY_OP_MAX;
+        case TTY_MIN:      return TTY_OP_MIN;
+        case TTY_MINDEX:   return TTY_OP_MINDEX;
+        case TTY_MPPEM:    return TTY_OP_MPPEM;
+        case TTY_MUL:      return TTY_OP_MUL;
+        case TTY_NEG:      return TTY_OP_NEG;
+        case TTY_NEQ:      return TTY_OP_NEQ;
+        case TTY_NOT:      return TTY_OP_NOT;
+        case TTY_NPUSHB:   return TTY_OP_PUSH;
+        case TTY_NPUSHW:   return TTY_OP_PUSH;
+        case TTY_OR:       return TTY_OP_OR;
+        case TTY_POP:      return TTY_OP_POP;
+        case TTY_RCVT:     return TTY_OP_RCVT;
+        case TTY_RDTG:     return TTY_OP_RDTG;
+        case TTY_ROFF:     return TTY_OP_ROFF;
+        case TTY_ROLL:     return TTY_OP_ROLL;
+        case TTY_RS:       return TTY_OP_RS;
+        case TTY_RTDG:     return TTY_OP_RTDG;
+        case TTY_RTG:      return TTY_OP_RTG;
+        case TTY_RTHG:     return TTY_OP_RTHG;
+        case TTY_RUTG:     return TTY_OP_RUTG;
+        case TTY_SCANCTRL: return TTY_OP_SCANCTRL;
+        case TTY_SCANTYPE: return TTY_OP_SCANTYPE;
+        case TTY_SCVTCI:   return TTY_OP_SCVTCI;
+        case TTY_SDB:      return TTY_OP_SDB;
+        case TTY_SDS:      return TTY_OP_SDS;
+        case TTY_SFVTPV:   return TTY_OP_SFVTPV;
+        case TTY_SHPIX:    return TTY_OP_SHPIX;
+        case TTY_SLOOP:    return TTY_OP_SLOOP;
+        case TTY_SMD:      return TTY_OP_SMD;
+        case TTY_SRP0:     return TTY_OP_SRP0;
+        case TTY_SRP1:     return TTY_OP_SRP1;
+        case TTY_SRP2:     return TTY_OP_SRP2;
+        case TTY_SUB:      return TTY_OP_SUB;
+        case TTY_SWAP:     return TTY_OP_SWAP;
+        case TTY_SZPS:     return TTY_OP_SZPS;
+        case TTY_SZP0:     return TTY_OP_SZP0;
+        case TTY_SZP1:     return TTY_OP_SZP1;
+        case TTY_SZP2:     return TTY_OP_SZP2;
+        case TTY_WCVTF:    return TTY_OP_WCVTF;
+        case TTY_WCVTP:    return TTY_OP_WCVTP;
+        case TTY_WS:       return TTY_OP_WS;
+    }
 
-static TTY_U8 tty_ins_stream_next(TTY_Ins_Stream* stream) {
-    TTY_ASSERT(tty_ins_stream_has_next(stream));
-    return stream->buff[stream->off++];
+    if (ins >= TTY_PUSHB && ins <= TTY_PUSHB_MAX) {
+        return TTY_OP_PUSH;
+    }
+    if (ins >= TTY_PUSHW && ins <= TTY_PUSHW_MAX) {
+        return TTY_OP_PUSH;
+    }
+    if (ins >= TTY_GC && ins <= TTY_GC_MAX) {
+        return TTY_OP_GC;
+    }
+    if (ins >= TTY_IUP && ins <= TTY_IUP_MAX) {
+        return TTY_OP_IUP;
+    }
+    if (ins >= TTY_MD && ins <= TTY_MD_MAX) {
+        return TTY_OP_MD;
+    }
+    if (ins >= TTY_MDAP && ins <= TTY_MDAP_MAX) {
+        return TTY_OP_MDAP;
+    }
+    if (ins >= TTY_MDRP && ins <= TTY_MDRP_MAX) {
+        return TTY_OP_MDRP;
+    }
+    if (ins >= TTY_MIAP && ins <= TTY_MIAP_MAX) {
+        return TTY_OP_MIAP;
+    }
+    if (ins >= TTY_MIRP && ins <= TTY_MIRP_MAX) {
+        return TTY_OP_MIRP;
+    }
+    if (ins >= TTY_ROUND && ins <= TTY_ROUND_MAX) {
+        return TTY_OP_ROUND;
+    }
+    if (ins >= TTY_SDPVTL && ins <= TTY_SDPVTL_MAX) {
+        return TTY_OP_SDPVTL;
+    }
+    if (ins >= TTY_SFVTCA && ins <= TTY_SFVTCA_MAX) {
+        return TTY_OP_SFVTCA;
+    }
+    if (ins >= TTY_SFVTL && ins <= TTY_SFVTL_MAX) {
+        return TTY_OP_SFVTL;
+    }
+    if (ins >= TTY_SHP && ins <= TTY_SHP_MAX) {
+        return TTY_OP_SHP;
+    }
+    if (ins >= TTY_SPVTCA && ins <= TTY_SPVTCA_MAX) {
+        return TTY_OP_SPVTCA;
+    }
+    if (ins >= TTY_SVTCA && ins <= TTY_SVTCA_MAX) {
+        return TTY_OP_SVTCA;
+    }
+    return TTY_OP_UNKNOWN;
 }
 
-static TTY_U8* tty_ins_stream_next_ptr(TTY_Ins_Stream* stream) {
-    TTY_ASSERT(tty_ins_stream_has_next(stream));
-    return stream->buff + stream->off++;
-}
+// Decodes the instructions in bytes into ops. The values of push instructions
+// are read once here so that executing a push is a copy into the stack. If 
+// ops is NULL, the ops and values are only counted so that the caller can 
+// allocate them.
+static void tty_decode_program(TTY_U8* bytes, TTY_U32 size, TTY_Op* ops, TTY_S32* values, TTY_U32* numOps, TTY_U32* numValues) {
+    TTY_U32 opCount    = 0;
+    TTY_U32 valueCount = 0;
+    TTY_U32 off        = 0;
 
-static TTY_U8 tty_ins_stream_peek(TTY_Ins_Stream* stream) {
-    TTY_ASSERT(tty_ins_stream_has_next(stream));
-    return stream->buff[stream->off];
-}
+    while (off < size) {
+        TTY_U32 byteOff = off;
+        TTY_U8  ins     = bytes[off++];
+        TTY_U8  code    = tty_get_op_code(ins);
+        TTY_U32 count   = 0;
+        TTY_U32 width   = 1;
 
-static void tty_ins_stream_consume(TTY_Ins_Stream* stream) {
-    TTY_ASSERT(tty_ins_stream_has_next(stream));
-    stream->off++;
-}
+        if (code == TTY_OP_PUSH) {
+            if (ins == TTY_NPUSHB || ins == TTY_NPUSHW) {
+                count = off < size ? bytes[off++] : 0xFFFFFFFF;
+            }
+            else {
+                count = 1 + (ins & 0x7);
+            }
 
-#ifdef TTY_DEBUG
-static TTY_Bool tty_ins_stream_can_jump(TTY_Ins_Stream* stream, TTY_S32 count) {
-    return count < 0 ? -count <= stream->off : stream->off < stream->cap - count;
-}
-#endif
+            if (ins == TTY_NPUSHW || (ins >= TTY_PUSHW && ins <= TTY_PUSHW_MAX)) {
+                width = 2;
+            }
+
+            if (count == 0xFFFFFFFF || count * width > size - off) {
+                // The values run past the end of the program
+                code  = TTY_OP_UNKNOWN;
+                count = 0;
+                off   = size;
+            }
+        }
+
+        if (ops != NULL) {
+            TTY_Op* op    = ops + opCount;
+            op->code      = code;
+            op->ins       = ins;
+            op->numValues = count;
+            op->valueOff  = valueCount;
+            op->byteOff   = byteOff;
 
-static void tty_ins_stream_jump(TTY_Ins_Stream* stream, TTY_S32 count) {
-    TTY_ASSERT(tty_ins_stream_can_jump(stream, count));
-    stream->off += count;
+            for (TTY_U32 i = 0; i < count; i++) {
+                values[valueCount + i] = width == 1 ? bytes[off + i] : tty_get_s16(bytes + off + 2 * i);
+            }
+        }
+
+        off += count * width;
+        valueCount += count;
+        opCount++;
+    }
+
+    *numOps    = opCount;
+    *numValues = valueCount;
 }
 
-static TTY_U8 tty_ins_stream_jump_to_else_or_eif(TTY_Ins_Stream* stream) {
+// Finds the ELSE or EIF that ends the IF block which contains the op at idx. 
+// If stopAtElse is false, or if the block has no ELSE, the EIF is found.
+static TTY_U32 tty_find_end_of_branch(TTY_Op* ops, TTY_U32 numOps, TTY_U32 idx, TTY_Bool stopAtElse) {
     TTY_U32 numNested = 0;
 
-    while (TTY_TRUE) {
-        TTY_U8 ins = tty_ins_stream_next(stream);
+    for (; idx < numOps; idx++) {
+        TTY_U8 code = ops[idx].code;
 
-        if (ins >= TTY_PUSHB && ins <= TTY_PUSHB_MAX) {
-            tty_ins_stream_jump(stream, 1 + (ins & 0x7));
-        }
-        else if (ins >= TTY_PUSHW && ins <= TTY_PUSHW_MAX) {
-            tty_ins_stream_jump(stream, 2 * (1 + (ins & 0x7)));
-        }
-        else if (ins == TTY_NPUSHB) {
-            tty_ins_stream_jump(stream, tty_ins_stream_next(stream));
+        if (code == TTY_OP_IF) {
+            numNested++;
         }
-        else if (ins == TTY_NPUSHW) {
-            tty_ins_stream_jump(stream, 2 * tty_ins_stream_next(stream));
+        else if (code == TTY_OP_EIF) {
+            if (numNested == 0) {
+                return idx;
+            }
+            numNested--;
         }
-        else if (ins == TTY_IF) {
-            numNested++;
+        else if (code == TTY_OP_ELSE && numNested == 0 && stopAtElse) {
+            return idx;
         }
-        else if (numNested == 0) {
-            if (ins == TTY_EIF || ins == TTY_ELSE) {
-                return ins;
+    }
+
+    return idx;
+}
+
+// Decodes a program and builds its control flow tables. branchOffs needs room
+// for an entry per op and opIdxs needs room for an entry per byte plus one.
+static void tty_program_init(TTY_Program* program, TTY_U8* bytes, TTY_U32 size, TTY_Op* ops, TTY_S32* values, TTY_U32* branchOffs, TTY_U32* opIdxs) {
+    TTY_U32 numValues;
+    program->ops        = ops;
+    program->values     = values;
+    program->bytes      = bytes;
+    program->branchOffs = branchOffs;
+    program->opIdxs     = opIdxs;
+    program->opIdxBase  = 0;
+    program->start      = 0;
+    program->end        = size;
+    tty_decode_program(bytes, size, ops, values, &program->numOps, &numValues);
+
+    // Bytes inside of an instruction map to the instruction that follows it
+    {
+        TTY_U32 byteOff = 0;
+        for (TTY_U32 i = 0; i < program->numOps; i++) {
+            while (byteOff <= ops[i].byteOff) {
+                opIdxs[byteOff++] = i;
             }
         }
-        else if (ins == TTY_EIF) {
-            numNested--;
+        while (byteOff <= size) {
+            opIdxs[byteOff++] = program->numOps;
         }
     }
 
-    TTY_ASSERT(0);
-    return 0;
+    // An unterminated block or function skips to the end of the program
+    for (TTY_U32 i = 0; i < program->numOps; i++) {
+        TTY_U32 next = i + 1;
+
+        switch (ops[i].code) {
+            case TTY_OP_IF:
+                next = tty_find_end_of_branch(ops, program->numOps, i + 1, TTY_TRUE) + 1;
+                break;
+            case TTY_OP_ELSE:
+                next = tty_find_end_of_branch(ops, program->numOps, i + 1, TTY_FALSE) + 1;
+                break;
+            case TTY_OP_FDEF:
+                while (next < program->numOps && ops[next].ins != TTY_ENDF) {
+                    next++;
+                }
+                next++;
+                break;
+        }
+
+        branchOffs[i] = next - i;
+    }
+}
+
+// Creates a function body from the ops in [startIdx, endIdx) of the program 
+// that defines it. The body shares the program's ops, values, and control 
+// flow tables.
+static void tty_program_init_body(TTY_Program* body, TTY_Program* program, TTY_U32 startIdx, TTY_U32 endIdx) {
+    body->ops        = program->ops + startIdx;
+    body->values     = program->values;
+    body->bytes      = program->bytes;
+    body->branchOffs = program->branchOffs + startIdx;
+    body->opIdxs     = program->opIdxs;
+    body->opIdxBase  = program->opIdxBase + startIdx;
+    body->numOps     = endIdx - startIdx;
+    body->start      = startIdx < program->numOps ? program->ops[startIdx].byteOff : program->end;
+    body->end        = endIdx   < program->numOps ? program->ops[endIdx].byteOff   : program->end;
+}
+
+// Skips the ops of a taken branch or function definition
+static void tty_skip_ops(TTY_Program_Context* ctx) {
+    ctx->opIdx += ctx->program->branchOffs[ctx->opIdx - 1] - 1;
 }
 
+// Jumps relative to the offset of the op that is executing
+static void tty_jump(TTY_Program_Context* ctx, TTY_S32 off) {
+    TTY_Program* program = ctx->program;
+    TTY_S64      target  = (TTY_S64)program->ops[ctx->opIdx - 1].byteOff + off;
+    TTY_ASSERT(target >= program->start && target <= program->end);
+    
+    target     = TTY_MAX(target, program->start);
+    target     = TTY_MIN(target, program->end);
+    ctx->opIdx = program->opIdxs[target] - program->opIdxBase;
+}
 
 static void tty_interp_stack_clear(TTY_Interp_Stack* stack) {
     stack->count = 0;
@@ -636,59 +1174,90 @@ static TTY_S32 tty_interp_stack_pop(TTY_Interp_Stack* stack) {
     return stack->buff[--stack->count];
 }
 
-static void tty_interp_stack_push_bytes_from_stream(TTY_Interp_Stack* stack, TTY_Ins_Stream* stream, TTY_U8 count) {
-    do {
-        TTY_U8 byte = tty_ins_stream_next(stream);
-        tty_interp_stack_push(stack, byte);
-    } while (--count != 0);
-}
 
-static void tty_interp_stack_push_words_from_stream(TTY_Interp_Stack* stack, TTY_Ins_Stream* stream, TTY_U8 count) {
-    do {
-        TTY_S8  ms  = tty_ins_stream_next(stream);
-        TTY_U8  ls  = tty_ins_stream_next(stream);
-        TTY_S32 val = (ms << 8) | ls;
-        tty_interp_stack_push(stack, val);
-    } while (--count != 0);
-}
+static void tty_execute_ops(TTY_Program_Context* ctx);
+
+// Looks up the compiled code of a function from the location of its 
+// instructions in the file, which is how snapshots identify functions too
+static void tty_bind_compiled_func(TTY_Font* font, TTY_U32 funcId) {
+    if (font->compiledRuntime.funcs == NULL) {
+        return;
+    }
+
+    const TTY_Compiled_Module* module   = font->compiledModule;
+    TTY_Program*               body     = font->hint.funcs.bodies + funcId;
+    TTY_Compiled_Program       compiled = NULL;
+
+    if (module != NULL && body->ops != NULL) {
+        TTY_U32 off  = body->bytes - font->fileData + body->start;
+        TTY_U32 size = body->end - body->start;
+        TTY_U32 low  = 0;
+        TTY_U32 high = module->numFuncs;
+
+        while (low < high) {
+            TTY_U32 mid = (low + high) / 2;
+            if (module->funcs[mid].off < off) {
+                low = mid + 1;
+            }
+            else {
+                high = mid;
+            }
+        }
+
+        if (low < module->numFuncs && module->funcs[low].off == off && module->funcs[low].size == size) {
+            compiled = module->funcs[low].program;
+        }
+    }
 
+    font->compiledRuntime.funcs[funcId] = compiled;
+}
 
 static void tty_call_func(TTY_Program_Context* ctx, TTY_U32 funcId, TTY_U32 count) {
     TTY_ASSERT(funcId < ctx->font->hint.funcs.cap);
-    TTY_ASSERT(ctx->font->hint.funcs.insPtrs[funcId] != NULL);
+    TTY_ASSERT(ctx->font->hint.funcs.bodies[funcId].ops != NULL);
 
     TTY_LOG_VALUE(funcId);
 
-    TTY_Ins_Stream streamCpy = ctx->stream;
-    ctx->stream.buff = ctx->font->hint.funcs.insPtrs[funcId];
-    ctx->stream.cap  = ctx->font->hint.funcs.sizes  [funcId];
-
-    while (count > 0) {
-        ctx->stream.off = 0;
-
-        while (tty_ins_stream_has_next(&ctx->stream)) {
-            ctx->stream.execute_next_ins(ctx);
-            if (ctx->foundUnknownIns) {
+    if (ctx->font->compiledRuntime.funcs != NULL && ctx->font->compiledRuntime.funcs[funcId] != NULL) {
+        TTY_Compiled_Program compiled = ctx->font->compiledRuntime.funcs[funcId];
+        while (count > 0) {
+            if (!compiled(ctx, &ctx->font->compiledRuntime, &ctx->render->stack)) {
+                // Compiled code also stops when the stack over- or underflows
+                ctx->foundUnknownIns = TTY_TRUE;
                 break;
             }
+            count--;
         }
+        return;
+    }
 
+    TTY_Program* programCpy = ctx->program;
+    TTY_U32      opIdxCpy   = ctx->opIdx;
+    ctx->program = ctx->font->hint.funcs.bodies + funcId;
+
+    while (count > 0) {
+        ctx->opIdx = 0;
+        tty_execute_ops(ctx);
+        if (ctx->foundUnknownIns) {
+            break;
+        }
         count--;
     }
 
-    ctx->stream = streamCpy;
+    ctx->program = programCpy;
+    ctx->opIdx   = opIdxCpy;
 }
 
 static TTY_S32 tty_proj(TTY_Program_Context* ctx, TTY_V2* v) {
     return 
-        TTY_F2DOT14_MUL(v->x, ctx->font->hint.gs.projVec.x) + 
-        TTY_F2DOT14_MUL(v->y, ctx->font->hint.gs.projVec.y);
+        TTY_F2DOT14_MUL(v->x, ctx->render->gs.projVec.x) + 
+        TTY_F2DOT14_MUL(v->y, ctx->render->gs.projVec.y);
 }
 
 static TTY_S32 tty_dual_proj(TTY_Program_Context* ctx, TTY_V2* v) {
     return 
-        TTY_F2DOT14_MUL(v->x, ctx->font->hint.gs.dualProjVec.x) + 
-        TTY_F2DOT14_MUL(v->y, ctx->font->hint.gs.dualProjVec.y);
+        TTY_F2DOT14_MUL(v->x, ctx->render->gs.dualProjVec.x) + 
+        TTY_F2DOT14_MUL(v->y, ctx->render->gs.dualProjVec.y);
 }
 
 static TTY_S32 tty_sub_proj(TTY_Program_Context* ctx, TTY_V2* a, TTY_V2* b) {
@@ -704,21 +1273,21 @@ static TTY_S32 tty_sub_dual_proj(TTY_Program_Context* ctx, TTY_V2* a, TTY_V2* b)
 }
 
 static void tty_update_proj_dot_free(TTY_Program_Context* ctx) {
-    ctx->font->hint.gs.projDotFree =
-        TTY_F2DOT30_MUL(ctx->font->hint.gs.projVec.x << 16, ctx->font->hint.gs.freedomVec.x << 16) +
-        TTY_F2DOT30_MUL(ctx->font->hint.gs.projVec.y << 16, ctx->font->hint.gs.freedomVec.y << 16);
+    ctx->render->gs.projDotFree =
+        TTY_F2DOT30_MUL(ctx->render->gs.projVec.x << 16, ctx->render->gs.freedomVec.x << 16) +
+        TTY_F2DOT30_MUL(ctx->render->gs.projVec.y << 16, ctx->render->gs.freedomVec.y << 16);
 
-    if (labs(ctx->font->hint.gs.projDotFree) < 0x4000000) {
-        ctx->font->hint.gs.projDotFree = 0x40000000;
+    if (labs(ctx->render->gs.projDotFree) < 0x4000000) {
+        ctx->render->gs.projDotFree = 0x40000000;
     }
 }
 
 static TTY_F26Dot6 tty_mul_x_free_div_proj_dot_free(TTY_Program_Context* ctx, TTY_F26Dot6 val) {
-    return tty_rounded_div((TTY_S64)val * (ctx->font->hint.gs.freedomVec.x << 16), ctx->font->hint.gs.projDotFree);
+    return tty_rounded_div((TTY_S64)val * (ctx->render->gs.freedomVec.x << 16), ctx->render->gs.projDotFree);
 }
 
 static TTY_F26Dot6 tty_mul_y_free_div_proj_dot_free(TTY_Program_Context* ctx, TTY_F26Dot6 val) {
-    return tty_rounded_div((TTY_S64)val * (ctx->font->hint.gs.freedomVec.y << 16), ctx->font->hint.gs.projDotFree);
+    return tty_rounded_div((TTY_S64)val * (ctx->render->gs.freedomVec.y << 16), ctx->render->gs.projDotFree);
 }
 
 static void tty_move_point_x(TTY_Program_Context* ctx, TTY_Zone* zone, TTY_U32 idx, TTY_F26Dot6 dist) {
@@ -740,7 +1309,7 @@ static void tty_move_point_y(TTY_Program_Context* ctx, TTY_Zone* zone, TTY_U32 i
 }
 
 static void tty_move_point(TTY_Program_Context* ctx, TTY_Zone* zone, TTY_U32 idx, TTY_F26Dot6 dist) {
-    if (ctx->font->hint.gs.freedomVec.x != 0) {
+    if (ctx->render->gs.freedomVec.x != 0) {
         // In accordance with the FreeType's v40 interpreter (with backward 
         // compatability enabled), movement along the x-axis is disabled 
 
@@ -748,7 +1317,7 @@ static void tty_move_point(TTY_Program_Context* ctx, TTY_Zone* zone, TTY_U32 idx
         zone->touchFlags[idx] |= TTY_TOUCH_X;
     }
 
-    if (ctx->font->hint.gs.freedomVec.y != 0) {
+    if (ctx->render->gs.freedomVec.y != 0) {
         if (ctx->iupState != TTY_IUP_STATE_XY) {
             zone->cur[idx].y += tty_mul_y_free_div_proj_dot_free(ctx, dist);
         }
@@ -758,37 +1327,37 @@ static void tty_move_point(TTY_Program_Context* ctx, TTY_Zone* zone, TTY_U32 idx
 }
 
 static void tty_move_point_zp2(TTY_Program_Context* ctx, TTY_U32 idx, TTY_F26Dot6_V2* dist, TTY_Bool applyTouch) {
-    if (ctx->font->hint.gs.freedomVec.x != 0) {
+    if (ctx->render->gs.freedomVec.x != 0) {
         // In accordance with the FreeType's v40 interpreter (with backward 
         // compatability enabled), movement along the x-axis is disabled 
 
         // zone->cur[idx].x += dist->x;
 
         if (applyTouch) {
-            ctx->font->hint.gs.zp2->touchFlags[idx] |= TTY_TOUCH_X;
+            ctx->render->gs.zp2->touchFlags[idx] |= TTY_TOUCH_X;
         }
     }
 
-    if (ctx->font->hint.gs.freedomVec.y != 0) {
+    if (ctx->render->gs.freedomVec.y != 0) {
         if (ctx->iupState != TTY_IUP_STATE_XY) {
-            ctx->font->hint.gs.zp2->cur[idx].y += dist->y;
+            ctx->render->gs.zp2->cur[idx].y += dist->y;
         }
 
         if (applyTouch) {
-            ctx->font->hint.gs.zp2->touchFlags[idx] |= TTY_TOUCH_Y;
+            ctx->render->gs.zp2->touchFlags[idx] |= TTY_TOUCH_Y;
         }
     }
 }
 
 static void tty_update_move_point_func(TTY_Program_Context* ctx) {
-    ctx->font->hint.gs.move_point = tty_move_point;
+    ctx->render->gs.move_point = tty_move_point;
 
-    if (ctx->font->hint.gs.projDotFree == 0x4000000) {
-        if (ctx->font->hint.gs.freedomVec.x == 0) {
-            ctx->font->hint.gs.move_point = tty_move_point_y;
+    if (ctx->render->gs.projDotFree == 0x4000000) {
+        if (ctx->render->gs.freedomVec.x == 0) {
+            ctx->render->gs.move_point = tty_move_point_y;
         }
-        else if (ctx->font->hint.gs.freedomVec.y == 0) {
-            ctx->font->hint.gs.move_point = tty_move_point_x;
+        else if (ctx->render->gs.freedomVec.y == 0) {
+            ctx->render->gs.move_point = tty_move_point_x;
         }
     }
 }
@@ -796,7 +1365,7 @@ static void tty_update_move_point_func(TTY_Program_Context* ctx) {
 static TTY_F26Dot6 tty_round_according_to_round_state(TTY_Program_Context* ctx, TTY_F26Dot6 val) {
     // TODO: No idea how to apply "engine compensation" described in the spec
 
-    switch (ctx->font->hint.gs.roundState) {
+    switch (ctx->render->gs.roundState) {
         case TTY_ROUND_TO_HALF_GRID:
             return tty_f26dot6_round_to_half_grid(val);
         case TTY_ROUND_TO_GRID:
@@ -816,22 +1385,22 @@ static TTY_F26Dot6 tty_round_according_to_round_state(TTY_Program_Context* ctx,
 }
 
 static TTY_F26Dot6 tty_apply_single_width_cut_in(TTY_Program_Context* ctx, TTY_F26Dot6 value) {
-    TTY_F26Dot6 absDiff = labs(value - ctx->font->hint.gs.singleWidthValue);
-    if (absDiff < ctx->font->hint.gs.singleWidthCutIn) {
+    TTY_F26Dot6 absDiff = labs(value - ctx->render->gs.singleWidthValue);
+    if (absDiff < ctx->render->gs.singleWidthCutIn) {
         if (value < 0) {
-            return -ctx->font->hint.gs.singleWidthValue;
+            return -ctx->render->gs.singleWidthValue;
         }
-        return ctx->font->hint.gs.singleWidthValue;
+        return ctx->render->gs.singleWidthValue;
     }
     return value;
 }
 
 static TTY_F26Dot6 tty_apply_min_dist(TTY_Program_Context* ctx, TTY_F26Dot6 value) {
-    if (labs(value) < ctx->font->hint.gs.minDist) {
+    if (labs(value) < ctx->render->gs.minDist) {
         if (value < 0) {
-            return -ctx->font->hint.gs.minDist;
+            return -ctx->render->gs.minDist;
         }
-        return ctx->font->hint.gs.minDist;
+        return ctx->render->gs.minDist;
     }
     return value;
 }
@@ -839,9 +1408,9 @@ static TTY_F26Dot6 tty_apply_min_dist(TTY_Program_Context* ctx, TTY_F26Dot6 valu
 static TTY_Zone* tty_get_zone_pointer(TTY_Program_Context* ctx, TTY_U8 zone) {
     switch (zone) {
         case 0:
-            return &ctx->instance->hint.zone0;
+            return ctx->zone0;
         case 1:
-            return &ctx->font->hint.zone1;
+            return &ctx->render->zone1;
     }
     TTY_ASSERT(0);
     return NULL;
@@ -849,61 +1418,61 @@ static TTY_Zone* tty_get_zone_pointer(TTY_Program_Context* ctx, TTY_U8 zone) {
 
 static void tty_ABS(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_F26Dot6 val = tty_interp_stack_pop(&ctx->font->hint.stack);
-    tty_interp_stack_push(&ctx->font->hint.stack, labs(val));
-    TTY_LOG_INTERP_STACK_TOP(ctx->font->hint.stack);
+    TTY_F26Dot6 val = tty_interp_stack_pop(&ctx->render->stack);
+    tty_interp_stack_push(&ctx->render->stack, labs(val));
+    TTY_LOG_INTERP_STACK_TOP(ctx->render->stack);
 }
 
 static void tty_ADD(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_F26Dot6 n1 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_F26Dot6 n2 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    tty_interp_stack_push(&ctx->font->hint.stack, n1 + n2);
-    TTY_LOG_INTERP_STACK_TOP(ctx->font->hint.stack);
+    TTY_F26Dot6 n1 = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_F26Dot6 n2 = tty_interp_stack_pop(&ctx->render->stack);
+    tty_interp_stack_push(&ctx->render->stack, n1 + n2);
+    TTY_LOG_INTERP_STACK_TOP(ctx->render->stack);
 }
 
 static void tty_ALIGNRP(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
 
-    TTY_ASSERT(ctx->font->hint.gs.rp0 < ctx->font->hint.gs.zp0->numPoints);
-    TTY_F26Dot6_V2* rp0Cur = ctx->font->hint.gs.zp0->cur + ctx->font->hint.gs.rp0;
+    TTY_ASSERT(ctx->render->gs.rp0 < ctx->render->gs.zp0->numPoints);
+    TTY_F26Dot6_V2* rp0Cur = ctx->render->gs.zp0->cur + ctx->render->gs.rp0;
 
-    for (TTY_U32 i = 0; i < ctx->font->hint.gs.loop; i++) {
-        TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->font->hint.stack);
-        TTY_ASSERT(pointIdx < ctx->font->hint.gs.zp1->numPoints);
+    for (TTY_U32 i = 0; i < ctx->render->gs.loop; i++) {
+        TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->render->stack);
+        TTY_ASSERT(pointIdx < ctx->render->gs.zp1->numPoints);
 
-        TTY_F26Dot6 dist = tty_sub_proj(ctx, rp0Cur, ctx->font->hint.gs.zp1->cur + pointIdx);
-        ctx->font->hint.gs.move_point(ctx, ctx->font->hint.gs.zp1, pointIdx, dist);
+        TTY_F26Dot6 dist = tty_sub_proj(ctx, rp0Cur, ctx->render->gs.zp1->cur + pointIdx);
+        ctx->render->gs.move_point(ctx, ctx->render->gs.zp1, pointIdx, dist);
 
-        TTY_LOG_POINT(ctx->font->hint.gs.zp1->cur[pointIdx]);
+        TTY_LOG_POINT(ctx->render->gs.zp1->cur[pointIdx]);
     }
 
-    ctx->font->hint.gs.loop = 1;
+    ctx->render->gs.loop = 1;
 }
 
 static void tty_AND(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_U32 e2  = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_U32 e1  = tty_interp_stack_pop(&ctx->font->hint.stack);
-    tty_interp_stack_push(&ctx->font->hint.stack, e1 != 0 && e2 != 0 ? 1 : 0);
-    TTY_LOG_INTERP_STACK_TOP(ctx->font->hint.stack);
+    TTY_U32 e2  = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_U32 e1  = tty_interp_stack_pop(&ctx->render->stack);
+    tty_interp_stack_push(&ctx->render->stack, e1 != 0 && e2 != 0 ? 1 : 0);
+    TTY_LOG_INTERP_STACK_TOP(ctx->render->stack);
 }
 
 static void tty_CALL(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    tty_call_func(ctx, tty_interp_stack_pop(&ctx->font->hint.stack), 1);
+    tty_call_func(ctx, tty_interp_stack_pop(&ctx->render->stack), 1);
 }
 
 static void tty_CINDEX(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_U32 pos = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_U32 val = ctx->font->hint.stack.buff[ctx->font->hint.stack.count - pos];
-    tty_interp_stack_push(&ctx->font->hint.stack, val);
+    TTY_U32 pos = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_U32 val = ctx->render->stack.buff[ctx->render->stack.count - pos];
+    tty_interp_stack_push(&ctx->render->stack, val);
     TTY_LOG_VALUE(val);
 }
 
 static TTY_Bool tty_get_delta_value(TTY_Program_Context* ctx, TTY_U32 exc, TTY_U8 range, TTY_F26Dot6* deltaVal) {
-    TTY_U32 ppem = ((exc & 0xF0) >> 4) + ctx->font->hint.gs.deltaBase + range;
+    TTY_U32 ppem = ((exc & 0xF0) >> 4) + ctx->render->gs.deltaBase + range;
 
     if (ctx->instance->ppem != ppem) {
         return TTY_FALSE;
@@ -914,22 +1483,22 @@ static TTY_Bool tty_get_delta_value(TTY_Program_Context* ctx, TTY_U32 exc, TTY_U
         numSteps++;
     }
 
-    *deltaVal = numSteps * (1l << (6 - ctx->font->hint.gs.deltaShift));
+    *deltaVal = numSteps * (1l << (6 - ctx->render->gs.deltaShift));
     return TTY_TRUE;
 }
 
 static void tty_deltac_impl(TTY_Program_Context* ctx, TTY_U8 range) {
-    TTY_U32 count = tty_interp_stack_pop(&ctx->font->hint.stack);
+    TTY_U32 count = tty_interp_stack_pop(&ctx->render->stack);
 
     while (count > 0) {
-        TTY_U32 cvtIdx = tty_interp_stack_pop(&ctx->font->hint.stack);
-        TTY_ASSERT(cvtIdx < ctx->instance->hint.cvt.cap);
+        TTY_U32 cvtIdx = tty_interp_stack_pop(&ctx->render->stack);
+        TTY_ASSERT(cvtIdx < ctx->cvt->cap);
 
-        TTY_U32 exc = tty_interp_stack_pop(&ctx->font->hint.stack);
+        TTY_U32 exc = tty_interp_stack_pop(&ctx->render->stack);
 
         TTY_F26Dot6 deltaVal;
         if (tty_get_delta_value(ctx, exc, range, &deltaVal)) {
-            ctx->instance->hint.cvt.buff[cvtIdx] += deltaVal;
+            ctx->cvt->buff[cvtIdx] += deltaVal;
             TTY_LOG_VALUE(deltaVal);
         }
 
@@ -938,13 +1507,13 @@ static void tty_deltac_impl(TTY_Program_Context* ctx, TTY_U8 range) {
 }
 
 static void tty_deltap_impl(TTY_Program_Context* ctx, TTY_U8 range) {
-    TTY_U32 count = tty_interp_stack_pop(&ctx->font->hint.stack);
+    TTY_U32 count = tty_interp_stack_pop(&ctx->render->stack);
 
     while (count > 0) {
-        TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->font->hint.stack);
-        TTY_ASSERT(pointIdx < ctx->font->hint.gs.zp0->numPoints);
+        TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->render->stack);
+        TTY_ASSERT(pointIdx < ctx->render->gs.zp0->numPoints);
 
-        TTY_U32 exc = tty_interp_stack_pop(&ctx->font->hint.stack);
+        TTY_U32 exc = tty_interp_stack_pop(&ctx->render->stack);
         TTY_F26Dot6 deltaVal;
 
         if (tty_get_delta_value(ctx, exc, range, &deltaVal)) {
@@ -955,10 +1524,10 @@ static void tty_deltap_impl(TTY_Program_Context* ctx, TTY_U8 range) {
             //     - The point was previously touched on the y-axis
 
             if (ctx->iupState != TTY_IUP_STATE_XY                                      &&
-                ((ctx->glyph->numContours < 0 && ctx->font->hint.gs.freedomVec.y != 0) ||
-                (ctx->font->hint.gs.zp0->touchFlags[pointIdx] & TTY_TOUCH_Y))) 
+                ((ctx->glyph->numContours < 0 && ctx->render->gs.freedomVec.y != 0) ||
+                (ctx->render->gs.zp0->touchFlags[pointIdx] & TTY_TOUCH_Y))) 
             {
-                ctx->font->hint.gs.move_point(ctx, ctx->font->hint.gs.zp0, pointIdx, deltaVal);
+                ctx->render->gs.move_point(ctx, ctx->render->gs.zp0, pointIdx, deltaVal);
                 TTY_LOG_VALUE(deltaVal);
             }
         }
@@ -999,14 +1568,14 @@ static void tty_DELTAP3(TTY_Program_Context* ctx) {
 
 static void tty_DEPTH(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    tty_interp_stack_push(&ctx->font->hint.stack, ctx->font->hint.stack.count);
-    TTY_LOG_INTERP_STACK_TOP(ctx->font->hint.stack);
+    tty_interp_stack_push(&ctx->render->stack, ctx->render->stack.count);
+    TTY_LOG_INTERP_STACK_TOP(ctx->render->stack);
 }
 
 static void tty_DIV(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_F26Dot6 n1 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_F26Dot6 n2 = tty_interp_stack_pop(&ctx->font->hint.stack);
+    TTY_F26Dot6 n1 = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_F26Dot6 n2 = tty_interp_stack_pop(&ctx->render->stack);
     TTY_ASSERT(n1 != 0);
 
     TTY_Bool isNeg = TTY_FALSE;
@@ -1025,61 +1594,72 @@ static void tty_DIV(TTY_Program_Context* ctx) {
         result = -result;
     }
 
-    tty_interp_stack_push(&ctx->font->hint.stack, result);
+    tty_interp_stack_push(&ctx->render->stack, result);
     TTY_LOG_VALUE(result);
 }
 
 static void tty_DUP(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_U32 e = tty_interp_stack_pop(&ctx->font->hint.stack);
-    tty_interp_stack_push(&ctx->font->hint.stack, e);
-    tty_interp_stack_push(&ctx->font->hint.stack, e);
+    TTY_U32 e = tty_interp_stack_pop(&ctx->render->stack);
+    tty_interp_stack_push(&ctx->render->stack, e);
+    tty_interp_stack_push(&ctx->render->stack, e);
     TTY_LOG_VALUE(e);
 }
 
 static void tty_EQ(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_S32 e2 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_S32 e1 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    tty_interp_stack_push(&ctx->font->hint.stack, e1 == e2 ? 1 : 0);
-    TTY_LOG_INTERP_STACK_TOP(ctx->font->hint.stack);
+    TTY_S32 e2 = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_S32 e1 = tty_interp_stack_pop(&ctx->render->stack);
+    tty_interp_stack_push(&ctx->render->stack, e1 == e2 ? 1 : 0);
+    TTY_LOG_INTERP_STACK_TOP(ctx->render->stack);
 }
 
 static void tty_FDEF(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
 
-    TTY_U32 funcId = tty_interp_stack_pop(&ctx->font->hint.stack);
+    TTY_U32 funcId = tty_interp_stack_pop(&ctx->render->stack);
     TTY_ASSERT(funcId < ctx->font->hint.funcs.cap);
 
-    ctx->font->hint.funcs.insPtrs[funcId] = tty_ins_stream_next_ptr(&ctx->stream);
-    ctx->font->hint.funcs.sizes  [funcId] = 1;
-
-    while (tty_ins_stream_next(&ctx->stream) != TTY_ENDF) {
-        ctx->font->hint.funcs.sizes[funcId]++;
-    }
+    // The body ends before the ENDF
+    TTY_U32 startIdx = ctx->opIdx;
+    tty_skip_ops(ctx);
+    tty_program_init_body(ctx->font->hint.funcs.bodies + funcId, ctx->program, startIdx, TTY_MIN(ctx->opIdx - 1, ctx->program->numOps));
+    tty_bind_compiled_func(ctx->font, funcId);
 
     TTY_LOG_VALUE(funcId);
 }
 
+static void tty_EIF(TTY_Program_Context* ctx) {
+    (void)ctx;
+    TTY_LOG_INS();
+}
+
+static void tty_ELSE(TTY_Program_Context* ctx) {
+    // ELSE is only reached once the IF's condition was true, so the else 
+    // branch is skipped
+    TTY_LOG_INS();
+    tty_skip_ops(ctx);
+}
+
 static void tty_FLOOR(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_F26Dot6 val = tty_interp_stack_pop(&ctx->font->hint.stack);
-    tty_interp_stack_push(&ctx->font->hint.stack, tty_f26dot6_floor(val));
-    TTY_LOG_INTERP_STACK_TOP(ctx->font->hint.stack);
+    TTY_F26Dot6 val = tty_interp_stack_pop(&ctx->render->stack);
+    tty_interp_stack_push(&ctx->render->stack, tty_f26dot6_floor(val));
+    TTY_LOG_INTERP_STACK_TOP(ctx->render->stack);
 }
 
 static void tty_GC(TTY_Program_Context* ctx, TTY_U8 ins) {
     TTY_LOG_INS();
 
-    TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_ASSERT(pointIdx < ctx->font->hint.gs.zp2->numPoints);
+    TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_ASSERT(pointIdx < ctx->render->gs.zp2->numPoints);
 
     TTY_F26Dot6 val =
         ins & 0x1 ?
-        tty_dual_proj(ctx, ctx->font->hint.gs.zp2->orgScaled + pointIdx) :
-        tty_proj(ctx, ctx->font->hint.gs.zp2->cur + pointIdx);
+        tty_dual_proj(ctx, ctx->render->gs.zp2->orgScaled + pointIdx) :
+        tty_proj(ctx, ctx->render->gs.zp2->cur + pointIdx);
 
-    tty_interp_stack_push(&ctx->font->hint.stack, val);
+    tty_interp_stack_push(&ctx->render->stack, val);
     TTY_LOG_VALUE(val);
 }
 
@@ -1087,7 +1667,7 @@ static void tty_GETINFO(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
 
     TTY_U32 result   = 0;
-    TTY_U32 selector = tty_interp_stack_pop(&ctx->font->hint.stack);
+    TTY_U32 selector = tty_interp_stack_pop(&ctx->render->stack);
 
     if (selector & 0x00000001) {
         result = TTY_SCALAR_VERSION;
@@ -1115,114 +1695,93 @@ static void tty_GETINFO(TTY_Program_Context* ctx) {
         result |= (1 << 13);
     }
 
-    tty_interp_stack_push(&ctx->font->hint.stack, result);
+    tty_interp_stack_push(&ctx->render->stack, result);
     TTY_LOG_VALUE(result);
 }
 
 static void tty_GPV(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    tty_interp_stack_push(&ctx->font->hint.stack, ctx->font->hint.gs.projVec.x);
-    tty_interp_stack_push(&ctx->font->hint.stack, ctx->font->hint.gs.projVec.y);
+    tty_interp_stack_push(&ctx->render->stack, ctx->render->gs.projVec.x);
+    tty_interp_stack_push(&ctx->render->stack, ctx->render->gs.projVec.y);
 }
 
 static void tty_GT(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_S32 e2 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_S32 e1 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    tty_interp_stack_push(&ctx->font->hint.stack, e1 > e2 ? 1 : 0);
-    TTY_LOG_INTERP_STACK_TOP(ctx->font->hint.stack);
+    TTY_S32 e2 = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_S32 e1 = tty_interp_stack_pop(&ctx->render->stack);
+    tty_interp_stack_push(&ctx->render->stack, e1 > e2 ? 1 : 0);
+    TTY_LOG_INTERP_STACK_TOP(ctx->render->stack);
 }
 
 static void tty_GTEQ(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_S32 e2 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_S32 e1 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    tty_interp_stack_push(&ctx->font->hint.stack, e1 >= e2 ? 1 : 0);
-    TTY_LOG_INTERP_STACK_TOP(ctx->font->hint.stack);
+    TTY_S32 e2 = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_S32 e1 = tty_interp_stack_pop(&ctx->render->stack);
+    tty_interp_stack_push(&ctx->render->stack, e1 >= e2 ? 1 : 0);
+    TTY_LOG_INTERP_STACK_TOP(ctx->render->stack);
 }
 
 static void tty_IF(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
 
-    if (tty_interp_stack_pop(&ctx->font->hint.stack) == 0) {
+    if (tty_interp_stack_pop(&ctx->render->stack) == 0) {
+        // Execution continues after the ELSE, or after the EIF if there is no
+        // ELSE
         TTY_LOG_VALUE(0);
-        if (tty_ins_stream_jump_to_else_or_eif(&ctx->stream) == TTY_EIF) {
-            // Condition is false and there is no else instruction
-            return;
-        }
+        tty_skip_ops(ctx);
     }
     else {
         TTY_LOG_VALUE(1);
     }
-
-    while (TTY_TRUE) {
-        TTY_U8 ins = tty_ins_stream_peek(&ctx->stream);
-
-        if (ins == TTY_ELSE) {
-            tty_ins_stream_consume(&ctx->stream);
-            tty_ins_stream_jump_to_else_or_eif(&ctx->stream);
-            return;
-        }
-
-        if (ins == TTY_EIF) {
-            tty_ins_stream_consume(&ctx->stream);
-            return;
-        }
-
-        ctx->stream.execute_next_ins(ctx);
-        if (ctx->foundUnknownIns) {
-            return;
-        }
-    }
 }
 
 static void tty_IP(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
 
-    TTY_ASSERT(ctx->font->hint.gs.rp1 < ctx->font->hint.gs.zp0->numPoints);
-    TTY_ASSERT(ctx->font->hint.gs.rp2 < ctx->font->hint.gs.zp1->numPoints);
+    TTY_ASSERT(ctx->render->gs.rp1 < ctx->render->gs.zp0->numPoints);
+    TTY_ASSERT(ctx->render->gs.rp2 < ctx->render->gs.zp1->numPoints);
 
-    TTY_F26Dot6_V2* rp1Cur = ctx->font->hint.gs.zp0->cur + ctx->font->hint.gs.rp1;
-    TTY_F26Dot6_V2* rp2Cur = ctx->font->hint.gs.zp1->cur + ctx->font->hint.gs.rp2;
+    TTY_F26Dot6_V2* rp1Cur = ctx->render->gs.zp0->cur + ctx->render->gs.rp1;
+    TTY_F26Dot6_V2* rp2Cur = ctx->render->gs.zp1->cur + ctx->render->gs.rp2;
 
     TTY_Bool isTwilightZone = 
-        ctx->font->hint.gs.gep0 == 0 || 
-        ctx->font->hint.gs.gep1 == 0 || 
-        ctx->font->hint.gs.gep2 == 0;
+        ctx->render->gs.gep0 == 0 || 
+        ctx->render->gs.gep1 == 0 || 
+        ctx->render->gs.gep2 == 0;
 
     TTY_F26Dot6_V2* rp1Org, *rp2Org;
 
     if (isTwilightZone) {
         // Twilight zone doesn't have unscaled coordinates
-        rp1Org = ctx->font->hint.gs.zp0->orgScaled + ctx->font->hint.gs.rp1;
-        rp2Org = ctx->font->hint.gs.zp1->orgScaled + ctx->font->hint.gs.rp2;
+        rp1Org = ctx->render->gs.zp0->orgScaled + ctx->render->gs.rp1;
+        rp2Org = ctx->render->gs.zp1->orgScaled + ctx->render->gs.rp2;
     }
     else {
         // Use unscaled coordinates for more precision
-        rp1Org = ctx->font->hint.gs.zp0->org + ctx->font->hint.gs.rp1;
-        rp2Org = ctx->font->hint.gs.zp1->org + ctx->font->hint.gs.rp2;
+        rp1Org = ctx->render->gs.zp0->org + ctx->render->gs.rp1;
+        rp2Org = ctx->render->gs.zp1->org + ctx->render->gs.rp2;
     }
 
     TTY_F26Dot6 totalDistCur = tty_sub_proj(ctx, rp2Cur, rp1Cur);
     TTY_F26Dot6 totalDistOrg = tty_sub_dual_proj(ctx, rp2Org, rp1Org);
 
-    for (TTY_U32 i = 0; i < ctx->font->hint.gs.loop; i++) {
-        TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->font->hint.stack);
-        TTY_ASSERT(pointIdx < ctx->font->hint.gs.zp2->numPoints);
+    for (TTY_U32 i = 0; i < ctx->render->gs.loop; i++) {
+        TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->render->stack);
+        TTY_ASSERT(pointIdx < ctx->render->gs.zp2->numPoints);
 
-        TTY_V2* pointCur = ctx->font->hint.gs.zp2->cur + pointIdx;
-        TTY_V2* pointOrg = (isTwilightZone ? ctx->font->hint.gs.zp2->orgScaled : ctx->font->hint.gs.zp2->org) + pointIdx;
+        TTY_V2* pointCur = ctx->render->gs.zp2->cur + pointIdx;
+        TTY_V2* pointOrg = (isTwilightZone ? ctx->render->gs.zp2->orgScaled : ctx->render->gs.zp2->org) + pointIdx;
 
         TTY_F26Dot6 distCur = tty_sub_proj(ctx, pointCur, rp1Cur);
         TTY_F26Dot6 distOrg = tty_sub_dual_proj(ctx, pointOrg, rp1Org);
         TTY_F26Dot6 distNew = TTY_F26DOT6_DIV(TTY_F26DOT6_MUL(distOrg, totalDistCur), totalDistOrg);
 
-        ctx->font->hint.gs.move_point(ctx, ctx->font->hint.gs.zp2, pointIdx, distNew - distCur);
+        ctx->render->gs.move_point(ctx, ctx->render->gs.zp2, pointIdx, distNew - distCur);
 
         TTY_LOG_POINT(*pointCur);
     }
 
-    ctx->font->hint.gs.loop = 1;
+    ctx->render->gs.loop = 1;
 }
 
 static void tty_ISECT(TTY_Program_Context* ctx) {
@@ -1235,32 +1794,32 @@ static void tty_ISECT(TTY_Program_Context* ctx) {
     TTY_F26Dot6 x4, y4;
 
     {
-        TTY_U32 a2Idx    = tty_interp_stack_pop(&ctx->font->hint.stack);
-        TTY_U32 a1Idx    = tty_interp_stack_pop(&ctx->font->hint.stack);
-        TTY_U32 b2Idx    = tty_interp_stack_pop(&ctx->font->hint.stack);
-        TTY_U32 b1Idx    = tty_interp_stack_pop(&ctx->font->hint.stack);
-        TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->font->hint.stack);
+        TTY_U32 a2Idx    = tty_interp_stack_pop(&ctx->render->stack);
+        TTY_U32 a1Idx    = tty_interp_stack_pop(&ctx->render->stack);
+        TTY_U32 b2Idx    = tty_interp_stack_pop(&ctx->render->stack);
+        TTY_U32 b1Idx    = tty_interp_stack_pop(&ctx->render->stack);
+        TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->render->stack);
 
-        TTY_ASSERT(a2Idx    < ctx->font->hint.gs.zp1->numPoints);
-        TTY_ASSERT(a1Idx    < ctx->font->hint.gs.zp1->numPoints);
-        TTY_ASSERT(b2Idx    < ctx->font->hint.gs.zp0->numPoints);
-        TTY_ASSERT(b1Idx    < ctx->font->hint.gs.zp0->numPoints);
-        TTY_ASSERT(pointIdx < ctx->font->hint.gs.zp2->numPoints);
+        TTY_ASSERT(a2Idx    < ctx->render->gs.zp1->numPoints);
+        TTY_ASSERT(a1Idx    < ctx->render->gs.zp1->numPoints);
+        TTY_ASSERT(b2Idx    < ctx->render->gs.zp0->numPoints);
+        TTY_ASSERT(b1Idx    < ctx->render->gs.zp0->numPoints);
+        TTY_ASSERT(pointIdx < ctx->render->gs.zp2->numPoints);
 
-        x1 = ctx->font->hint.gs.zp1->cur[a1Idx].x;
-        y1 = ctx->font->hint.gs.zp1->cur[a1Idx].y;
+        x1 = ctx->render->gs.zp1->cur[a1Idx].x;
+        y1 = ctx->render->gs.zp1->cur[a1Idx].y;
 
-        x2 = ctx->font->hint.gs.zp1->cur[a2Idx].x;
-        y2 = ctx->font->hint.gs.zp1->cur[a2Idx].y;
+        x2 = ctx->render->gs.zp1->cur[a2Idx].x;
+        y2 = ctx->render->gs.zp1->cur[a2Idx].y;
 
-        x3 = ctx->font->hint.gs.zp0->cur[b1Idx].x;
-        y3 = ctx->font->hint.gs.zp0->cur[b1Idx].y;
+        x3 = ctx->render->gs.zp0->cur[b1Idx].x;
+        y3 = ctx->render->gs.zp0->cur[b1Idx].y;
 
-        x4 = ctx->font->hint.gs.zp0->cur[b2Idx].x;
-        y4 = ctx->font->hint.gs.zp0->cur[b2Idx].y;
+        x4 = ctx->render->gs.zp0->cur[b2Idx].x;
+        y4 = ctx->render->gs.zp0->cur[b2Idx].y;
 
-        point = ctx->font->hint.gs.zp2->cur + pointIdx;
-        ctx->font->hint.gs.zp2->touchFlags[pointIdx] |= TTY_TOUCH_XY;
+        point = ctx->render->gs.zp2->cur + pointIdx;
+        ctx->render->gs.zp2->touchFlags[pointIdx] |= TTY_TOUCH_XY;
     }
 
     TTY_F26Dot6 denom  = TTY_F26DOT6_MUL(x1 - x2, y3 - y4) - TTY_F26DOT6_MUL(y1 - y2, x3 - x4);
@@ -1358,7 +1917,7 @@ static void tty_IUP(TTY_Program_Context* ctx, TTY_S8 ins) {
     TTY_LOG_INS();
 
     // Applying IUP to zone0 is an error
-    TTY_ASSERT(ctx->font->hint.gs.gep2 == 1);
+    TTY_ASSERT(ctx->render->gs.gep2 == 1);
 
     // In accordance with the FreeType's v40 interpreter (with backward 
     // compatability enabled), points cannot be moved on either axis post-IUP.
@@ -1372,20 +1931,20 @@ static void tty_IUP(TTY_Program_Context* ctx, TTY_S8 ins) {
 
     ctx->iupState |= touchFlag;
 
-    for (TTY_U32 i = 0; i < ctx->font->hint.zone1.numEndPoints; i++) {
+    for (TTY_U32 i = 0; i < ctx->render->zone1.numEndPoints; i++) {
         TTY_U16  startPointIdx = pointIdx;
-        TTY_U16  endPointIdx   = ctx->font->hint.zone1.endPointIndices[i];
+        TTY_U16  endPointIdx   = ctx->render->zone1.endPointIndices[i];
         TTY_U16  touch0        = 0;
         TTY_Bool findingTouch1 = TTY_FALSE;
 
         while (pointIdx <= endPointIdx) {
-            if (ctx->font->hint.zone1.touchFlags[pointIdx] & touchFlag) {
+            if (ctx->render->zone1.touchFlags[pointIdx] & touchFlag) {
                 if (findingTouch1) {
-                    tty_iup_interpolate_or_shift(&ctx->font->hint.zone1, touchFlag, startPointIdx, endPointIdx, touch0, pointIdx);
+                    tty_iup_interpolate_or_shift(&ctx->render->zone1, touchFlag, startPointIdx, endPointIdx, touch0, pointIdx);
 
                     findingTouch1 = 
                         pointIdx != endPointIdx || 
-                        (ctx->font->hint.zone1.touchFlags[startPointIdx] & touchFlag) == 0;
+                        (ctx->render->zone1.touchFlags[startPointIdx] & touchFlag) == 0;
 
                     if (findingTouch1) {
                         touch0 = pointIdx;
@@ -1404,8 +1963,8 @@ static void tty_IUP(TTY_Program_Context* ctx, TTY_S8 ins) {
             // The index of the second touched point wraps back to the 
             // beginning.
             for (TTY_U32 i = startPointIdx; i <= touch0; i++) {
-                if (ctx->font->hint.zone1.touchFlags[i] & touchFlag) {
-                    tty_iup_interpolate_or_shift(&ctx->font->hint.zone1, touchFlag, startPointIdx, endPointIdx, touch0, i);
+                if (ctx->render->zone1.touchFlags[i] & touchFlag) {
+                    tty_iup_interpolate_or_shift(&ctx->render->zone1, touchFlag, startPointIdx, endPointIdx, touch0, i);
 
                     break;
                 }
@@ -1417,12 +1976,12 @@ static void tty_IUP(TTY_Program_Context* ctx, TTY_S8 ins) {
 static void tty_JROT(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
     
-    TTY_U32 val = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_S32 off = tty_interp_stack_pop(&ctx->font->hint.stack); 
+    TTY_U32 val = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_S32 off = tty_interp_stack_pop(&ctx->render->stack); 
 
     if (val != 0) {
-        tty_ins_stream_jump(&ctx->stream, off - 1);
-        TTY_LOG_VALUE(off - 1);
+        tty_jump(ctx, off);
+        TTY_LOG_VALUE(off);
     }
     else {
         TTY_LOG_VALUE(0);
@@ -1431,105 +1990,105 @@ static void tty_JROT(TTY_Program_Context* ctx) {
 
 static void tty_JMPR(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_S32 off = tty_interp_stack_pop(&ctx->font->hint.stack);
-    tty_ins_stream_jump(&ctx->stream, off - 1);
-    TTY_LOG_VALUE(off - 1);
+    TTY_S32 off = tty_interp_stack_pop(&ctx->render->stack);
+    tty_jump(ctx, off);
+    TTY_LOG_VALUE(off);
 }
 
 static void tty_LOOPCALL(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_U32 funcId = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_U32 times  = tty_interp_stack_pop(&ctx->font->hint.stack);
+    TTY_U32 funcId = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_U32 times  = tty_interp_stack_pop(&ctx->render->stack);
     tty_call_func(ctx, funcId, times);
 }
 
 static void tty_LT(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_S32 e2 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_S32 e1 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    tty_interp_stack_push(&ctx->font->hint.stack, e1 < e2 ? 1 : 0);
-    TTY_LOG_INTERP_STACK_TOP(ctx->font->hint.stack);
+    TTY_S32 e2 = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_S32 e1 = tty_interp_stack_pop(&ctx->render->stack);
+    tty_interp_stack_push(&ctx->render->stack, e1 < e2 ? 1 : 0);
+    TTY_LOG_INTERP_STACK_TOP(ctx->render->stack);
 }
 
 static void tty_LTEQ(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_S32 e2 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_S32 e1 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    tty_interp_stack_push(&ctx->font->hint.stack, e1 <= e2 ? 1 : 0);
-    TTY_LOG_INTERP_STACK_TOP(ctx->font->hint.stack);
+    TTY_S32 e2 = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_S32 e1 = tty_interp_stack_pop(&ctx->render->stack);
+    tty_interp_stack_push(&ctx->render->stack, e1 <= e2 ? 1 : 0);
+    TTY_LOG_INTERP_STACK_TOP(ctx->render->stack);
 }
 
 static void tty_MAX(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_S32 e1 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_S32 e2 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    tty_interp_stack_push(&ctx->font->hint.stack, e1 > e2 ? e1 : e2);
-    TTY_LOG_INTERP_STACK_TOP(ctx->font->hint.stack);
+    TTY_S32 e1 = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_S32 e2 = tty_interp_stack_pop(&ctx->render->stack);
+    tty_interp_stack_push(&ctx->render->stack, e1 > e2 ? e1 : e2);
+    TTY_LOG_INTERP_STACK_TOP(ctx->render->stack);
 }
 
 static void tty_MD(TTY_Program_Context* ctx, TTY_U8 ins) {
     TTY_LOG_INS();
     
-    TTY_U32     pointIdx0 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_U32     pointIdx1 = tty_interp_stack_pop(&ctx->font->hint.stack);
+    TTY_U32     pointIdx0 = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_U32     pointIdx1 = tty_interp_stack_pop(&ctx->render->stack);
     TTY_F26Dot6 dist;
 
-    TTY_ASSERT(pointIdx0 < ctx->font->hint.gs.zp1->numPoints);
-    TTY_ASSERT(pointIdx1 < ctx->font->hint.gs.zp0->numPoints);
+    TTY_ASSERT(pointIdx0 < ctx->render->gs.zp1->numPoints);
+    TTY_ASSERT(pointIdx1 < ctx->render->gs.zp0->numPoints);
 
     // TODO: Spec says if ins & 0x1 = 1 then use original outline, but FreeType
     //       uses current outline.
 
     if (ins & 0x1) {
-        dist = tty_sub_proj(ctx, ctx->font->hint.gs.zp0->cur + pointIdx1, ctx->font->hint.gs.zp1->cur + pointIdx0);
+        dist = tty_sub_proj(ctx, ctx->render->gs.zp0->cur + pointIdx1, ctx->render->gs.zp1->cur + pointIdx0);
     }
     else {
-        TTY_Bool isTwilightZone = ctx->font->hint.gs.gep0 == 0 || ctx->font->hint.gs.gep1 == 0;
+        TTY_Bool isTwilightZone = ctx->render->gs.gep0 == 0 || ctx->render->gs.gep1 == 0;
 
         if (isTwilightZone) {
-            dist = tty_sub_dual_proj(ctx, ctx->font->hint.gs.zp0->orgScaled + pointIdx1, ctx->font->hint.gs.zp1->orgScaled + pointIdx0);
+            dist = tty_sub_dual_proj(ctx, ctx->render->gs.zp0->orgScaled + pointIdx1, ctx->render->gs.zp1->orgScaled + pointIdx0);
         }
         else {
-            dist = tty_sub_dual_proj(ctx, ctx->font->hint.gs.zp0->org + pointIdx1, ctx->font->hint.gs.zp1->org + pointIdx0);
+            dist = tty_sub_dual_proj(ctx, ctx->render->gs.zp0->org + pointIdx1, ctx->render->gs.zp1->org + pointIdx0);
             dist = TTY_F10DOT22_MUL(dist << 6, ctx->instance->scale);
         }
     }
 
-    tty_interp_stack_push(&ctx->font->hint.stack, dist);
+    tty_interp_stack_push(&ctx->render->stack, dist);
     TTY_LOG_VALUE(dist);
 }
 
 static void tty_MDAP(TTY_Program_Context* ctx, TTY_U8 ins) {
     TTY_LOG_INS();
 
-    TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_ASSERT(pointIdx < ctx->font->hint.gs.zp0->numPoints);
+    TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_ASSERT(pointIdx < ctx->render->gs.zp0->numPoints);
 
-    TTY_F26Dot6_V2* point = ctx->font->hint.gs.zp0->cur + pointIdx;
+    TTY_F26Dot6_V2* point = ctx->render->gs.zp0->cur + pointIdx;
 
     if (ins & 0x1) {
         TTY_F26Dot6 curDist     = tty_proj(ctx, point);
         TTY_F26Dot6 roundedDist = tty_round_according_to_round_state(ctx, curDist);
-        ctx->font->hint.gs.move_point(ctx, ctx->font->hint.gs.zp0, pointIdx, roundedDist - curDist);
+        ctx->render->gs.move_point(ctx, ctx->render->gs.zp0, pointIdx, roundedDist - curDist);
     }
     else {
         // Don't move the point, just mark it as touched
 
-        if (ctx->font->hint.gs.freedomVec.x != 0) {
-            if (ctx->font->hint.gs.freedomVec.y != 0) {
-                ctx->font->hint.gs.zp0->touchFlags[pointIdx] = TTY_TOUCH_XY;
+        if (ctx->render->gs.freedomVec.x != 0) {
+            if (ctx->render->gs.freedomVec.y != 0) {
+                ctx->render->gs.zp0->touchFlags[pointIdx] = TTY_TOUCH_XY;
             }
             else {
-                ctx->font->hint.gs.zp0->touchFlags[pointIdx] |= TTY_TOUCH_X;
+                ctx->render->gs.zp0->touchFlags[pointIdx] |= TTY_TOUCH_X;
             }
         }
         else {
-            ctx->font->hint.gs.zp0->touchFlags[pointIdx] |= TTY_TOUCH_Y;
+            ctx->render->gs.zp0->touchFlags[pointIdx] |= TTY_TOUCH_Y;
         }
     }
 
-    ctx->font->hint.gs.rp0 = pointIdx;
-    ctx->font->hint.gs.rp1 = pointIdx;
+    ctx->render->gs.rp0 = pointIdx;
+    ctx->render->gs.rp1 = pointIdx;
 
     TTY_LOG_POINT(*point);
 }
@@ -1537,26 +2096,26 @@ static void tty_MDAP(TTY_Program_Context* ctx, TTY_U8 ins) {
 static void tty_MDRP(TTY_Program_Context* ctx, TTY_U8 ins) {
     TTY_LOG_INS();
 
-    TTY_ASSERT(ctx->font->hint.gs.rp0 < ctx->font->hint.gs.zp0->numPoints);
+    TTY_ASSERT(ctx->render->gs.rp0 < ctx->render->gs.zp0->numPoints);
 
-    TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_ASSERT(pointIdx < ctx->font->hint.gs.zp1->numPoints);
+    TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_ASSERT(pointIdx < ctx->render->gs.zp1->numPoints);
 
-    TTY_F26Dot6_V2* rp0Cur         = ctx->font->hint.gs.zp0->cur + ctx->font->hint.gs.rp0;
-    TTY_F26Dot6_V2* pointCur       = ctx->font->hint.gs.zp1->cur + pointIdx;
-    TTY_Bool        isTwilightZone = ctx->font->hint.gs.gep0 == 0 || ctx->font->hint.gs.gep1 == 0;
+    TTY_F26Dot6_V2* rp0Cur         = ctx->render->gs.zp0->cur + ctx->render->gs.rp0;
+    TTY_F26Dot6_V2* pointCur       = ctx->render->gs.zp1->cur + pointIdx;
+    TTY_Bool        isTwilightZone = ctx->render->gs.gep0 == 0 || ctx->render->gs.gep1 == 0;
 
     TTY_F26Dot6_V2* rp0Org, *pointOrg;
 
     if (isTwilightZone) {
         // Twilight zone doesn't have unscaled coordinates
-        rp0Org   = ctx->font->hint.gs.zp0->orgScaled + ctx->font->hint.gs.rp0;
-        pointOrg = ctx->font->hint.gs.zp1->orgScaled + pointIdx;
+        rp0Org   = ctx->render->gs.zp0->orgScaled + ctx->render->gs.rp0;
+        pointOrg = ctx->render->gs.zp1->orgScaled + pointIdx;
     }
     else {
         // Use unscaled coordinates for more precision
-        rp0Org   = ctx->font->hint.gs.zp0->org + ctx->font->hint.gs.rp0;
-        pointOrg = ctx->font->hint.gs.zp1->org + pointIdx;
+        rp0Org   = ctx->render->gs.zp0->org + ctx->render->gs.rp0;
+        pointOrg = ctx->render->gs.zp1->org + pointIdx;
     }
 
     TTY_F26Dot6 distCur = tty_sub_proj(ctx, pointCur, rp0Cur);
@@ -1577,12 +2136,12 @@ static void tty_MDRP(TTY_Program_Context* ctx, TTY_U8 ins) {
     }
 
     if (ins & 0x10) {
-        ctx->font->hint.gs.rp0 = pointIdx;
+        ctx->render->gs.rp0 = pointIdx;
     }
 
-    ctx->font->hint.gs.move_point(ctx, ctx->font->hint.gs.zp1, pointIdx, distOrg - distCur);
-    ctx->font->hint.gs.rp1 = ctx->font->hint.gs.rp0;
-    ctx->font->hint.gs.rp2 = pointIdx;
+    ctx->render->gs.move_point(ctx, ctx->render->gs.zp1, pointIdx, distOrg - distCur);
+    ctx->render->gs.rp1 = ctx->render->gs.rp0;
+    ctx->render->gs.rp2 = pointIdx;
 
     TTY_LOG_POINT(*pointCur);
 }
@@ -1590,86 +2149,86 @@ static void tty_MDRP(TTY_Program_Context* ctx, TTY_U8 ins) {
 static void tty_MIAP(TTY_Program_Context* ctx, TTY_U8 ins) {
     TTY_LOG_INS();
 
-    TTY_U32 cvtIdx = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_ASSERT(cvtIdx < ctx->instance->hint.cvt.cap);
+    TTY_U32 cvtIdx = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_ASSERT(cvtIdx < ctx->cvt->cap);
 
-    TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_ASSERT(pointIdx < ctx->font->hint.gs.zp0->numPoints);
+    TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_ASSERT(pointIdx < ctx->render->gs.zp0->numPoints);
 
-    TTY_F26Dot6 newDist = ctx->instance->hint.cvt.buff[cvtIdx];
+    TTY_F26Dot6 newDist = ctx->cvt->buff[cvtIdx];
 
-    if (ctx->font->hint.gs.gep0 == 0) {
-        TTY_F26Dot6_V2* org = ctx->font->hint.gs.zp0->orgScaled + pointIdx;
+    if (ctx->render->gs.gep0 == 0) {
+        TTY_F26Dot6_V2* org = ctx->render->gs.zp0->orgScaled + pointIdx;
 
-        org->x = TTY_F2DOT14_MUL(newDist, ctx->font->hint.gs.freedomVec.x);
-        org->y = TTY_F2DOT14_MUL(newDist, ctx->font->hint.gs.freedomVec.y);
+        org->x = TTY_F2DOT14_MUL(newDist, ctx->render->gs.freedomVec.x);
+        org->y = TTY_F2DOT14_MUL(newDist, ctx->render->gs.freedomVec.y);
 
-        ctx->font->hint.gs.zp0->cur[pointIdx] = *org;
+        ctx->render->gs.zp0->cur[pointIdx] = *org;
     }
 
-    TTY_F26Dot6 curDist = tty_proj(ctx, ctx->font->hint.gs.zp0->cur + pointIdx);
+    TTY_F26Dot6 curDist = tty_proj(ctx, ctx->render->gs.zp0->cur + pointIdx);
     
     if (ins & 0x1) {
-        if (labs(newDist - curDist) > ctx->font->hint.gs.controlValueCutIn) {
+        if (labs(newDist - curDist) > ctx->render->gs.controlValueCutIn) {
             newDist = curDist;
         }
         newDist = tty_round_according_to_round_state(ctx, newDist);
     }
 
-    ctx->font->hint.gs.move_point(ctx, ctx->font->hint.gs.zp0, pointIdx, newDist - curDist);
+    ctx->render->gs.move_point(ctx, ctx->render->gs.zp0, pointIdx, newDist - curDist);
     
-    ctx->font->hint.gs.rp0 = pointIdx;
-    ctx->font->hint.gs.rp1 = pointIdx;
+    ctx->render->gs.rp0 = pointIdx;
+    ctx->render->gs.rp1 = pointIdx;
 
-    TTY_LOG_POINT(ctx->font->hint.gs.zp0->cur[pointIdx]);
+    TTY_LOG_POINT(ctx->render->gs.zp0->cur[pointIdx]);
 }
 
 static void tty_MIN(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_S32 e1 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_S32 e2 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    tty_interp_stack_push(&ctx->font->hint.stack, e1 < e2 ? e1 : e2);
-    TTY_LOG_INTERP_STACK_TOP(ctx->font->hint.stack);
+    TTY_S32 e1 = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_S32 e2 = tty_interp_stack_pop(&ctx->render->stack);
+    tty_interp_stack_push(&ctx->render->stack, e1 < e2 ? e1 : e2);
+    TTY_LOG_INTERP_STACK_TOP(ctx->render->stack);
 }
 
 static void tty_MINDEX(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
 
-    TTY_U32 idx  = ctx->font->hint.stack.count - ctx->font->hint.stack.buff[ctx->font->hint.stack.count - 1] - 1;
-    size_t  size = sizeof(TTY_S32) * (ctx->font->hint.stack.count - idx - 1);
+    TTY_U32 idx  = ctx->render->stack.count - ctx->render->stack.buff[ctx->render->stack.count - 1] - 1;
+    size_t  size = sizeof(TTY_S32) * (ctx->render->stack.count - idx - 1);
 
-    ctx->font->hint.stack.count--;
-    ctx->font->hint.stack.buff[ctx->font->hint.stack.count] = ctx->font->hint.stack.buff[idx];
-    memcpy(ctx->font->hint.stack.buff + idx, ctx->font->hint.stack.buff + idx + 1, size);
+    ctx->render->stack.count--;
+    ctx->render->stack.buff[ctx->render->stack.count] = ctx->render->stack.buff[idx];
+    memcpy(ctx->render->stack.buff + idx, ctx->render->stack.buff + idx + 1, size);
 }
 
 static void tty_MIRP(TTY_Program_Context* ctx, TTY_U8 ins) {
     TTY_LOG_INS();
 
-    TTY_U32 cvtIdx   = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->font->hint.stack);
+    TTY_U32 cvtIdx   = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->render->stack);
 
-    TTY_ASSERT(cvtIdx   < ctx->instance->hint.cvt.cap);
-    TTY_ASSERT(pointIdx < ctx->font->hint.gs.zp1->numPoints);
+    TTY_ASSERT(cvtIdx   < ctx->cvt->cap);
+    TTY_ASSERT(pointIdx < ctx->render->gs.zp1->numPoints);
 
-    TTY_F26Dot6 cvtVal = tty_apply_single_width_cut_in(ctx, ctx->instance->hint.cvt.buff[cvtIdx]);
+    TTY_F26Dot6 cvtVal = tty_apply_single_width_cut_in(ctx, ctx->cvt->buff[cvtIdx]);
 
-    TTY_F26Dot6_V2* rp0Org = ctx->font->hint.gs.zp0->orgScaled + ctx->font->hint.gs.rp0;
-    TTY_F26Dot6_V2* rp0Cur = ctx->font->hint.gs.zp0->cur       + ctx->font->hint.gs.rp0;
+    TTY_F26Dot6_V2* rp0Org = ctx->render->gs.zp0->orgScaled + ctx->render->gs.rp0;
+    TTY_F26Dot6_V2* rp0Cur = ctx->render->gs.zp0->cur       + ctx->render->gs.rp0;
 
-    TTY_F26Dot6_V2* pointOrg = ctx->font->hint.gs.zp1->orgScaled + pointIdx;
-    TTY_F26Dot6_V2* pointCur = ctx->font->hint.gs.zp1->cur       + pointIdx;
+    TTY_F26Dot6_V2* pointOrg = ctx->render->gs.zp1->orgScaled + pointIdx;
+    TTY_F26Dot6_V2* pointCur = ctx->render->gs.zp1->cur       + pointIdx;
 
-    if (ctx->font->hint.gs.gep1 == 0) {
-        pointOrg->x = rp0Org->x + TTY_F2DOT14_MUL(cvtVal, ctx->font->hint.gs.freedomVec.x);
-        pointOrg->y = rp0Org->y + TTY_F2DOT14_MUL(cvtVal, ctx->font->hint.gs.freedomVec.y);
+    if (ctx->render->gs.gep1 == 0) {
+        pointOrg->x = rp0Org->x + TTY_F2DOT14_MUL(cvtVal, ctx->render->gs.freedomVec.x);
+        pointOrg->y = rp0Org->y + TTY_F2DOT14_MUL(cvtVal, ctx->render->gs.freedomVec.y);
         *pointCur   = *pointOrg;
     }
 
     TTY_S32 distCur = tty_sub_proj(ctx, pointCur, rp0Cur);
     TTY_S32 distOrg = tty_sub_dual_proj(ctx, pointOrg, rp0Org);
 
-    if (ctx->font->hint.gs.autoFlip) {
+    if (ctx->render->gs.autoFlip) {
         if ((distOrg ^ cvtVal) < 0) {
             // Match the sign of distOrg
             cvtVal = -cvtVal;
@@ -1679,8 +2238,8 @@ static void tty_MIRP(TTY_Program_Context* ctx, TTY_U8 ins) {
     TTY_S32 distNew;
     
     if (ins & 0x4) {
-        if (ctx->font->hint.gs.gep0 == ctx->font->hint.gs.gep1) {
-            if (labs(cvtVal - distOrg) > ctx->font->hint.gs.controlValueCutIn) {
+        if (ctx->render->gs.gep0 == ctx->render->gs.gep1) {
+            if (labs(cvtVal - distOrg) > ctx->render->gs.controlValueCutIn) {
                 cvtVal = distOrg;
             }
         }
@@ -1694,12 +2253,12 @@ static void tty_MIRP(TTY_Program_Context* ctx, TTY_U8 ins) {
         distNew = tty_apply_min_dist(ctx, distNew);
     }
 
-    ctx->font->hint.gs.move_point(ctx, ctx->font->hint.gs.zp1, pointIdx, distNew - distCur);
-    ctx->font->hint.gs.rp1 = ctx->font->hint.gs.rp0;
-    ctx->font->hint.gs.rp2 = pointIdx;
+    ctx->render->gs.move_point(ctx, ctx->render->gs.zp1, pointIdx, distNew - distCur);
+    ctx->render->gs.rp1 = ctx->render->gs.rp0;
+    ctx->render->gs.rp2 = pointIdx;
 
     if (ins & 0x10) {
-        ctx->font->hint.gs.rp0 = pointIdx;
+        ctx->render->gs.rp0 = pointIdx;
     }
 
     TTY_LOG_POINT(*pointCur);
@@ -1707,223 +2266,211 @@ static void tty_MIRP(TTY_Program_Context* ctx, TTY_U8 ins) {
 
 static void tty_MPPEM(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    tty_interp_stack_push(&ctx->font->hint.stack, ctx->instance->ppem);
+    tty_interp_stack_push(&ctx->render->stack, ctx->instance->ppem);
     TTY_LOG_VALUE(ctx->instance->ppem);
 }
 
 static void tty_MUL(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_F26Dot6 n1     = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_F26Dot6 n2     = tty_interp_stack_pop(&ctx->font->hint.stack);
+    TTY_F26Dot6 n1     = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_F26Dot6 n2     = tty_interp_stack_pop(&ctx->render->stack);
     TTY_F26Dot6 result = TTY_F26DOT6_MUL(n1, n2);
-    tty_interp_stack_push(&ctx->font->hint.stack, result);
+    tty_interp_stack_push(&ctx->render->stack, result);
     TTY_LOG_VALUE(result);
 }
 
 static void tty_NEG(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_F26Dot6 val = tty_interp_stack_pop(&ctx->font->hint.stack);
-    tty_interp_stack_push(&ctx->font->hint.stack, -val);
-    TTY_LOG_INTERP_STACK_TOP(ctx->font->hint.stack);
+    TTY_F26Dot6 val = tty_interp_stack_pop(&ctx->render->stack);
+    tty_interp_stack_push(&ctx->render->stack, -val);
+    TTY_LOG_INTERP_STACK_TOP(ctx->render->stack);
 }
 
 static void tty_NEQ(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_S32 e2 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_S32 e1 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    tty_interp_stack_push(&ctx->font->hint.stack, e1 != e2 ? 1 : 0);
-    TTY_LOG_INTERP_STACK_TOP(ctx->font->hint.stack);
+    TTY_S32 e2 = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_S32 e1 = tty_interp_stack_pop(&ctx->render->stack);
+    tty_interp_stack_push(&ctx->render->stack, e1 != e2 ? 1 : 0);
+    TTY_LOG_INTERP_STACK_TOP(ctx->render->stack);
 }
 
 static void tty_NOT(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_S32 val = tty_interp_stack_pop(&ctx->font->hint.stack);
-    tty_interp_stack_push(&ctx->font->hint.stack, !val);
-    TTY_LOG_INTERP_STACK_TOP(ctx->font->hint.stack);
-}
-
-static void tty_NPUSHB(TTY_Program_Context* ctx) {
-    TTY_LOG_INS();
-    TTY_U8 ins = tty_ins_stream_next(&ctx->stream);
-    tty_interp_stack_push_bytes_from_stream(&ctx->font->hint.stack, &ctx->stream, ins);
-}
-
-static void tty_NPUSHW(TTY_Program_Context* ctx) {
-    TTY_LOG_INS();
-    TTY_U8 ins = tty_ins_stream_next(&ctx->stream);
-    tty_interp_stack_push_words_from_stream(&ctx->font->hint.stack, &ctx->stream, ins);
+    TTY_S32 val = tty_interp_stack_pop(&ctx->render->stack);
+    tty_interp_stack_push(&ctx->render->stack, !val);
+    TTY_LOG_INTERP_STACK_TOP(ctx->render->stack);
 }
 
 static void tty_OR(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_S32 e1 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_S32 e2 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    tty_interp_stack_push(&ctx->font->hint.stack, (e1 != 0 || e2 != 0) ? 1 : 0);
-    TTY_LOG_INTERP_STACK_TOP(ctx->font->hint.stack);
+    TTY_S32 e1 = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_S32 e2 = tty_interp_stack_pop(&ctx->render->stack);
+    tty_interp_stack_push(&ctx->render->stack, (e1 != 0 || e2 != 0) ? 1 : 0);
+    TTY_LOG_INTERP_STACK_TOP(ctx->render->stack);
 }
 
 static void tty_POP(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    tty_interp_stack_pop(&ctx->font->hint.stack);
+    tty_interp_stack_pop(&ctx->render->stack);
 }
 
-static void tty_PUSHB(TTY_Program_Context* ctx, TTY_U8 ins) {
+static void tty_PUSH(TTY_Program_Context* ctx, TTY_Op* op) {
     TTY_LOG_INS();
-    tty_interp_stack_push_bytes_from_stream(&ctx->font->hint.stack, &ctx->stream, 1 + (ins & 0x7));
-}
-
-static void tty_PUSHW(TTY_Program_Context* ctx, TTY_U8 ins) {
-    TTY_LOG_INS();
-    tty_interp_stack_push_words_from_stream(&ctx->font->hint.stack, &ctx->stream, 1 + (ins & 0x7));
+    TTY_ASSERT(ctx->render->stack.count + op->numValues <= ctx->render->stack.cap);
+    
+    TTY_S32* values = ctx->program->values + op->valueOff;
+    for (TTY_U32 i = 0; i < op->numValues; i++) {
+        ctx->render->stack.buff[ctx->render->stack.count++] = values[i];
+    }
 }
 
 static void tty_RCVT(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
     
-    TTY_U32 cvtIdx = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_ASSERT(cvtIdx < ctx->instance->hint.cvt.cap);
+    TTY_U32 cvtIdx = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_ASSERT(cvtIdx < ctx->cvt->cap);
 
-    tty_interp_stack_push(&ctx->font->hint.stack, ctx->instance->hint.cvt.buff[cvtIdx]);
-    TTY_LOG_VALUE(ctx->instance->hint.cvt.buff[cvtIdx]);
+    tty_interp_stack_push(&ctx->render->stack, ctx->cvt->buff[cvtIdx]);
+    TTY_LOG_VALUE(ctx->cvt->buff[cvtIdx]);
 }
 
 static void tty_RDTG(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    ctx->font->hint.gs.roundState = TTY_ROUND_DOWN_TO_GRID;
+    ctx->render->gs.roundState = TTY_ROUND_DOWN_TO_GRID;
 }
 
 static void tty_ROFF(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    ctx->font->hint.gs.roundState = TTY_ROUND_OFF;
+    ctx->render->gs.roundState = TTY_ROUND_OFF;
 }
 
 static void tty_ROLL(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_U32 a = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_U32 b = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_U32 c = tty_interp_stack_pop(&ctx->font->hint.stack);
-    tty_interp_stack_push(&ctx->font->hint.stack, b);
-    tty_interp_stack_push(&ctx->font->hint.stack, a);
-    tty_interp_stack_push(&ctx->font->hint.stack, c);
+    TTY_U32 a = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_U32 b = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_U32 c = tty_interp_stack_pop(&ctx->render->stack);
+    tty_interp_stack_push(&ctx->render->stack, b);
+    tty_interp_stack_push(&ctx->render->stack, a);
+    tty_interp_stack_push(&ctx->render->stack, c);
 }
 
 static void tty_ROUND(TTY_Program_Context* ctx, TTY_U8 ins) {
     TTY_LOG_INS();
-    TTY_F26Dot6 dist = tty_interp_stack_pop(&ctx->font->hint.stack);
+    TTY_F26Dot6 dist = tty_interp_stack_pop(&ctx->render->stack);
     dist = tty_round_according_to_round_state(ctx, dist);
-    tty_interp_stack_push(&ctx->font->hint.stack, dist);
+    tty_interp_stack_push(&ctx->render->stack, dist);
     TTY_LOG_VALUE(dist);
 }
 
 static void tty_RS(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_U32 idx = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_ASSERT(idx < ctx->instance->hint.storage.cap);
-    tty_interp_stack_push(&ctx->font->hint.stack, ctx->instance->hint.storage.buff[idx]);
-    TTY_LOG_VALUE(ctx->instance->hint.storage.buff[idx]);
+    TTY_U32 idx = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_ASSERT(idx < ctx->storage->cap);
+    tty_interp_stack_push(&ctx->render->stack, ctx->storage->buff[idx]);
+    TTY_LOG_VALUE(ctx->storage->buff[idx]);
 }
 
 static void tty_RTDG(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    ctx->font->hint.gs.roundState = TTY_ROUND_TO_DOUBLE_GRID;
+    ctx->render->gs.roundState = TTY_ROUND_TO_DOUBLE_GRID;
 }
 
 static void tty_RTG(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    ctx->font->hint.gs.roundState = TTY_ROUND_TO_GRID;
+    ctx->render->gs.roundState = TTY_ROUND_TO_GRID;
 }
 
 static void tty_RTHG(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    ctx->font->hint.gs.roundState = TTY_ROUND_TO_HALF_GRID;
+    ctx->render->gs.roundState = TTY_ROUND_TO_HALF_GRID;
 }
 
 static void tty_RUTG(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    ctx->font->hint.gs.roundState = TTY_ROUND_UP_TO_GRID;
+    ctx->render->gs.roundState = TTY_ROUND_UP_TO_GRID;
 }
 
 static void tty_SCANCTRL(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
 
-    TTY_U16 flags  = tty_interp_stack_pop(&ctx->font->hint.stack);
+    TTY_U16 flags  = tty_interp_stack_pop(&ctx->render->stack);
     TTY_U8  thresh = flags & 0xFF;
     
     if (thresh == 0xFF) {
-        ctx->font->hint.gs.scanControl = TTY_TRUE;
+        ctx->render->gs.scanControl = TTY_TRUE;
     }
     else if (thresh == 0x0) {
-        ctx->font->hint.gs.scanControl = TTY_FALSE;
+        ctx->render->gs.scanControl = TTY_FALSE;
     }
     else {
         if ((flags & 0x100) && ctx->instance->ppem <= thresh) {
-            ctx->font->hint.gs.scanControl = TTY_TRUE;
+            ctx->render->gs.scanControl = TTY_TRUE;
         }
 
         if ((flags & 0x200) && ctx->instance->isRotated) {
-            ctx->font->hint.gs.scanControl = TTY_TRUE;
+            ctx->render->gs.scanControl = TTY_TRUE;
         }
 
         if ((flags & 0x400) && ctx->instance->isStretched) {
-            ctx->font->hint.gs.scanControl = TTY_TRUE;
+            ctx->render->gs.scanControl = TTY_TRUE;
         }
 
         if ((flags & 0x800) && thresh > ctx->instance->ppem) {
-            ctx->font->hint.gs.scanControl = TTY_FALSE;
+            ctx->render->gs.scanControl = TTY_FALSE;
         }
 
         if ((flags & 0x1000) && !ctx->instance->isRotated) {
-            ctx->font->hint.gs.scanControl = TTY_FALSE;
+            ctx->render->gs.scanControl = TTY_FALSE;
         }
 
         if ((flags & 0x2000) && !ctx->instance->isStretched) {
-            ctx->font->hint.gs.scanControl = TTY_FALSE;
+            ctx->render->gs.scanControl = TTY_FALSE;
         }
     }
 
-    TTY_LOG_VALUE(ctx->font->hint.gs.scanControl);
+    TTY_LOG_VALUE(ctx->render->gs.scanControl);
 }
 
 static void tty_SCANTYPE(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    ctx->font->hint.gs.scanType = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_LOG_VALUE(ctx->font->hint.gs.scanType);
+    ctx->render->gs.scanType = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_LOG_VALUE(ctx->render->gs.scanType);
 }
 
 static void tty_SCVTCI(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    ctx->font->hint.gs.controlValueCutIn = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_LOG_VALUE(ctx->font->hint.gs.controlValueCutIn);
+    ctx->render->gs.controlValueCutIn = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_LOG_VALUE(ctx->render->gs.controlValueCutIn);
 }
 
 static void tty_SDB(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    ctx->font->hint.gs.deltaBase = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_LOG_VALUE(ctx->font->hint.gs.deltaBase);
+    ctx->render->gs.deltaBase = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_LOG_VALUE(ctx->render->gs.deltaBase);
 }
 
 static void tty_SDPVTL(TTY_Program_Context* ctx, TTY_U8 ins) {
     TTY_LOG_INS();
 
-    TTY_U32 p1Idx = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_U32 p2Idx = tty_interp_stack_pop(&ctx->font->hint.stack);
+    TTY_U32 p1Idx = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_U32 p2Idx = tty_interp_stack_pop(&ctx->render->stack);
 
-    TTY_ASSERT(p1Idx < ctx->font->hint.gs.zp2->numPoints);
-    TTY_ASSERT(p2Idx < ctx->font->hint.gs.zp1->numPoints);
+    TTY_ASSERT(p1Idx < ctx->render->gs.zp2->numPoints);
+    TTY_ASSERT(p2Idx < ctx->render->gs.zp1->numPoints);
 
     TTY_F26Dot6_V2* p1;
     TTY_F26Dot6_V2* p2;
 
 
-    p1 = ctx->font->hint.gs.zp2->orgScaled + p1Idx;
-    p2 = ctx->font->hint.gs.zp1->orgScaled + p2Idx;
+    p1 = ctx->render->gs.zp2->orgScaled + p1Idx;
+    p2 = ctx->render->gs.zp1->orgScaled + p2Idx;
 
-    ctx->font->hint.gs.dualProjVec.x = p2->x - p1->x;
-    ctx->font->hint.gs.dualProjVec.y = p2->y - p1->y;
+    ctx->render->gs.dualProjVec.x = p2->x - p1->x;
+    ctx->render->gs.dualProjVec.y = p2->y - p1->y;
 
-    if (ctx->font->hint.gs.dualProjVec.x == 0) {
-        if (ctx->font->hint.gs.dualProjVec.y == 0) {
-            ctx->font->hint.gs.dualProjVec.x = 0x4000;
+    if (ctx->render->gs.dualProjVec.x == 0) {
+        if (ctx->render->gs.dualProjVec.y == 0) {
+            ctx->render->gs.dualProjVec.x = 0x4000;
             ins = 0;
         }
     }
@@ -1931,100 +2478,100 @@ static void tty_SDPVTL(TTY_Program_Context* ctx, TTY_U8 ins) {
 
     if (ins & 0x1) {
         // Perpendicular (counter clockwise rotation)
-        TTY_F26Dot6 temp = ctx->font->hint.gs.dualProjVec.y;
-        ctx->font->hint.gs.dualProjVec.y = ctx->font->hint.gs.dualProjVec.x;
-        ctx->font->hint.gs.dualProjVec.x = -temp;
+        TTY_F26Dot6 temp = ctx->render->gs.dualProjVec.y;
+        ctx->render->gs.dualProjVec.y = ctx->render->gs.dualProjVec.x;
+        ctx->render->gs.dualProjVec.x = -temp;
     }
 
-    tty_normalize_f26dot6_to_f2dot14(&ctx->font->hint.gs.dualProjVec);
+    tty_normalize_f26dot6_to_f2dot14(&ctx->render->gs.dualProjVec);
 
 
-    p1 = ctx->font->hint.gs.zp2->cur + p1Idx;
-    p2 = ctx->font->hint.gs.zp1->cur + p2Idx;
+    p1 = ctx->render->gs.zp2->cur + p1Idx;
+    p2 = ctx->render->gs.zp1->cur + p2Idx;
 
-    ctx->font->hint.gs.projVec.x = p2->x - p1->x;
-    ctx->font->hint.gs.projVec.y = p2->y - p1->y;
+    ctx->render->gs.projVec.x = p2->x - p1->x;
+    ctx->render->gs.projVec.y = p2->y - p1->y;
 
     if (ins & 0x1) {
         // Perpendicular (counter clockwise rotation)
-        TTY_F26Dot6 temp = ctx->font->hint.gs.projVec.y;
-        ctx->font->hint.gs.projVec.y = ctx->font->hint.gs.projVec.x;
-        ctx->font->hint.gs.projVec.x = -temp;
+        TTY_F26Dot6 temp = ctx->render->gs.projVec.y;
+        ctx->render->gs.projVec.y = ctx->render->gs.projVec.x;
+        ctx->render->gs.projVec.x = -temp;
     }
 
-    tty_normalize_f26dot6_to_f2dot14(&ctx->font->hint.gs.projVec);
+    tty_normalize_f26dot6_to_f2dot14(&ctx->render->gs.projVec);
     tty_update_proj_dot_free(ctx);
     tty_update_move_point_func(ctx);
 
-    TTY_LOG_POINT(ctx->font->hint.gs.dualProjVec);
-    TTY_LOG_POINT(ctx->font->hint.gs.projVec);
-    TTY_LOG_VALUE(ctx->font->hint.gs.projDotFree);
+    TTY_LOG_POINT(ctx->render->gs.dualProjVec);
+    TTY_LOG_POINT(ctx->render->gs.projVec);
+    TTY_LOG_VALUE(ctx->render->gs.projDotFree);
 }
 
 static void tty_SFVTL(TTY_Program_Context* ctx, TTY_U8 ins) {
     TTY_LOG_INS();
 
-    TTY_U32 p1Idx = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_U32 p2Idx = tty_interp_stack_pop(&ctx->font->hint.stack);
+    TTY_U32 p1Idx = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_U32 p2Idx = tty_interp_stack_pop(&ctx->render->stack);
 
-    TTY_ASSERT(p1Idx < ctx->font->hint.gs.zp2->numPoints);
-    TTY_ASSERT(p2Idx < ctx->font->hint.gs.zp1->numPoints);
+    TTY_ASSERT(p1Idx < ctx->render->gs.zp2->numPoints);
+    TTY_ASSERT(p2Idx < ctx->render->gs.zp1->numPoints);
 
-    TTY_F26Dot6_V2* p1 = ctx->font->hint.gs.zp2->cur + p1Idx;
-    TTY_F26Dot6_V2* p2 = ctx->font->hint.gs.zp1->cur + p2Idx;
+    TTY_F26Dot6_V2* p1 = ctx->render->gs.zp2->cur + p1Idx;
+    TTY_F26Dot6_V2* p2 = ctx->render->gs.zp1->cur + p2Idx;
 
     TTY_F26Dot6_V2 diff;
     TTY_FIX_V2_SUB(p2, p1, &diff);
     tty_normalize_f26dot6_to_f2dot14(&diff);
 
     if (ins & 0x1) {
-        ctx->font->hint.gs.freedomVec.x = -diff.y;
-        ctx->font->hint.gs.freedomVec.y = diff.x;
+        ctx->render->gs.freedomVec.x = -diff.y;
+        ctx->render->gs.freedomVec.y = diff.x;
     }
     else {
-        ctx->font->hint.gs.freedomVec.x = diff.x;
-        ctx->font->hint.gs.freedomVec.y = diff.y;
+        ctx->render->gs.freedomVec.x = diff.x;
+        ctx->render->gs.freedomVec.y = diff.y;
     }
 
     tty_update_proj_dot_free(ctx);
     tty_update_move_point_func(ctx);
 
-    TTY_LOG_POINT(ctx->font->hint.gs.freedomVec);
-    TTY_LOG_VALUE(ctx->font->hint.gs.projDotFree);
+    TTY_LOG_POINT(ctx->render->gs.freedomVec);
+    TTY_LOG_VALUE(ctx->render->gs.projDotFree);
 }
 
 static void tty_SDS(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    ctx->font->hint.gs.deltaShift = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_LOG_VALUE(ctx->font->hint.gs.deltaShift);
+    ctx->render->gs.deltaShift = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_LOG_VALUE(ctx->render->gs.deltaShift);
 }
 
 static void tty_SFVTCA(TTY_Program_Context* ctx, TTY_U8 ins) {
     TTY_LOG_INS();
 
     if (ins & 0x1) {
-        ctx->font->hint.gs.freedomVec.x = 0x4000;
-        ctx->font->hint.gs.freedomVec.y = 0;
+        ctx->render->gs.freedomVec.x = 0x4000;
+        ctx->render->gs.freedomVec.y = 0;
     }
     else {
-        ctx->font->hint.gs.freedomVec.x = 0;
-        ctx->font->hint.gs.freedomVec.y = 0x4000;
+        ctx->render->gs.freedomVec.x = 0;
+        ctx->render->gs.freedomVec.y = 0x4000;
     }
 
     tty_update_proj_dot_free(ctx);
     tty_update_move_point_func(ctx);
 
-    TTY_LOG_POINT(ctx->font->hint.gs.freedomVec);
-    TTY_LOG_VALUE(ctx->font->hint.gs.projDotFree);
+    TTY_LOG_POINT(ctx->render->gs.freedomVec);
+    TTY_LOG_VALUE(ctx->render->gs.projDotFree);
 }
 
 static void tty_SFVTPV(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    ctx->font->hint.gs.freedomVec = ctx->font->hint.gs.projVec;
+    ctx->render->gs.freedomVec = ctx->render->gs.projVec;
     tty_update_proj_dot_free(ctx);
     tty_update_move_point_func(ctx);
-    TTY_LOG_POINT(ctx->font->hint.gs.freedomVec);
-    TTY_LOG_VALUE(ctx->font->hint.gs.projDotFree);
+    TTY_LOG_POINT(ctx->render->gs.freedomVec);
+    TTY_LOG_VALUE(ctx->render->gs.projDotFree);
 }
 
 static void tty_SHP(TTY_Program_Context* ctx, TTY_U8 ins) {
@@ -2035,14 +2582,14 @@ static void tty_SHP(TTY_Program_Context* ctx, TTY_U8 ins) {
         TTY_F26Dot6_V2* refPointCur, *refPointOrg;
 
         if (ins & 0x1) {
-            TTY_ASSERT(ctx->font->hint.gs.rp1 < ctx->font->hint.gs.zp0->numPoints);
-            refPointCur = ctx->font->hint.gs.zp0->cur       + ctx->font->hint.gs.rp1;
-            refPointOrg = ctx->font->hint.gs.zp0->orgScaled + ctx->font->hint.gs.rp1;
+            TTY_ASSERT(ctx->render->gs.rp1 < ctx->render->gs.zp0->numPoints);
+            refPointCur = ctx->render->gs.zp0->cur       + ctx->render->gs.rp1;
+            refPointOrg = ctx->render->gs.zp0->orgScaled + ctx->render->gs.rp1;
         }
         else {
-            TTY_ASSERT(ctx->font->hint.gs.rp2 < ctx->font->hint.gs.zp1->numPoints);
-            refPointCur = ctx->font->hint.gs.zp1->cur       + ctx->font->hint.gs.rp2;
-            refPointOrg = ctx->font->hint.gs.zp1->orgScaled + ctx->font->hint.gs.rp2;
+            TTY_ASSERT(ctx->render->gs.rp2 < ctx->render->gs.zp1->numPoints);
+            refPointCur = ctx->render->gs.zp1->cur       + ctx->render->gs.rp2;
+            refPointOrg = ctx->render->gs.zp1->orgScaled + ctx->render->gs.rp2;
         }
 
         TTY_F26Dot6 d = tty_sub_proj(ctx, refPointCur, refPointOrg);
@@ -2051,15 +2598,15 @@ static void tty_SHP(TTY_Program_Context* ctx, TTY_U8 ins) {
         dist.y = tty_mul_y_free_div_proj_dot_free(ctx, d);
     }
 
-    for (TTY_U32 i = 0; i < ctx->font->hint.gs.loop; i++) {
-        TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->font->hint.stack);
-        TTY_ASSERT(pointIdx < ctx->font->hint.gs.zp2->numPoints);
+    for (TTY_U32 i = 0; i < ctx->render->gs.loop; i++) {
+        TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->render->stack);
+        TTY_ASSERT(pointIdx < ctx->render->gs.zp2->numPoints);
 
         tty_move_point_zp2(ctx, pointIdx, &dist, TTY_TRUE);
-        TTY_LOG_POINT(ctx->font->hint.gs.zp2->cur[pointIdx]);
+        TTY_LOG_POINT(ctx->render->gs.zp2->cur[pointIdx]);
     }
 
-    ctx->font->hint.gs.loop = 1;
+    ctx->render->gs.loop = 1;
 }
 
 static void tty_SHPIX(TTY_Program_Context* ctx) {
@@ -2067,17 +2614,17 @@ static void tty_SHPIX(TTY_Program_Context* ctx) {
     
     TTY_F26Dot6_V2 dist;
     {
-        TTY_F26Dot6 amt = tty_interp_stack_pop(&ctx->font->hint.stack);
-        dist.x = TTY_F2DOT14_MUL(amt, ctx->font->hint.gs.freedomVec.x);
-        dist.y = TTY_F2DOT14_MUL(amt, ctx->font->hint.gs.freedomVec.y);
+        TTY_F26Dot6 amt = tty_interp_stack_pop(&ctx->render->stack);
+        dist.x = TTY_F2DOT14_MUL(amt, ctx->render->gs.freedomVec.x);
+        dist.y = TTY_F2DOT14_MUL(amt, ctx->render->gs.freedomVec.y);
     }
 
     TTY_Bool isTwilightZone =
-        ctx->font->hint.gs.gep0 == 0 && ctx->font->hint.gs.gep1 == 0 && ctx->font->hint.gs.gep2 == 0;
+        ctx->render->gs.gep0 == 0 && ctx->render->gs.gep1 == 0 && ctx->render->gs.gep2 == 0;
 
-    for (TTY_U32 i = 0; i < ctx->font->hint.gs.loop; i++) {
-        TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->font->hint.stack);
-        TTY_ASSERT(pointIdx < ctx->font->hint.gs.zp2->numPoints);
+    for (TTY_U32 i = 0; i < ctx->render->gs.loop; i++) {
+        TTY_U32 pointIdx = tty_interp_stack_pop(&ctx->render->stack);
+        TTY_ASSERT(pointIdx < ctx->render->gs.zp2->numPoints);
 
         // In accordance with the FreeType's v40 interpreter (with backward 
         // compatability enabled), SHPIX can only move a point if one of the 
@@ -2090,471 +2637,1253 @@ static void tty_SHPIX(TTY_Program_Context* ctx) {
 
         if (!shouldMove && ctx->iupState != TTY_IUP_STATE_XY) {
             shouldMove = 
-                (ctx->glyph->numContours < 0 && ctx->font->hint.gs.freedomVec.y != 0) ||
-                (ctx->font->hint.gs.zp2->touchFlags[pointIdx] & TTY_TOUCH_Y);
+                (ctx->glyph->numContours < 0 && ctx->render->gs.freedomVec.y != 0) ||
+                (ctx->render->gs.zp2->touchFlags[pointIdx] & TTY_TOUCH_Y);
         }
 
         if (shouldMove) {
             tty_move_point_zp2(ctx, pointIdx, &dist, TTY_TRUE);
-            TTY_LOG_POINT(ctx->font->hint.gs.zp2->cur[pointIdx]);
+            TTY_LOG_POINT(ctx->render->gs.zp2->cur[pointIdx]);
         }
     }
 
-    ctx->font->hint.gs.loop = 1;
+    ctx->render->gs.loop = 1;
 }
 
 static void tty_SLOOP(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    ctx->font->hint.gs.loop = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_LOG_VALUE(ctx->font->hint.gs.loop);
+    ctx->render->gs.loop = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_LOG_VALUE(ctx->render->gs.loop);
 }
 
 static void tty_SMD(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    ctx->font->hint.gs.minDist = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_LOG_VALUE(ctx->font->hint.gs.minDist);
+    ctx->render->gs.minDist = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_LOG_VALUE(ctx->render->gs.minDist);
 }
 
 static void tty_SPVTCA(TTY_Program_Context* ctx, TTY_U8 ins) {
     TTY_LOG_INS();
 
     if (ins & 0x1) {
-        ctx->font->hint.gs.projVec.x = 0x4000;
-        ctx->font->hint.gs.projVec.y = 0;
+        ctx->render->gs.projVec.x = 0x4000;
+        ctx->render->gs.projVec.y = 0;
     }
     else {
-        ctx->font->hint.gs.projVec.x = 0;
-        ctx->font->hint.gs.projVec.y = 0x4000;
+        ctx->render->gs.projVec.x = 0;
+        ctx->render->gs.projVec.y = 0x4000;
     }
 
-    ctx->font->hint.gs.dualProjVec = ctx->font->hint.gs.projVec;
+    ctx->render->gs.dualProjVec = ctx->render->gs.projVec;
     tty_update_proj_dot_free(ctx);
     tty_update_move_point_func(ctx);
 
-    TTY_LOG_POINT(ctx->font->hint.gs.projVec);
-    TTY_LOG_POINT(ctx->font->hint.gs.dualProjVec);
-    TTY_LOG_VALUE(ctx->font->hint.gs.projDotFree);
+    TTY_LOG_POINT(ctx->render->gs.projVec);
+    TTY_LOG_POINT(ctx->render->gs.dualProjVec);
+    TTY_LOG_VALUE(ctx->render->gs.projDotFree);
 }
 
 static void tty_SRP0(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    ctx->font->hint.gs.rp0 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_LOG_VALUE(ctx->font->hint.gs.rp0);
+    ctx->render->gs.rp0 = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_LOG_VALUE(ctx->render->gs.rp0);
 }
 
 static void tty_SRP1(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    ctx->font->hint.gs.rp1 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_LOG_VALUE(ctx->font->hint.gs.rp1);
+    ctx->render->gs.rp1 = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_LOG_VALUE(ctx->render->gs.rp1);
 }
 
 static void tty_SRP2(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    ctx->font->hint.gs.rp2 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_LOG_VALUE(ctx->font->hint.gs.rp2);
+    ctx->render->gs.rp2 = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_LOG_VALUE(ctx->render->gs.rp2);
 }
 
 static void tty_SUB(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_F26Dot6 n1 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_F26Dot6 n2 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    tty_interp_stack_push(&ctx->font->hint.stack, n2 - n1);
-    TTY_LOG_INTERP_STACK_TOP(ctx->font->hint.stack);
+    TTY_F26Dot6 n1 = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_F26Dot6 n2 = tty_interp_stack_pop(&ctx->render->stack);
+    tty_interp_stack_push(&ctx->render->stack, n2 - n1);
+    TTY_LOG_INTERP_STACK_TOP(ctx->render->stack);
 }
 
 static void tty_SVTCA(TTY_Program_Context* ctx, TTY_U8 ins) {
     TTY_LOG_INS();
 
     if (ins & 0x1) {
-        ctx->font->hint.gs.freedomVec.x = 0x4000;
-        ctx->font->hint.gs.freedomVec.y = 0;
-        ctx->font->hint.gs.move_point   = tty_move_point_x;
+        ctx->render->gs.freedomVec.x = 0x4000;
+        ctx->render->gs.freedomVec.y = 0;
+        ctx->render->gs.move_point   = tty_move_point_x;
     }
     else {
-        ctx->font->hint.gs.freedomVec.x = 0;
-        ctx->font->hint.gs.freedomVec.y = 0x4000;
-        ctx->font->hint.gs.move_point   = tty_move_point_y;
+        ctx->render->gs.freedomVec.x = 0;
+        ctx->render->gs.freedomVec.y = 0x4000;
+        ctx->render->gs.move_point   = tty_move_point_y;
     }
 
-    ctx->font->hint.gs.projVec     = ctx->font->hint.gs.freedomVec;
-    ctx->font->hint.gs.dualProjVec = ctx->font->hint.gs.freedomVec;
-    ctx->font->hint.gs.projDotFree = 0x40000000;
+    ctx->render->gs.projVec     = ctx->render->gs.freedomVec;
+    ctx->render->gs.dualProjVec = ctx->render->gs.freedomVec;
+    ctx->render->gs.projDotFree = 0x40000000;
 
-    TTY_LOG_POINT(ctx->font->hint.gs.projVec);
-    TTY_LOG_POINT(ctx->font->hint.gs.dualProjVec);
-    TTY_LOG_POINT(ctx->font->hint.gs.freedomVec);
-    TTY_LOG_VALUE(ctx->font->hint.gs.projDotFree);
+    TTY_LOG_POINT(ctx->render->gs.projVec);
+    TTY_LOG_POINT(ctx->render->gs.dualProjVec);
+    TTY_LOG_POINT(ctx->render->gs.freedomVec);
+    TTY_LOG_VALUE(ctx->render->gs.projDotFree);
 }
 
 static void tty_SWAP(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_U32 e2 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_U32 e1 = tty_interp_stack_pop(&ctx->font->hint.stack);
-    tty_interp_stack_push(&ctx->font->hint.stack, e2);
-    tty_interp_stack_push(&ctx->font->hint.stack, e1);
+    TTY_U32 e2 = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_U32 e1 = tty_interp_stack_pop(&ctx->render->stack);
+    tty_interp_stack_push(&ctx->render->stack, e2);
+    tty_interp_stack_push(&ctx->render->stack, e1);
 }
 
 static void tty_SZPS(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_U32 zone = tty_interp_stack_pop(&ctx->font->hint.stack);
-    ctx->font->hint.gs.zp0  = tty_get_zone_pointer(ctx, zone);
-    ctx->font->hint.gs.zp1  = ctx->font->hint.gs.zp0;
-    ctx->font->hint.gs.zp2  = ctx->font->hint.gs.zp0;
-    ctx->font->hint.gs.gep0 = zone;
-    ctx->font->hint.gs.gep1 = zone;
-    ctx->font->hint.gs.gep2 = zone;
+    TTY_U32 zone = tty_interp_stack_pop(&ctx->render->stack);
+    ctx->render->gs.zp0  = tty_get_zone_pointer(ctx, zone);
+    ctx->render->gs.zp1  = ctx->render->gs.zp0;
+    ctx->render->gs.zp2  = ctx->render->gs.zp0;
+    ctx->render->gs.gep0 = zone;
+    ctx->render->gs.gep1 = zone;
+    ctx->render->gs.gep2 = zone;
     TTY_LOG_VALUE(zone);
 }
 
 static void tty_SZP0(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_U32 zone = tty_interp_stack_pop(&ctx->font->hint.stack);
-    ctx->font->hint.gs.zp0  = tty_get_zone_pointer(ctx, zone);
-    ctx->font->hint.gs.gep0 = zone;
+    TTY_U32 zone = tty_interp_stack_pop(&ctx->render->stack);
+    ctx->render->gs.zp0  = tty_get_zone_pointer(ctx, zone);
+    ctx->render->gs.gep0 = zone;
     TTY_LOG_VALUE(zone);
 }
 
 static void tty_SZP1(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_U32 zone = tty_interp_stack_pop(&ctx->font->hint.stack);
-    ctx->font->hint.gs.zp1  = tty_get_zone_pointer(ctx, zone);
-    ctx->font->hint.gs.gep1 = zone;
+    TTY_U32 zone = tty_interp_stack_pop(&ctx->render->stack);
+    ctx->render->gs.zp1  = tty_get_zone_pointer(ctx, zone);
+    ctx->render->gs.gep1 = zone;
     TTY_LOG_VALUE(zone);
 }
 
 static void tty_SZP2(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
-    TTY_U32 zone = tty_interp_stack_pop(&ctx->font->hint.stack);
-    ctx->font->hint.gs.zp2  = tty_get_zone_pointer(ctx, zone);
-    ctx->font->hint.gs.gep2 = zone;
+    TTY_U32 zone = tty_interp_stack_pop(&ctx->render->stack);
+    ctx->render->gs.zp2  = tty_get_zone_pointer(ctx, zone);
+    ctx->render->gs.gep2 = zone;
     TTY_LOG_VALUE(zone);
 }
 
 static void tty_WCVTF(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
 
-    TTY_U32 funits = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_U32 cvtIdx = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_ASSERT(cvtIdx < ctx->instance->hint.cvt.cap);
+    TTY_U32 funits = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_U32 cvtIdx = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_ASSERT(cvtIdx < ctx->cvt->cap);
 
-    ctx->instance->hint.cvt.buff[cvtIdx] = TTY_F10DOT22_MUL(funits << 6, ctx->instance->scale);
+    ctx->cvt->buff[cvtIdx] = TTY_F10DOT22_MUL(funits << 6, ctx->instance->scale);
 
-    TTY_LOG_VALUE(ctx->instance->hint.cvt.buff[cvtIdx]);
+    TTY_LOG_VALUE(ctx->cvt->buff[cvtIdx]);
 }
 
 static void tty_WCVTP(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
 
-    TTY_U32 pixels = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_U32 cvtIdx = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_ASSERT(cvtIdx < ctx->instance->hint.cvt.cap);
+    TTY_U32 pixels = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_U32 cvtIdx = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_ASSERT(cvtIdx < ctx->cvt->cap);
 
-    ctx->instance->hint.cvt.buff[cvtIdx] = pixels;
-    TTY_LOG_VALUE(ctx->instance->hint.cvt.buff[cvtIdx]);
+    ctx->cvt->buff[cvtIdx] = pixels;
+    TTY_LOG_VALUE(ctx->cvt->buff[cvtIdx]);
 }
 
 static void tty_WS(TTY_Program_Context* ctx) {
     TTY_LOG_INS();
 
-    TTY_S32 value = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_U32 idx   = tty_interp_stack_pop(&ctx->font->hint.stack);
-    TTY_ASSERT(idx < ctx->instance->hint.storage.cap);
+    TTY_S32 value = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_U32 idx   = tty_interp_stack_pop(&ctx->render->stack);
+    TTY_ASSERT(idx < ctx->storage->cap);
+
+    ctx->storage->buff[idx] = value;
+    TTY_LOG_VALUE(ctx->storage->buff[idx]);
+}
+
+// Executes the ops of ctx->program, starting at ctx->opIdx. Where computed 
+// gotos are available, every op jumps directly to the next op's label so that 
+// each instruction has its own indirect branch for the CPU to predict. 
+// Otherwise, the same labels are cases of a switch.
+static void tty_execute_ops(TTY_Program_Context* ctx) {
+    TTY_Op* ops    = ctx->program->ops;
+    TTY_U32 numOps = ctx->program->numOps;
+    TTY_Op* op;
+
+    // Ops that the program can't use are executed as unknown instructions
+    #define TTY_NEXT_OP_CODE()\
+        (op = ops + ctx->opIdx++,\
+         op->code >= ctx->firstCode && op->code <= ctx->lastCode ? op->code : TTY_OP_UNKNOWN)
+
+#ifdef TTY_COMPUTED_GOTO
+    static const void* const labels[TTY_NUM_OP_CODES] = {
+        [TTY_OP_FDEF]     = &&TTY_LABEL_FDEF,
+        [TTY_OP_PUSH]     = &&TTY_LABEL_PUSH,
+        [TTY_OP_ABS]      = &&TTY_LABEL_ABS,
+        [TTY_OP_ADD]      = &&TTY_LABEL_ADD,
+        [TTY_OP_AND]      = &&TTY_LABEL_AND,
+        [TTY_OP_CALL]     = &&TTY_LABEL_CALL,
+        [TTY_OP_CINDEX]   = &&TTY_LABEL_CINDEX,
+        [TTY_OP_DELTAC1]  = &&TTY_LABEL_DELTAC1,
+        [TTY_OP_DELTAC2]  = &&TTY_LABEL_DELTAC2,
+        [TTY_OP_DELTAC3]  = &&TTY_LABEL_DELTAC3,
+        [TTY_OP_DEPTH]    = &&TTY_LABEL_DEPTH,
+        [TTY_OP_DIV]      = &&TTY_LABEL_DIV,
+        [TTY_OP_DUP]      = &&TTY_LABEL_DUP,
+        [TTY_OP_EIF]      = &&TTY_LABEL_EIF,
+        [TTY_OP_ELSE]     = &&TTY_LABEL_ELSE,
+        [TTY_OP_EQ]       = &&TTY_LABEL_EQ,
+        [TTY_OP_FLOOR]    = &&TTY_LABEL_FLOOR,
+        [TTY_OP_GETINFO]  = &&TTY_LABEL_GETINFO,
+        [TTY_OP_GPV]      = &&TTY_LABEL_GPV,
+        [TTY_OP_GT]       = &&TTY_LABEL_GT,
+        [TTY_OP_GTEQ]     = &&TTY_LABEL_GTEQ,
+        [TTY_OP_IF]       = &&TTY_LABEL_IF,
+        [TTY_OP_JMPR]     = &&TTY_LABEL_JMPR,
+        [TTY_OP_JROT]     = &&TTY_LABEL_JROT,
+        [TTY_OP_LOOPCALL] = &&TTY_LABEL_LOOPCALL,
+        [TTY_OP_LT]       = &&TTY_LABEL_LT,
+        [TTY_OP_LTEQ]     = &&TTY_LABEL_LTEQ,
+        [TTY_OP_MAX]      = &&TTY_LABEL_MAX,
+        [TTY_OP_MIN]      = &&TTY_LABEL_MIN,
+        [TTY_OP_MINDEX]   = &&TTY_LABEL_MINDEX,
+        [TTY_OP_MPPEM]    = &&TTY_LABEL_MPPEM,
+        [TTY_OP_MUL]      = &&TTY_LABEL_MUL,
+        [TTY_OP_NEG]      = &&TTY_LABEL_NEG,
+        [TTY_OP_NEQ]      = &&TTY_LABEL_NEQ,
+        [TTY_OP_NOT]      = &&TTY_LABEL_NOT,
+        [TTY_OP_OR]       = &&TTY_LABEL_OR,
+        [TTY_OP_POP]      = &&TTY_LABEL_POP,
+        [TTY_OP_RCVT]     = &&TTY_LABEL_RCVT,
+        [TTY_OP_RDTG]     = &&TTY_LABEL_RDTG,
+        [TTY_OP_ROFF]     = &&TTY_LABEL_ROFF,
+        [TTY_OP_ROLL]     = &&TTY_LABEL_ROLL,
+        [TTY_OP_ROUND]    = &&TTY_LABEL_ROUND,
+        [TTY_OP_RS]       = &&TTY_LABEL_RS,
+        [TTY_OP_RTDG]     = &&TTY_LABEL_RTDG,
+        [TTY_OP_RTG]      = &&TTY_LABEL_RTG,
+        [TTY_OP_RTHG]     = &&TTY_LABEL_RTHG,
+        [TTY_OP_RUTG]     = &&TTY_LABEL_RUTG,
+        [TTY_OP_SCANCTRL] = &&TTY_LABEL_SCANCTRL,
+        [TTY_OP_SCANTYPE] = &&TTY_LABEL_SCANTYPE,
+        [TTY_OP_SCVTCI]   = &&TTY_LABEL_SCVTCI,
+        [TTY_OP_SDB]      = &&TTY_LABEL_SDB,
+        [TTY_OP_SDS]      = &&TTY_LABEL_SDS,
+        [TTY_OP_SFVTCA]   = &&TTY_LABEL_SFVTCA,
+        [TTY_OP_SFVTPV]   = &&TTY_LABEL_SFVTPV,
+        [TTY_OP_SLOOP]    = &&TTY_LABEL_SLOOP,
+        [TTY_OP_SPVTCA]   = &&TTY_LABEL_SPVTCA,
+        [TTY_OP_SUB]      = &&TTY_LABEL_SUB,
+        [TTY_OP_SVTCA]    = &&TTY_LABEL_SVTCA,
+        [TTY_OP_SWAP]     = &&TTY_LABEL_SWAP,
+        [TTY_OP_WCVTF]    = &&TTY_LABEL_WCVTF,
+        [TTY_OP_WCVTP]    = &&TTY_LABEL_WCVTP,
+        [TTY_OP_WS]       = &&TTY_LABEL_WS,
+        [TTY_OP_ALIGNRP]  = &&TTY_LABEL_ALIGNRP,
+        [TTY_OP_DELTAP1]  = &&TTY_LABEL_DELTAP1,
+        [TTY_OP_DELTAP2]  = &&TTY_LABEL_DELTAP2,
+        [TTY_OP_DELTAP3]  = &&TTY_LABEL_DELTAP3,
+        [TTY_OP_GC]       = &&TTY_LABEL_GC,
+        [TTY_OP_IP]       = &&TTY_LABEL_IP,
+        [TTY_OP_ISECT]    = &&TTY_LABEL_ISECT,
+        [TTY_OP_IUP]      = &&TTY_LABEL_IUP,
+        [TTY_OP_MD]       = &&TTY_LABEL_MD,
+        [TTY_OP_MDAP]     = &&TTY_LABEL_MDAP,
+        [TTY_OP_MDRP]     = &&TTY_LABEL_MDRP,
+        [TTY_OP_MIAP]     = &&TTY_LABEL_MIAP,
+        [TTY_OP_MIRP]     = &&TTY_LABEL_MIRP,
+        [TTY_OP_SDPVTL]   = &&TTY_LABEL_SDPVTL,
+        [TTY_OP_SFVTL]    = &&TTY_LABEL_SFVTL,
+        [TTY_OP_SHP]      = &&TTY_LABEL_SHP,
+        [TTY_OP_SHPIX]    = &&TTY_LABEL_SHPIX,
+        [TTY_OP_SMD]      = &&TTY_LABEL_SMD,
+        [TTY_OP_SRP0]     = &&TTY_LABEL_SRP0,
+        [TTY_OP_SRP1]     = &&TTY_LABEL_SRP1,
+        [TTY_OP_SRP2]     = &&TTY_LABEL_SRP2,
+        [TTY_OP_SZPS]     = &&TTY_LABEL_SZPS,
+        [TTY_OP_SZP0]     = &&TTY_LABEL_SZP0,
+        [TTY_OP_SZP1]     = &&TTY_LABEL_SZP1,
+        [TTY_OP_SZP2]     = &&TTY_LABEL_SZP2,
+        [TTY_OP_UNKNOWN]  = &&TTY_LABEL_UNKNOWN,
+    };
+
+    #define TTY_OP(name) TTY_LABEL_##name
+
+    #define TTY_DISPATCH()\
+        if (ctx->opIdx >= numOps) {\
+            return;\
+        }\
+        TTY_PROFILE_INS(ctx);\
+        goto *labels[TTY_NEXT_OP_CODE()]
 
-    ctx->instance->hint.storage.buff[idx] = value;
-    TTY_LOG_VALUE(ctx->instance->hint.storage.buff[idx]);
-}
+    TTY_DISPATCH();
+#else
+    #define TTY_OP(name) case TTY_OP_##name
 
-static TTY_Error tty_execute_program(TTY_Program_Context* ctx) {
-    while (tty_ins_stream_has_next(&ctx->stream)) {
-        ctx->stream.execute_next_ins(ctx);
-        if (ctx->foundUnknownIns) {
-            return TTY_ERROR_UNKNOWN_INSTRUCTION;
+    #define TTY_DISPATCH() break
+
+    while (ctx->opIdx < numOps) {
+        TTY_PROFILE_INS(ctx);
+        switch (TTY_NEXT_OP_CODE()) {
+#endif
+
+            TTY_OP(FDEF):
+                tty_FDEF(ctx);
+                TTY_DISPATCH();
+            TTY_OP(PUSH):
+                tty_PUSH(ctx, op);
+                TTY_DISPATCH();
+            TTY_OP(ABS):
+                tty_ABS(ctx);
+                TTY_DISPATCH();
+            TTY_OP(ADD):
+                tty_ADD(ctx);
+                TTY_DISPATCH();
+            TTY_OP(AND):
+                tty_AND(ctx);
+                TTY_DISPATCH();
+            TTY_OP(CALL):
+                tty_CALL(ctx);
+                if (ctx->foundUnknownIns) {
+                    return;
+                }
+                TTY_DISPATCH();
+            TTY_OP(CINDEX):
+                tty_CINDEX(ctx);
+                TTY_DISPATCH();
+            TTY_OP(DELTAC1):
+                tty_DELTAC1(ctx);
+                TTY_DISPATCH();
+            TTY_OP(DELTAC2):
+                tty_DELTAC2(ctx);
+                TTY_DISPATCH();
+            TTY_OP(DELTAC3):
+                tty_DELTAC3(ctx);
+                TTY_DISPATCH();
+            TTY_OP(DEPTH):
+                tty_DEPTH(ctx);
+                TTY_DISPATCH();
+            TTY_OP(DIV):
+                tty_DIV(ctx);
+                TTY_DISPATCH();
+            TTY_OP(DUP):
+                tty_DUP(ctx);
+                TTY_DISPATCH();
+            TTY_OP(EIF):
+                tty_EIF(ctx);
+                TTY_DISPATCH();
+            TTY_OP(ELSE):
+                tty_ELSE(ctx);
+                TTY_DISPATCH();
+            TTY_OP(EQ):
+                tty_EQ(ctx);
+                TTY_DISPATCH();
+            TTY_OP(FLOOR):
+                tty_FLOOR(ctx);
+                TTY_DISPATCH();
+            TTY_OP(GETINFO):
+                tty_GETINFO(ctx);
+                TTY_DISPATCH();
+            TTY_OP(GPV):
+                tty_GPV(ctx);
+                TTY_DISPATCH();
+            TTY_OP(GT):
+                tty_GT(ctx);
+                TTY_DISPATCH();
+            TTY_OP(GTEQ):
+                tty_GTEQ(ctx);
+                TTY_DISPATCH();
+            TTY_OP(IF):
+                tty_IF(ctx);
+                TTY_DISPATCH();
+            TTY_OP(JMPR):
+                tty_JMPR(ctx);
+                TTY_DISPATCH();
+            TTY_OP(JROT):
+                tty_JROT(ctx);
+                TTY_DISPATCH();
+            TTY_OP(LOOPCALL):
+                tty_LOOPCALL(ctx);
+                if (ctx->foundUnknownIns) {
+                    return;
+                }
+                TTY_DISPATCH();
+            TTY_OP(LT):
+                tty_LT(ctx);
+                TTY_DISPATCH();
+            TTY_OP(LTEQ):
+                tty_LTEQ(ctx);
+                TTY_DISPATCH();
+            TTY_OP(MAX):
+                tty_MAX(ctx);
+                TTY_DISPATCH();
+            TTY_OP(MIN):
+                tty_MIN(ctx);
+                TTY_DISPATCH();
+            TTY_OP(MINDEX):
+                tty_MINDEX(ctx);
+                TTY_DISPATCH();
+            TTY_OP(MPPEM):
+                tty_MPPEM(ctx);
+                TTY_DISPATCH();
+            TTY_OP(MUL):
+                tty_MUL(ctx);
+                TTY_DISPATCH();
+            TTY_OP(NEG):
+                tty_NEG(ctx);
+                TTY_DISPATCH();
+            TTY_OP(NEQ):
+                tty_NEQ(ctx);
+                TTY_DISPATCH();
+            TTY_OP(NOT):
+                tty_NOT(ctx);
+                TTY_DISPATCH();
+            TTY_OP(OR):
+                tty_OR(ctx);
+                TTY_DISPATCH();
+            TTY_OP(POP):
+                tty_POP(ctx);
+                TTY_DISPATCH();
+            TTY_OP(RCVT):
+                tty_RCVT(ctx);
+                TTY_DISPATCH();
+            TTY_OP(RDTG):
+                tty_RDTG(ctx);
+                TTY_DISPATCH();
+            TTY_OP(ROFF):
+                tty_ROFF(ctx);
+                TTY_DISPATCH();
+            TTY_OP(ROLL):
+                tty_ROLL(ctx);
+                TTY_DISPATCH();
+            TTY_OP(ROUND):
+                tty_ROUND(ctx, op->ins);
+                TTY_DISPATCH();
+            TTY_OP(RS):
+                tty_RS(ctx);
+                TTY_DISPATCH();
+            TTY_OP(RTDG):
+                tty_RTDG(ctx);
+                TTY_DISPATCH();
+            TTY_OP(RTG):
+                tty_RTG(ctx);
+                TTY_DISPATCH();
+            TTY_OP(RTHG):
+                tty_RTHG(ctx);
+                TTY_DISPATCH();
+            TTY_OP(RUTG):
+                tty_RUTG(ctx);
+                TTY_DISPATCH();
+            TTY_OP(SCANCTRL):
+                tty_SCANCTRL(ctx);
+                TTY_DISPATCH();
+            TTY_OP(SCANTYPE):
+                tty_SCANTYPE(ctx);
+                TTY_DISPATCH();
+            TTY_OP(SCVTCI):
+                tty_SCVTCI(ctx);
+                TTY_DISPATCH();
+            TTY_OP(SDB):
+                tty_SDB(ctx);
+                TTY_DISPATCH();
+            TTY_OP(SDS):
+                tty_SDS(ctx);
+                TTY_DISPATCH();
+            TTY_OP(SFVTCA):
+                tty_SFVTCA(ctx, op->ins);
+                TTY_DISPATCH();
+            TTY_OP(SFVTPV):
+                tty_SFVTPV(ctx);
+                TTY_DISPATCH();
+            TTY_OP(SLOOP):
+                tty_SLOOP(ctx);
+                TTY_DISPATCH();
+            TTY_OP(SPVTCA):
+                tty_SPVTCA(ctx, op->ins);
+                TTY_DISPATCH();
+            TTY_OP(SUB):
+                tty_SUB(ctx);
+                TTY_DISPATCH();
+            TTY_OP(SVTCA):
+                tty_SVTCA(ctx, op->ins);
+                TTY_DISPATCH();
+            TTY_OP(SWAP):
+                tty_SWAP(ctx);
+                TTY_DISPATCH();
+            TTY_OP(WCVTF):
+                tty_WCVTF(ctx);
+                TTY_DISPATCH();
+            TTY_OP(WCVTP):
+                tty_WCVTP(ctx);
+                TTY_DISPATCH();
+            TTY_OP(WS):
+                tty_WS(ctx);
+                TTY_DISPATCH();
+            TTY_OP(ALIGNRP):
+                tty_ALIGNRP(ctx);
+                TTY_DISPATCH();
+            TTY_OP(DELTAP1):
+                tty_DELTAP1(ctx);
+                TTY_DISPATCH();
+            TTY_OP(DELTAP2):
+                tty_DELTAP2(ctx);
+                TTY_DISPATCH();
+            TTY_OP(DELTAP3):
+                tty_DELTAP3(ctx);
+                TTY_DISPATCH();
+            TTY_OP(GC):
+                tty_GC(ctx, op->ins);
+                TTY_DISPATCH();
+            TTY_OP(IP):
+                tty_IP(ctx);
+                TTY_DISPATCH();
+            TTY_OP(ISECT):
+                tty_ISECT(ctx);
+                TTY_DISPATCH();
+            TTY_OP(IUP):
+                tty_IUP(ctx, op->ins);
+                TTY_DISPATCH();
+            TTY_OP(MD):
+                tty_MD(ctx, op->ins);
+                TTY_DISPATCH();
+            TTY_OP(MDAP):
+                tty_MDAP(ctx, op->ins);
+                TTY_DISPATCH();
+            TTY_OP(MDRP):
+                tty_MDRP(ctx, op->ins);
+                TTY_DISPATCH();
+            TTY_OP(MIAP):
+                tty_MIAP(ctx, op->ins);
+                TTY_DISPATCH();
+            TTY_OP(MIRP):
+                tty_MIRP(ctx, op->ins);
+                TTY_DISPATCH();
+            TTY_OP(SDPVTL):
+                tty_SDPVTL(ctx, op->ins);
+                TTY_DISPATCH();
+            TTY_OP(SFVTL):
+                tty_SFVTL(ctx, op->ins);
+                TTY_DISPATCH();
+            TTY_OP(SHP):
+                tty_SHP(ctx, op->ins);
+                TTY_DISPATCH();
+            TTY_OP(SHPIX):
+                tty_SHPIX(ctx);
+                TTY_DISPATCH();
+            TTY_OP(SMD):
+                tty_SMD(ctx);
+                TTY_DISPATCH();
+            TTY_OP(SRP0):
+                tty_SRP0(ctx);
+                TTY_DISPATCH();
+            TTY_OP(SRP1):
+                tty_SRP1(ctx);
+                TTY_DISPATCH();
+            TTY_OP(SRP2):
+                tty_SRP2(ctx);
+                TTY_DISPATCH();
+            TTY_OP(SZPS):
+                tty_SZPS(ctx);
+                TTY_DISPATCH();
+            TTY_OP(SZP0):
+                tty_SZP0(ctx);
+                TTY_DISPATCH();
+            TTY_OP(SZP1):
+                tty_SZP1(ctx);
+                TTY_DISPATCH();
+            TTY_OP(SZP2):
+                tty_SZP2(ctx);
+                TTY_DISPATCH();
+            TTY_OP(UNKNOWN):
+                TTY_LOG_UNKNOWN_INS(op->ins);
+                ctx->foundUnknownIns = TTY_TRUE;
+                return;
+#ifndef TTY_COMPUTED_GOTO
         }
     }
+#endif
+
+    #undef TTY_NEXT_OP_CODE
+    #undef TTY_OP
+    #undef TTY_DISPATCH
+}
+
+// Executes a single instruction for a compiled program by calling its 
+// handler directly. Instructions that change which op executes next are 
+// translated by the compiler, so they never reach here.
+static TTY_Bool tty_compiled_execute(TTY_Program_Context* ctx, TTY_U8 ins) {
+    TTY_U8 code = tty_get_op_code(ins);
+
+    TTY_ASSERT(code != TTY_OP_FDEF && code != TTY_OP_PUSH && code != TTY_OP_IF && code != TTY_OP_ELSE &&
+               code != TTY_OP_JMPR && code != TTY_OP_JROT);
+
+    TTY_PROFILE_INS(ctx);
+
+    if (code > ctx->lastCode) {
+        code = TTY_OP_UNKNOWN;
+    }
+
+    switch (code) {
+        case TTY_OP_ABS:      tty_ABS(ctx); break;
+        case TTY_OP_ADD:      tty_ADD(ctx); break;
+        case TTY_OP_AND:      tty_AND(ctx); break;
+        case TTY_OP_CALL:     tty_CALL(ctx); break;
+        case TTY_OP_CINDEX:   tty_CINDEX(ctx); break;
+        case TTY_OP_DELTAC1:  tty_DELTAC1(ctx); break;
+        case TTY_OP_DELTAC2:  tty_DELTAC2(ctx); break;
+        case TTY_OP_DELTAC3:  tty_DELTAC3(ctx); break;
+        case TTY_OP_DEPTH:    tty_DEPTH(ctx); break;
+        case TTY_OP_DIV:      tty_DIV(ctx); break;
+        case TTY_OP_DUP:      tty_DUP(ctx); break;
+        case TTY_OP_EIF:      tty_EIF(ctx); break;
+        case TTY_OP_EQ:       tty_EQ(ctx); break;
+        case TTY_OP_FLOOR:    tty_FLOOR(ctx); break;
+        case TTY_OP_GETINFO:  tty_GETINFO(ctx); break;
+        case TTY_OP_GPV:      tty_GPV(ctx); break;
+        case TTY_OP_GT:       tty_GT(ctx); break;
+        case TTY_OP_GTEQ:     tty_GTEQ(ctx); break;
+        case TTY_OP_LOOPCALL: tty_LOOPCALL(ctx); break;
+        case TTY_OP_LT:       tty_LT(ctx); break;
+        case TTY_OP_LTEQ:     tty_LTEQ(ctx); break;
+        case TTY_OP_MAX:      tty_MAX(ctx); break;
+        case TTY_OP_MIN:      tty_MIN(ctx); break;
+        case TTY_OP_MINDEX:   tty_MINDEX(ctx); break;
+        case TTY_OP_MPPEM:    tty_MPPEM(ctx); break;
+        case TTY_OP_MUL:      tty_MUL(ctx); break;
+        case TTY_OP_NEG:      tty_NEG(ctx); break;
+        case TTY_OP_NEQ:      tty_NEQ(ctx); break;
+        case TTY_OP_NOT:      tty_NOT(ctx); break;
+        case TTY_OP_OR:       tty_OR(ctx); break;
+        case TTY_OP_POP:      tty_POP(ctx); break;
+        case TTY_OP_RCVT:     tty_RCVT(ctx); break;
+        case TTY_OP_RDTG:     tty_RDTG(ctx); break;
+        case TTY_OP_ROFF:     tty_ROFF(ctx); break;
+        case TTY_OP_ROLL:     tty_ROLL(ctx); break;
+        case TTY_OP_ROUND:    tty_ROUND(ctx, ins); break;
+        case TTY_OP_RS:       tty_RS(ctx); break;
+        case TTY_OP_RTDG:     tty_RTDG(ctx); break;
+        case TTY_OP_RTG:      tty_RTG(ctx); break;
+        case TTY_OP_RTHG:     tty_RTHG(ctx); break;
+        case TTY_OP_RUTG:     tty_RUTG(ctx); break;
+        case TTY_OP_SCANCTRL: tty_SCANCTRL(ctx); break;
+        case TTY_OP_SCANTYPE: tty_SCANTYPE(ctx); break;
+        case TTY_OP_SCVTCI:   tty_SCVTCI(ctx); break;
+        case TTY_OP_SDB:      tty_SDB(ctx); break;
+        case TTY_OP_SDS:      tty_SDS(ctx); break;
+        case TTY_OP_SFVTCA:   tty_SFVTCA(ctx, ins); break;
+        case TTY_OP_SFVTPV:   tty_SFVTPV(ctx); break;
+        case TTY_OP_SLOOP:    tty_SLOOP(ctx); break;
+        case TTY_OP_SPVTCA:   tty_SPVTCA(ctx, ins); break;
+        case TTY_OP_SUB:      tty_SUB(ctx); break;
+        case TTY_OP_SVTCA:    tty_SVTCA(ctx, ins); break;
+        case TTY_OP_SWAP:     tty_SWAP(ctx); break;
+        case TTY_OP_WCVTF:    tty_WCVTF(ctx); break;
+        case TTY_OP_WCVTP:    tty_WCVTP(ctx); break;
+        case TTY_OP_WS:       tty_WS(ctx); break;
+        case TTY_OP_ALIGNRP:  tty_ALIGNRP(ctx); break;
+        case TTY_OP_DELTAP1:  tty_DELTAP1(ctx); break;
+        case TTY_OP_DELTAP2:  tty_DELTAP2(ctx); break;
+        case TTY_OP_DELTAP3:  tty_DELTAP3(ctx); break;
+        case TTY_OP_GC:       tty_GC(ctx, ins); break;
+        case TTY_OP_IP:       tty_IP(ctx); break;
+        case TTY_OP_ISECT:    tty_ISECT(ctx); break;
+        case TTY_OP_IUP:      tty_IUP(ctx, ins); break;
+        case TTY_OP_MD:       tty_MD(ctx, ins); break;
+        case TTY_OP_MDAP:     tty_MDAP(ctx, ins); break;
+        case TTY_OP_MDRP:     tty_MDRP(ctx, ins); break;
+        case TTY_OP_MIAP:     tty_MIAP(ctx, ins); break;
+        case TTY_OP_MIRP:     tty_MIRP(ctx, ins); break;
+        case TTY_OP_SDPVTL:   tty_SDPVTL(ctx, ins); break;
+        case TTY_OP_SFVTL:    tty_SFVTL(ctx, ins); break;
+        case TTY_OP_SHP:      tty_SHP(ctx, ins); break;
+        case TTY_OP_SHPIX:    tty_SHPIX(ctx); break;
+        case TTY_OP_SMD:      tty_SMD(ctx); break;
+        case TTY_OP_SRP0:     tty_SRP0(ctx); break;
+        case TTY_OP_SRP1:     tty_SRP1(ctx); break;
+        case TTY_OP_SRP2:     tty_SRP2(ctx); break;
+        case TTY_OP_SZPS:     tty_SZPS(ctx); break;
+        case TTY_OP_SZP0:     tty_SZP0(ctx); break;
+        case TTY_OP_SZP1:     tty_SZP1(ctx); break;
+        case TTY_OP_SZP2:     tty_SZP2(ctx); break;
+        default:
+            TTY_LOG_UNKNOWN_INS(ins);
+            ctx->foundUnknownIns = TTY_TRUE;
+            break;
+    }
+    return !ctx->foundUnknownIns;
+}
+
+static TTY_Bool tty_compiled_call(TTY_Program_Context* ctx, TTY_U32 funcId, TTY_U32 count) {
+    tty_call_func(ctx, funcId, count);
+    return !ctx->foundUnknownIns;
+}
+
+static TTY_Error tty_execute_program(TTY_Program_Context* ctx, TTY_Program* program, TTY_U8 firstCode, TTY_U8 lastCode) {
+    ctx->program   = program;
+    ctx->opIdx     = 0;
+    ctx->firstCode = firstCode;
+    ctx->lastCode  = lastCode;
+    tty_execute_ops(ctx);
+    return ctx->foundUnknownIns ? TTY_ERROR_UNKNOWN_INSTRUCTION : TTY_ERROR_NONE;
+}
+
+
+
+/* --------- */
+/* File Data */
+/* --------- */
+static TTY_Error tty_read_file(const char* path, TTY_U8** data, TTY_S32* size) {
+    // Open the font file
+    FILE* f = fopen(path, "rb");
+    if (f == NULL) {
+        return TTY_ERROR_FAILED_TO_READ_FILE;
+    }
+
+    // Calculate the size of the file
+    if (fseek(f, 0, SEEK_END) != 0  ||
+        (*size = ftell(f))    <  0  ||
+        fseek(f, 0, SEEK_SET) != 0)
+    {
+        fclose(f);
+        return TTY_ERROR_FAILED_TO_READ_FILE;
+    }
+
+    // Allocate a buffer that will store the contents of the file
+    *data = calloc(*size, 1);
+    if (*data == NULL) {
+        fclose(f);
+        return TTY_ERROR_OUT_OF_MEMORY;
+    }
+
+    // Read the file contents into the buffer
+    if ((TTY_S32)fread(*data, 1, *size, f) != *size) {
+        fclose(f);
+        free(*data);
+        *data = NULL;
+        return TTY_ERROR_FAILED_TO_READ_FILE;
+    }
+    fclose(f);
 
     return TTY_ERROR_NONE;
 }
 
-/* A shared instruction is one that can appear in both CV and glyph programs */
-static TTY_Bool tty_try_execute_shared_ins(TTY_Program_Context* ctx, TTY_U8 ins) {
-    switch (ins) {
-        case TTY_ABS:
-            tty_ABS(ctx);
-            return TTY_TRUE;
-        case TTY_ADD:
-            tty_ADD(ctx);
-            return TTY_TRUE;
-        case TTY_AND:
-            tty_AND(ctx);
-            return TTY_TRUE;
-        case TTY_CALL:
-            tty_CALL(ctx);
-            return TTY_TRUE;
-        case TTY_CINDEX:
-            tty_CINDEX(ctx);
-            return TTY_TRUE;
-        case TTY_DELTAC1:
-            tty_DELTAC1(ctx);
-            return TTY_TRUE;
-        case TTY_DELTAC2:
-            tty_DELTAC2(ctx);
-            return TTY_TRUE;
-        case TTY_DELTAC3:
-            tty_DELTAC3(ctx);
-            return TTY_TRUE;
-        case TTY_DEPTH:
-            tty_DEPTH(ctx);
-            return TTY_TRUE;
-        case TTY_DIV:
-            tty_DIV(ctx);
-            return TTY_TRUE;
-        case TTY_DUP:
-            tty_DUP(ctx);
-            return TTY_TRUE;
-        case TTY_EQ:
-            tty_EQ(ctx);
-            return TTY_TRUE;
-        case TTY_FLOOR:
-            tty_FLOOR(ctx);
-            return TTY_TRUE;
-        case TTY_GETINFO:
-            tty_GETINFO(ctx);
-            return TTY_TRUE;
-        case TTY_GPV:
-            tty_GPV(ctx);
-            return TTY_TRUE;
-        case TTY_GT:
-            tty_GT(ctx);
-            return TTY_TRUE;
-        case TTY_GTEQ:
-            tty_GTEQ(ctx);
-            return TTY_TRUE;
-        case TTY_IF:
-            tty_IF(ctx);
-            return TTY_TRUE;
-        case TTY_JROT:
-            tty_JROT(ctx);
-            return TTY_TRUE;
-        case TTY_JMPR:
-            tty_JMPR(ctx);
-            return TTY_TRUE;
-        case TTY_LOOPCALL:
-            tty_LOOPCALL(ctx);
-            return TTY_TRUE;
-        case TTY_LT:
-            tty_LT(ctx);
-            return TTY_TRUE;
-        case TTY_LTEQ:
-            tty_LTEQ(ctx);
-            return TTY_TRUE;
-        case TTY_MAX:
-            tty_MAX(ctx);
-            return TTY_TRUE;
-        case TTY_MIN:
-            tty_MIN(ctx);
-            return TTY_TRUE;
-        case TTY_MINDEX:
-            tty_MINDEX(ctx);
-            return TTY_TRUE;
-        case TTY_MPPEM:
-            tty_MPPEM(ctx);
-            return TTY_TRUE;
-        case TTY_MUL:
-            tty_MUL(ctx);
-            return TTY_TRUE;
-        case TTY_NEG:
-            tty_NEG(ctx);
-            return TTY_TRUE;
-        case TTY_NEQ:
-            tty_NEQ(ctx);
-            return TTY_TRUE;
-        case TTY_NOT:
-            tty_NOT(ctx);
-            return TTY_TRUE;
-        case TTY_NPUSHB:
-            tty_NPUSHB(ctx);
-            return TTY_TRUE;
-        case TTY_NPUSHW:
-            tty_NPUSHW(ctx);
-            return TTY_TRUE;
-        case TTY_OR:
-            tty_OR(ctx);
-            return TTY_TRUE;
-        case TTY_POP:
-            tty_POP(ctx);
-            return TTY_TRUE;
-        case TTY_RCVT:
-            tty_RCVT(ctx);
-            return TTY_TRUE;
-        case TTY_RDTG:
-            tty_RDTG(ctx);
-            return TTY_TRUE;
-        case TTY_ROFF:
-            tty_ROFF(ctx);
-            return TTY_TRUE;
-        case TTY_ROLL:
-            tty_ROLL(ctx);
-            return TTY_TRUE;
-        case TTY_RS:
-            tty_RS(ctx);
-            return TTY_TRUE;
-        case TTY_RTDG:
-            tty_RTDG(ctx);
-            return TTY_TRUE;
-        case TTY_RTG:
-            tty_RTG(ctx);
-            return TTY_TRUE;
-        case TTY_RTHG:
-            tty_RTHG(ctx);
-            return TTY_TRUE;
-        case TTY_RUTG:
-            tty_RUTG(ctx);
-            return TTY_TRUE;
-        case TTY_SCANCTRL:
-            tty_SCANCTRL(ctx);
-            return TTY_TRUE;
-        case TTY_SCANTYPE:
-            tty_SCANTYPE(ctx);
-            return TTY_TRUE;
-        case TTY_SCVTCI:
-            tty_SCVTCI(ctx);
-            return TTY_TRUE;
-        case TTY_SDB:
-            tty_SDB(ctx);
-            return TTY_TRUE;
-        case TTY_SDS:
-            tty_SDS(ctx);
-            return TTY_TRUE;
-        case TTY_SFVTPV:
-            tty_SFVTPV(ctx);
-            return TTY_TRUE;
-        case TTY_SLOOP:
-            tty_SLOOP(ctx);
-            return TTY_TRUE;
-        case TTY_SUB:
-            tty_SUB(ctx);
-            return TTY_TRUE;
-        case TTY_SWAP:
-            tty_SWAP(ctx);
-            return TTY_TRUE;
-        case TTY_WCVTF:
-            tty_WCVTF(ctx);
-            return TTY_TRUE;
-        case TTY_WCVTP:
-            tty_WCVTP(ctx);
-            return TTY_TRUE;
-        case TTY_WS:
-            tty_WS(ctx);
-            return TTY_TRUE;
+static TTY_Error tty_map_file(const char* path, TTY_U8** data, TTY_S32* size) {
+    // The file is mapped read-only so that only the pages which are actually
+    // accessed (i.e. the table directory, cmap, loca, and the glyf records 
+    // that get rendered) are ever read from disk
+    
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_FLAG_RANDOM_ACCESS, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+        return TTY_ERROR_FAILED_TO_READ_FILE;
     }
 
-    if (ins >= TTY_PUSHB && ins <= TTY_PUSHB_MAX) {
-        tty_PUSHB(ctx, ins);
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart <= 0 || fileSize.QuadPart > INT32_MAX) {
+        CloseHandle(file);
+        return TTY_ERROR_FAILED_TO_READ_FILE;
+    }
+
+    // The view keeps the mapping alive, so neither handle is needed after
+    // the view has been created
+    HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (mapping == NULL) {
+        return TTY_ERROR_FAILED_TO_READ_FILE;
+    }
+
+    void* view = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    CloseHandle(mapping);
+    if (view == NULL) {
+        return TTY_ERROR_FAILED_TO_READ_FILE;
+    }
+
+    *data = (TTY_U8*)view;
+    *size = (TTY_S32)fileSize.QuadPart;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return TTY_ERROR_FAILED_TO_READ_FILE;
+    }
+
+    struct stat fileInfo;
+    if (fstat(fd, &fileInfo) != 0 || fileInfo.st_size <= 0 || fileInfo.st_size > INT32_MAX) {
+        close(fd);
+        return TTY_ERROR_FAILED_TO_READ_FILE;
+    }
+
+    // The mapping stays valid after the file descriptor is closed
+    void* view = mmap(NULL, fileInfo.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (view == MAP_FAILED) {
+        return TTY_ERROR_FAILED_TO_READ_FILE;
+    }
+
+    // Glyph data is accessed randomly, so read-ahead would only fault in 
+    // pages that are never used
+    posix_madvise(view, fileInfo.st_size, POSIX_MADV_RANDOM);
+
+    *data = (TTY_U8*)view;
+    *size = (TTY_S32)fileInfo.st_size;
+#endif
+
+    return TTY_ERROR_NONE;
+}
+
+static void tty_unmap_file(TTY_U8* data, TTY_S32 size) {
+    if (data == NULL) {
+        return;
+    }
+#ifdef _WIN32
+    UnmapViewOfFile(data);
+#else
+    munmap(data, size);
+#endif
+}
+
+
+/* ------------- */
+/* Outline Cache */
+/* ------------- */
+#define TTY_OUTLINE_CACHE_BYTES_PER_CHAIN 1024
+
+// Discards every cached outline, but keeps the cache enabled
+static void tty_outline_cache_clear(TTY_Outline_Cache* cache) {
+    TTY_Outline_Cache_Node* node = cache->lruHead;
+    while (node != NULL) {
+        TTY_Outline_Cache_Node* next = node->lruNext;
+        free(node);
+        node = next;
+    }
+    if (cache->chainHeads != NULL) {
+        memset(cache->chainHeads, 0, cache->numChains * sizeof(TTY_Outline_Cache_Node*));
+    }
+    cache->lruHead  = NULL;
+    cache->lruTail  = NULL;
+    cache->numBytes = 0;
+}
+
+static void tty_outline_cache_free(TTY_Outline_Cache* cache) {
+    tty_outline_cache_clear(cache);
+    free(cache->chainHeads);
+    memset(cache, 0, sizeof(TTY_Outline_Cache));
+}
+
+static TTY_Error tty_outline_cache_init(TTY_Outline_Cache* cache, TTY_U32 maxBytes, TTY_U32 numGlyphs) {
+    tty_outline_cache_free(cache);
+    
+    if (maxBytes == 0) {
+        return TTY_ERROR_NONE;
+    }
+
+    {
+        TTY_U32 numChains = TTY_MAX(maxBytes / TTY_OUTLINE_CACHE_BYTES_PER_CHAIN, 1);
+        numChains         = TTY_MIN(numChains, TTY_MAX(numGlyphs, 1));
+
+        cache->chainHeads = (TTY_Outline_Cache_Node**)calloc(numChains, sizeof(TTY_Outline_Cache_Node*));
+        if (cache->chainHeads == NULL) {
+            return TTY_ERROR_OUT_OF_MEMORY;
+        }
+
+        cache->numChains = numChains;
+        cache->maxBytes  = maxBytes;
+    }
+
+    return TTY_ERROR_NONE;
+}
+
+static TTY_Outline_Cache_Node* tty_outline_cache_get(TTY_Outline_Cache* cache, TTY_U32 glyphIdx) {
+    TTY_Outline_Cache_Node* node = cache->chainHeads[TTY_HASH(glyphIdx) % cache->numChains];
+    
+    while (node != NULL && node->glyphIdx != glyphIdx) {
+        node = node->next;
+    }
+
+    if (node == NULL) {
+        cache->numMisses++;
+        return NULL;
+    }
+    cache->numHits++;
+
+    // Move the node to the front of the LRU list
+    if (node != cache->lruHead) {
+        node->lruPrev->lruNext = node->lruNext;
+        if (node == cache->lruTail) {
+            cache->lruTail = node->lruPrev;
+        }
+        else {
+            node->lruNext->lruPrev = node->lruPrev;
+        }
+        node->lruPrev           = NULL;
+        node->lruNext           = cache->lruHead;
+        cache->lruHead->lruPrev = node;
+        cache->lruHead          = node;
+    }
+
+    return node;
+}
+
+static void tty_outline_cache_evict_lru_node(TTY_Outline_Cache* cache) {
+    TTY_Outline_Cache_Node*  node = cache->lruTail;
+    TTY_Outline_Cache_Node** link = cache->chainHeads + (TTY_HASH(node->glyphIdx) % cache->numChains);
+
+    while (*link != node) {
+        link = &(*link)->next;
+    }
+    *link = node->next;
+
+    cache->lruTail = node->lruPrev;
+    if (cache->lruTail == NULL) {
+        cache->lruHead = NULL;
+    }
+    else {
+        cache->lruTail->lruNext = NULL;
     }
-    else if (ins >= TTY_PUSHW && ins <= TTY_PUSHW_MAX) {
-        tty_PUSHW(ctx, ins);
+
+    cache->numBytes -= node->size;
+    free(node);
+}
+
+// Copies the outline stored in zone1 into the cache. points is either zone1's
+// org or cur array, depending on which positions the cache holds.
+static void tty_outline_cache_insert(TTY_Outline_Cache* cache, TTY_Zone* zone1, TTY_V2* points, TTY_U32 glyphIdx) {
+    size_t size = 
+        sizeof(TTY_Outline_Cache_Node)              + 
+        zone1->numPoints    * sizeof(TTY_V2)        + 
+        zone1->numEndPoints * sizeof(TTY_U16)       + 
+        zone1->numPoints    * sizeof(TTY_U8);
+
+    if (size > cache->maxBytes) {
+        return;
     }
-    else if (ins >= TTY_ROUND && ins <= TTY_ROUND_MAX) {
-        tty_ROUND(ctx, ins);
+
+    while (cache->numBytes + size > cache->maxBytes) {
+        tty_outline_cache_evict_lru_node(cache);
     }
-    else if (ins >= TTY_SFVTCA && ins <= TTY_SFVTCA_MAX) {
-        tty_SFVTCA(ctx, ins);
+
+    TTY_Outline_Cache_Node* node = (TTY_Outline_Cache_Node*)malloc(size);
+    if (node == NULL) {
+        // The cache is optional, so failing to add to it isn't an error
+        return;
     }
-    else if (ins >= TTY_SPVTCA && ins <= TTY_SPVTCA_MAX) {
-        tty_SPVTCA(ctx, ins);
+
+    node->glyphIdx         = glyphIdx;
+    node->size             = size;
+    node->numOutlinePoints = zone1->numOutlinePoints;
+    node->numEndPoints     = zone1->numEndPoints;
+    node->points           = (TTY_V2*) (node + 1);
+    node->endPointIndices  = (TTY_U16*)(node->points + zone1->numPoints);
+    node->pointTypes       = (TTY_U8*) (node->endPointIndices + zone1->numEndPoints);
+
+    memcpy(node->points,          points,                 zone1->numPoints    * sizeof(TTY_V2));
+    memcpy(node->endPointIndices, zone1->endPointIndices, zone1->numEndPoints * sizeof(TTY_U16));
+    memcpy(node->pointTypes,      zone1->pointTypes,      zone1->numPoints    * sizeof(TTY_U8));
+
+    {
+        TTY_Outline_Cache_Node** chainHead = cache->chainHeads + (TTY_HASH(glyphIdx) % cache->numChains);
+        node->next = *chainHead;
+        *chainHead = node;
     }
-    else if (ins >= TTY_SVTCA && ins <= TTY_SVTCA_MAX) {
-        tty_SVTCA(ctx, ins);
+
+    node->lruPrev = NULL;
+    node->lruNext = cache->lruHead;
+    if (cache->lruHead == NULL) {
+        cache->lruTail = node;
     }
     else {
-        return TTY_FALSE;
+        cache->lruHead->lruPrev = node;
     }
+    cache->lruHead = node;
 
-    return TTY_TRUE;
+    cache->numBytes += size;
+}
+
+// The reverse of tty_outline_cache_insert
+static void tty_outline_cache_node_to_zone1(TTY_Outline_Cache_Node* node, TTY_Zone* zone1, TTY_V2* points) {
+    zone1->numOutlinePoints = node->numOutlinePoints;
+    zone1->numPoints        = node->numOutlinePoints + TTY_NUM_PHANTOM_POINTS;
+    zone1->numEndPoints     = node->numEndPoints;
+    memcpy(points,                 node->points,          zone1->numPoints    * sizeof(TTY_V2));
+    memcpy(zone1->endPointIndices, node->endPointIndices, zone1->numEndPoints * sizeof(TTY_U16));
+    memcpy(zone1->pointTypes,      node->pointTypes,      zone1->numPoints    * sizeof(TTY_U8));
 }
 
 
 /* ------------ */
 /* Font Loading */
 /* ------------ */
-static void tty_execute_next_font_program_ins(TTY_Program_Context* ctx) {
-    TTY_U8 ins = tty_ins_stream_next(&ctx->stream);
+static TTY_Error tty_execute_font_program(TTY_Font* font) {
+    TTY_Program_Context ctx;
+    ctx.font                    = font;
+    ctx.instance                = NULL;
+    ctx.glyph                   = NULL;
+    ctx.render                  = &font->renderCtx;
+    ctx.cvt                     = NULL;
+    ctx.storage                 = NULL;
+    ctx.zone0                   = NULL;
+    ctx.iupState                = TTY_IUP_STATE_DEFAULT;
+    ctx.foundUnknownIns         = TTY_FALSE;
+    TTY_PROFILE_INIT_CTX(ctx);
+
+    TTY_LOG_PROGRAM("Font Program");
+
+    font->isFontProgramPending = TTY_FALSE;
 
-    switch (ins) {
-        case TTY_FDEF:
-            tty_FDEF(ctx);
-            return;
-        // case 0x89:
-        //     tty_IDEF(ctx);
-        //     return;
-        case TTY_NPUSHB:
-            tty_NPUSHB(ctx);
-            return;
-        case TTY_NPUSHW:
-            tty_NPUSHW(ctx);
-            return;
+    {
+        TTY_Error error;
+        TTY_PROFILE_START(timer);
+        error = tty_execute_program(&ctx, &font->hint.fontProgram, TTY_OP_FDEF, TTY_OP_PUSH);
+        TTY_PROFILE_LAP(timer, font->stats.fontProgramNs);
+        TTY_PROFILE_ADD(font->stats.fontProgramInsCount, ctx.numInsExecuted);
+
+        // Nothing reads the values that the font program leaves on the stack
+        // since every other program starts with an empty stack
+        tty_interp_stack_clear(&font->renderCtx.stack);
+        return error;
     }
+}
 
-    if (ins >= TTY_PUSHB && ins <= TTY_PUSHB_MAX) {
-        tty_PUSHB(ctx, ins);
+// Identifies everything that the results of the font program and the control
+// value program depend on. The table directory checksums are trusted for the
+// larger tables, while the hinting tables themselves are hashed directly.
+static TTY_U64 tty_calc_font_checksum(TTY_Font* font) {
+    TTY_U64 hash      = 0xCBF29CE484222325ull;
+    TTY_U16 numTables = tty_get_u16(font->fileData + font->faceOff + 4);
+    hash = tty_hash_bytes(hash, font->fileData + font->faceOff, 12 + 16 * numTables);
+    hash = tty_hash_bytes(hash, font->fileData + font->head.off + 8, 4); // checkSumAdjustment
+    hash = tty_hash_bytes(hash, font->fileData + font->maxp.off, font->maxp.size);
+    hash = tty_hash_bytes(hash, font->fileData + font->cvt.off, font->cvt.size);
+    hash = tty_hash_bytes(hash, font->fileData + font->fpgm.off, font->fpgm.size);
+    hash = tty_hash_bytes(hash, font->fileData + font->prep.off, font->prep.size);
+    return hash;
+}
+
+static TTY_U32 tty_read_glyf_offset(TTY_Font* font, TTY_U32 glyphIdx) {
+    if (font->locaFormat == 0) {
+        return tty_get_u16(font->fileData + font->loca.off + 2 * glyphIdx) * 2;
     }
-    else if (ins >= TTY_PUSHW && ins <= TTY_PUSHW_MAX) {
-        tty_PUSHW(ctx, ins);
+    return tty_get_u32(font->fileData + font->loca.off + 4 * glyphIdx);
+}
+
+static TTY_U16 tty_read_glyph_advance_width(TTY_Font* font, TTY_U32 glyphIdx) {
+    if (font->numHMetrics == 0) {
+        TTY_ASSERT(0);
+        return 0;
     }
-    else {
-        TTY_LOG_UNKNOWN_INS(ins);
-        ctx->foundUnknownIns = TTY_TRUE;
+    if (glyphIdx >= font->numHMetrics) {
+        // "As an optimization, the number of records can be less than the 
+        // number of glyphs, in which case the advance width value of the 
+        // last record applies to all remaining glyph IDs."
+        glyphIdx = font->numHMetrics - 1;
     }
+    return tty_get_u16(font->fileData + font->hmtx.off + 4 * glyphIdx);
 }
 
-TTY_Error tty_font_init(TTY_Font* font, const char* path) {
-    memset(font, 0, sizeof(TTY_Font));
+static TTY_S16 tty_read_glyph_left_side_bearing(TTY_Font* font, TTY_U32 glyphIdx) {
+    TTY_U8* hmtxData = font->fileData + font->hmtx.off;
+    if (glyphIdx < font->numHMetrics) {
+        return tty_get_s16(hmtxData + 4 * glyphIdx + 2);
+    }
+    return tty_get_s16(hmtxData + 4 * font->numHMetrics + 2 * (glyphIdx - font->numHMetrics));
+}
+
+static TTY_U16 tty_read_glyph_advance_height(TTY_Font* font, TTY_U32 glyphIdx) {
+    if (font->numVMetrics == 0) {
+        TTY_ASSERT(0);
+        return 0;
+    }
+    if (glyphIdx >= font->numVMetrics) {
+        // Same as hmtx, the last record applies to all remaining glyphs
+        glyphIdx = font->numVMetrics - 1;
+    }
+    return tty_get_u16(font->fileData + font->vmtx.off + 4 * glyphIdx);
+}
 
+static TTY_S16 tty_read_glyph_top_side_bearing(TTY_Font* font, TTY_U32 glyphIdx) {
+    TTY_U8* vmtxData = font->fileData + font->vmtx.off;
+    if (glyphIdx < font->numVMetrics) {
+        return tty_get_s16(vmtxData + 4 * glyphIdx + 2);
+    }
+    return tty_get_s16(vmtxData + 4 * font->numVMetrics + 2 * (glyphIdx - font->numVMetrics));
+}
 
-    {
-        // Open the font file
-        FILE* f = fopen(path, "rb");
-        if (f == NULL) {
-            return TTY_ERROR_FAILED_TO_READ_FILE;
+static void tty_free_file_data(TTY_U8* data, TTY_S32 size, TTY_U8 owner) {
+    switch (owner) {
+        case TTY_FILE_DATA_ALLOCATED:
+            free(data);
+            break;
+        case TTY_FILE_DATA_MAPPED:
+            tty_unmap_file(data, size);
+            break;
+        case TTY_FILE_DATA_USER:
+            // The caller owns the memory
+            break;
+    }
+}
+
+static void tty_font_free_file_data(TTY_Font* font) {
+    tty_free_file_data(font->fileData, font->fileSize, font->fileDataOwner);
+    font->fileData = NULL;
+}
+
+static TTY_U32 tty_get_glyph_index_uncached(TTY_Font* font, TTY_U32 codePoint);
+
+static TTY_U32 tty_get_glyph_index_format_12(TTY_U8* subtable, TTY_U32 cp);
+
+static TTY_Error tty_build_composite_table(TTY_Font* font);
+
+static TTY_Error tty_build_complexity_table(TTY_Font* font);
+
+static TTY_Error tty_render_context_alloc(TTY_Font* font, TTY_Render_Context* ctx, size_t* size);
+
+static TTY_Error tty_build_cmap_pages(TTY_Font* font) {
+    TTY_U8* subtable  = font->fileData + font->cmap.off + font->encoding.off;
+    TTY_U32 numGroups = tty_get_u32(subtable + 12);
+    TTY_U32 numPages  = 1; // Page 0 is kept empty for unmapped code points
+    TTY_U8  isMapped[TTY_CMAP_NUM_PAGES] = {0};
+
+    // Find which pages contain at least one mapped code point
+    for (TTY_U32 i = 0; i < numGroups; i++) {
+        TTY_U8* group   = subtable + 16 + i * 12;
+        TTY_U32 cpStart = tty_get_u32(group);
+        TTY_U32 cpEnd   = TTY_MIN(tty_get_u32(group + 4), TTY_CMAP_NUM_PAGES * TTY_CMAP_PAGE_SIZE - 1);
+
+        for (TTY_U32 page = cpStart / TTY_CMAP_PAGE_SIZE; cpStart <= cpEnd && page <= cpEnd / TTY_CMAP_PAGE_SIZE; page++) {
+            if (!isMapped[page]) {
+                isMapped[page] = 1;
+                numPages++;
+            }
         }
+    }
 
-        // Calculate the size of the file
-        if (fseek(f, 0, SEEK_END)       != 0  ||
-            (font->fileSize = ftell(f)) <  0  ||
-            fseek(f, 0, SEEK_SET)       != 0)
-        {
-            fclose(f);
-            return TTY_ERROR_FAILED_TO_READ_FILE;
+    font->cmapPageDir = (TTY_U16*)calloc(TTY_CMAP_NUM_PAGES + numPages * TTY_CMAP_PAGE_SIZE, sizeof(TTY_U16));
+    if (font->cmapPageDir == NULL) {
+        return TTY_ERROR_OUT_OF_MEMORY;
+    }
+    font->cmapPages = font->cmapPageDir + TTY_CMAP_NUM_PAGES;
+    TTY_PROFILE_ADD(font->stats.bytesAllocated, (TTY_CMAP_NUM_PAGES + numPages * TTY_CMAP_PAGE_SIZE) * sizeof(TTY_U16));
+
+    for (TTY_U32 page = 0, nextPage = 1; page < TTY_CMAP_NUM_PAGES; page++) {
+        if (isMapped[page]) {
+            font->cmapPageDir[page] = nextPage++;
         }
+    }
 
-        // Allocate a buffer that will store the contents of the file
-        font->fileData = calloc(font->fileSize, 1);
-        if (font->fileData == NULL) {
-            fclose(f);
-            return TTY_ERROR_OUT_OF_MEMORY;
+    // Groups should not overlap, but malformed fonts can have overlapping
+    // groups. The pages are filled using the same search as uncached lookups
+    // so that both agree on which group a code point maps to.
+    for (TTY_U32 page = 0; page < TTY_CMAP_NUM_PAGES; page++) {
+        if (!isMapped[page]) {
+            continue;
         }
 
-        // Read the file contents into the buffer
-        if ((TTY_S32)fread(font->fileData, 1, font->fileSize, f) != font->fileSize) {
-            fclose(f);
-            free(font->fileData);
-            font->fileData = NULL;
-            return TTY_ERROR_FAILED_TO_READ_FILE;
+        TTY_U16* glyphIndices = font->cmapPages + font->cmapPageDir[page] * TTY_CMAP_PAGE_SIZE;
+
+        for (TTY_U32 i = 0; i < TTY_CMAP_PAGE_SIZE; i++) {
+            glyphIndices[i] = tty_get_glyph_index_format_12(subtable, page * TTY_CMAP_PAGE_SIZE + i);
         }
-        fclose(f);
+    }
+
+    return TTY_ERROR_NONE;
+}
+
+// Checks that the first `size` bytes of the table are within the table and
+// the file
+static TTY_Bool tty_table_covers(TTY_Font* font, TTY_Table* table, TTY_U64 size) {
+    return size <= table->size && table->off + size <= (TTY_U64)font->fileSize;
+}
+
+// Checks that the hdmx records are within the table and that each one has a
+// width for every glyph
+static TTY_Bool tty_hdmx_is_valid(TTY_Font* font) {
+    if (!tty_table_covers(font, &font->hdmx, 8)) {
+        return TTY_FALSE;
+    }
+
+    TTY_U8* hdmx       = font->fileData + font->hdmx.off;
+    TTY_S16 numRecords = tty_get_s16(hdmx + 2);
+    TTY_U32 recordSize = tty_get_u32(hdmx + 4);
+
+    return numRecords >= 0 &&
+           recordSize >= font->numGlyphs + 2u &&
+           tty_table_covers(font, &font->hdmx, 8 + (TTY_U64)numRecords * recordSize);
+}
+
+// Checks that the VDMX ratios, group offsets, and groups are within the table
+static TTY_Bool tty_vdmx_is_valid(TTY_Font* font) {
+    if (!tty_table_covers(font, &font->VDMX, 6)) {
+        return TTY_FALSE;
+    }
+
+    TTY_U8* vdmx      = font->fileData + font->VDMX.off;
+    TTY_U16 numRatios = tty_get_u16(vdmx + 4);
+
+    // Each ratio has a 4 byte record and a 2 byte group offset
+    if (!tty_table_covers(font, &font->VDMX, 6 + 6 * (TTY_U64)numRatios)) {
+        return TTY_FALSE;
+    }
+
+    for (TTY_U32 i = 0; i < numRatios; i++) {
+        TTY_U16 groupOff = tty_get_u16(vdmx + 6 + 4 * numRatios + 2 * i);
+        if (!tty_table_covers(font, &font->VDMX, groupOff + 4)) {
+            return TTY_FALSE;
+        }
+
+        TTY_U16 numRecs = tty_get_u16(vdmx + groupOff);
+        if (!tty_table_covers(font, &font->VDMX, groupOff + 4 + 6 * (TTY_U64)numRecs)) {
+            return TTY_FALSE;
+        }
+    }
+
+    return TTY_TRUE;
+}
+
+static TTY_Error tty_font_init_impl(TTY_Font* font, TTY_U32 faceIdx, TTY_U32 flags) {
+    TTY_PROFILE_START(timer);
+
+    // If the file is a font collection, locate the offset table of the
+    // requested face. The table offsets within a face's table directory are
+    // relative to the start of the file, so faces can share tables.
+    if (font->fileSize >= 12 && TTY_TAG_EQUALS(font->fileData, "ttcf")) {
+        TTY_U32 numFaces = tty_get_u32(font->fileData + 8);
+        
+        if (faceIdx >= numFaces || 12 + 4 * (TTY_U64)numFaces > (TTY_U64)font->fileSize) {
+            tty_font_free_file_data(font);
+            return TTY_ERROR_FILE_IS_CORRUPTED;
+        }
+
+        font->faceOff = tty_get_u32(font->fileData + 12 + 4 * faceIdx);
+        
+        if (font->faceOff > (TTY_U32)font->fileSize - 12) {
+            tty_font_free_file_data(font);
+            return TTY_ERROR_FILE_IS_CORRUPTED;
+        }
+    }
+    else if (faceIdx != 0 || font->fileSize < 12) {
+        tty_font_free_file_data(font);
+        return TTY_ERROR_FILE_IS_CORRUPTED;
     }
 
 
     // Verify that the file contains a TTF file signature
     {
-        TTY_U32 sfntVersion = tty_get_u32(font->fileData);
+        TTY_U32 sfntVersion = tty_get_u32(font->fileData + font->faceOff);
     
         if (sfntVersion != 0x00010000             &&
             !TTY_TAG_EQUALS(&sfntVersion, "true") &&
             !TTY_TAG_EQUALS(&sfntVersion, "typ1"))
         {
-            free(font->fileData);
-            font->fileData = NULL;
+            tty_font_free_file_data(font);
             return TTY_ERROR_FILE_IS_NOT_TTF;   
         }
     }
@@ -2562,25 +3891,48 @@ TTY_Error tty_font_init(TTY_Font* font, const char* path) {
 
     // Extract table directory
     {
-        TTY_U16 numTables = tty_get_u16(font->fileData + 4);
+        TTY_U16 numTables = tty_get_u16(font->fileData + font->faceOff + 4);
+
+        if (font->faceOff + 12 + 16 * (TTY_U64)numTables > (TTY_U64)font->fileSize) {
+            tty_font_free_file_data(font);
+            return TTY_ERROR_FILE_IS_CORRUPTED;
+        }
 
         for (TTY_U32 i = 0; i < numTables; i++) {
-            TTY_U32    off = 12 + 16 * i;
+            TTY_U32    off = font->faceOff + 12 + 16 * i;
             TTY_U8*    tag = font->fileData + off;
             TTY_Table* table;
             
-            if (!font->cmap.exists && TTY_TAG_EQUALS(tag, "cmap")) {
+            if (!font->CBDT.exists && TTY_TAG_EQUALS(tag, "CBDT")) {
+                table = &font->CBDT;
+            }
+            else if (!font->CBLC.exists && TTY_TAG_EQUALS(tag, "CBLC")) {
+                table = &font->CBLC;
+            }
+            else if (!font->cmap.exists && TTY_TAG_EQUALS(tag, "cmap")) {
                 table = &font->cmap;
             }
             else if (!font->cvt.exists && TTY_TAG_EQUALS(tag, "cvt ")) {
                 table = &font->cvt;
             }
+            else if (!font->EBDT.exists && TTY_TAG_EQUALS(tag, "EBDT")) {
+                table = &font->EBDT;
+            }
+            else if (!font->EBLC.exists && TTY_TAG_EQUALS(tag, "EBLC")) {
+                table = &font->EBLC;
+            }
             else if (!font->fpgm.exists && TTY_TAG_EQUALS(tag, "fpgm")) {
                 table = &font->fpgm;
             }
+            else if (!font->gasp.exists && TTY_TAG_EQUALS(tag, "gasp")) {
+                table = &font->gasp;
+            }
             else if (!font->glyf.exists && TTY_TAG_EQUALS(tag, "glyf")) {
                 table = &font->glyf;
             }
+            else if (!font->hdmx.exists && TTY_TAG_EQUALS(tag, "hdmx")) {
+                table = &font->hdmx;
+            }
             else if (!font->head.exists && TTY_TAG_EQUALS(tag, "head")) {
                 table = &font->head;
             }
@@ -2593,6 +3945,9 @@ TTY_Error tty_font_init(TTY_Font* font, const char* path) {
             else if (!font->loca.exists && TTY_TAG_EQUALS(tag, "loca")) {
                 table = &font->loca;
             }
+            else if (!font->LTSH.exists && TTY_TAG_EQUALS(tag, "LTSH")) {
+                table = &font->LTSH;
+            }
             else if (!font->maxp.exists && TTY_TAG_EQUALS(tag, "maxp")) {
                 table = &font->maxp;
             }
@@ -2602,6 +3957,12 @@ TTY_Error tty_font_init(TTY_Font* font, const char* path) {
             else if (!font->prep.exists && TTY_TAG_EQUALS(tag, "prep")) {
                 table = &font->prep;
             }
+            else if (!font->VDMX.exists && TTY_TAG_EQUALS(tag, "VDMX")) {
+                table = &font->VDMX;
+            }
+            else if (!font->vhea.exists && TTY_TAG_EQUALS(tag, "vhea")) {
+                table = &font->vhea;
+            }
             else if (!font->vmtx.exists && TTY_TAG_EQUALS(tag, "vmtx")) {
                 table = &font->vmtx;
             }
@@ -2612,7 +3973,10 @@ TTY_Error tty_font_init(TTY_Font* font, const char* path) {
             if (table != NULL) {
                 table->off    = tty_get_u32(font->fileData + off + 8);
                 table->size   = tty_get_u32(font->fileData + off + 12);
-                table->exists = TTY_TRUE;
+
+                // A table that extends past the end of the file is ignored,
+                // so the file is corrupted if the table is required
+                table->exists = (TTY_U64)table->off + table->size <= (TTY_U64)font->fileSize;
             }
         }
         
@@ -2624,12 +3988,29 @@ TTY_Error tty_font_init(TTY_Font* font, const char* path) {
             !font->loca.exists ||
             !font->maxp.exists)
         {
-            free(font->fileData);
-            font->fileData = NULL;
+            tty_font_free_file_data(font);
             return TTY_ERROR_FILE_IS_CORRUPTED;
         }
+
+        if (!font->vhea.exists) {
+            // The number of vmtx records is stored in vhea
+            font->vmtx.exists = TTY_FALSE;
+        }
+
+        if (!font->EBLC.exists || !font->EBDT.exists) {
+            // Bitmap strikes need both their location and data tables
+            font->EBLC.exists = TTY_FALSE;
+            font->EBDT.exists = TTY_FALSE;
+        }
+
+        if (!font->CBLC.exists || !font->CBDT.exists) {
+            font->CBLC.exists = TTY_FALSE;
+            font->CBDT.exists = TTY_FALSE;
+        }
     }
 
+    TTY_PROFILE_LAP(timer, font->stats.tableDirectoryNs);
+
 
     // Extract character encoding
     {
@@ -2682,14 +4063,14 @@ TTY_Error tty_font_init(TTY_Font* font, const char* path) {
         
         if (font->encoding.format == 0) {
             // A valid encoding was not found
-            free(font->fileData);
-            font->fileData = NULL;
+            tty_font_free_file_data(font);
             return TTY_ERROR_UNSUPPORTED_FEATURE;
         }
     }
 
+    TTY_PROFILE_LAP(timer, font->stats.cmapNs);
+
 
-    font->startingEdgeCap = 100;
     font->upem            = tty_get_u16(font->fileData + font->head.off + 18);
     font->numGlyphs       = tty_get_u16(font->fileData + font->maxp.off + 4);
     font->ascender        = tty_get_s16(font->fileData + font->hhea.off + 4);
@@ -2697,85 +4078,234 @@ TTY_Error tty_font_init(TTY_Font* font, const char* path) {
     font->lineGap         = tty_get_s16(font->fileData + font->hhea.off + 8);
     font->maxHoriExtent   = tty_get_s16(font->fileData + font->hhea.off + 16);
     font->hasHinting      = font->cvt.exists && font->fpgm.exists && font->prep.exists;
+    font->locaFormat      = tty_get_s16(font->fileData + font->head.off + 50);
+    font->numHMetrics     = tty_get_u16(font->fileData + font->hhea.off + 34);
 
+    if (font->vmtx.exists) {
+        font->numVMetrics = tty_get_u16(font->fileData + font->vhea.off + 34);
+    }
 
-    // Allocate hinting data
-    // Note: Even if the font doesn't have hinting, glyph points are still 
-    //       stored in zone 1
-    {
-        if (font->hasHinting) {
-            font->hint.stack.cap = tty_get_u16(font->fileData + font->maxp.off + 24);
-            font->hint.funcs.cap = tty_get_u16(font->fileData + font->maxp.off + 20);
-        }
-        
-        {
-            TTY_U16 maxContours           = tty_get_u16(font->fileData + font->maxp.off + 8);
-            TTY_U16 maxCompositeContours  = tty_get_u16(font->fileData + font->maxp.off + 12);
-            font->hint.zone1.maxEndPoints = TTY_MAX(maxContours, maxCompositeContours);
-        }
-        
-        {
-            // Note: Not sure if maxPoints or maxCompositePoints includes phantom points,
-            //       so will add them just to be safe
-            TTY_U16 maxPoints          = tty_get_u16(font->fileData + font->maxp.off + 6);
-            TTY_U16 maxCompositePoints = tty_get_u16(font->fileData + font->maxp.off + 10);
-            font->hint.zone1.maxPoints = TTY_MAX(maxPoints, maxCompositePoints) + TTY_NUM_PHANTOM_POINTS;
-            font->hint.curves.cap      = maxCompositePoints; // The number of curves a glyph has is <= the number of points it has
+    if (font->OS2.exists) {
+        font->typoAscender  = tty_get_s16(font->fileData + font->OS2.off + 68);
+        font->typoDescender = tty_get_s16(font->fileData + font->OS2.off + 70);
+    }
+    else {
+        font->typoAscender  = font->ascender;
+        font->typoDescender = font->descender;
+    }
+
+    // Optional tables whose records don't fit in the table are ignored, so
+    // their records can be read later without bounds checks
+    if (font->hdmx.exists && !tty_hdmx_is_valid(font)) {
+        font->hdmx.exists = TTY_FALSE;
+    }
+
+    if (font->VDMX.exists && !tty_vdmx_is_valid(font)) {
+        font->VDMX.exists = TTY_FALSE;
+    }
+
+    if (font->LTSH.exists &&
+        (!tty_table_covers(font, &font->LTSH, 4 + (TTY_U64)font->numGlyphs) ||
+         tty_get_u16(font->fileData + font->LTSH.off + 2) != font->numGlyphs))
+    {
+        // LTSH has an entry for every glyph, ignore it if it doesn't cover numGlyphs
+        font->LTSH.exists = TTY_FALSE;
+    }
+
+    if (font->gasp.exists &&
+        (!tty_table_covers(font, &font->gasp, 4) ||
+         !tty_table_covers(font, &font->gasp, 4 + 4 * (TTY_U64)tty_get_u16(font->fileData + font->gasp.off + 2))))
+    {
+        font->gasp.exists = TTY_FALSE;
+    }
+
+
+    // Allocate hinting data
+    {
+        TTY_U32 numFontProgramOps    = 0;
+        TTY_U32 numFontProgramValues = 0;
+        TTY_U32 numCVProgramOps      = 0;
+        TTY_U32 numCVProgramValues   = 0;
+        TTY_U32 numFontProgramBytes  = 0; /* Includes the offset following the last instruction */
+        TTY_U32 numCVProgramBytes    = 0;
+
+        if (font->hasHinting) {
+            font->hint.funcs.cap = tty_get_u16(font->fileData + font->maxp.off + 20);
+
+            // The font and CV programs are decoded once here rather than every
+            // time they (or the functions they define) are executed
+            tty_decode_program(font->fileData + font->fpgm.off, font->fpgm.size, NULL, NULL, &numFontProgramOps, &numFontProgramValues);
+            tty_decode_program(font->fileData + font->prep.off, font->prep.size, NULL, NULL, &numCVProgramOps,   &numCVProgramValues);
+            numFontProgramBytes = font->fpgm.size + 1;
+            numCVProgramBytes   = font->prep.size + 1;
         }
 
         size_t off                   = 0;
         size_t totalSize             = 0;
-        size_t curvesSize            = tty_calc_mem_size(&totalSize, font->hint.curves.cap         * sizeof(TTY_Curve), TTY_ALIGN_OF(TTY_U8*));
-        size_t funcInsPtrsSize       = tty_calc_mem_size(&totalSize, font->hint.funcs.cap          * sizeof(TTY_U8*)  , TTY_ALIGN_OF(TTY_U32));
-        size_t funcSizesSize         = tty_calc_mem_size(&totalSize, font->hint.funcs.cap          * sizeof(TTY_U32)  , 1);
-        size_t stackSize             = tty_calc_mem_size(&totalSize, font->hint.stack.cap          * sizeof(TTY_U32)  , TTY_ALIGN_OF(TTY_V2));
-        size_t z1OrgSize             = tty_calc_mem_size(&totalSize, font->hint.zone1.maxPoints    * sizeof(TTY_V2)   , 1);
-        size_t z1OrgScaledSize       = tty_calc_mem_size(&totalSize, z1OrgSize                                        , 1);
-        size_t z1CurSize             = tty_calc_mem_size(&totalSize, z1OrgSize                                        , TTY_ALIGN_OF(TTY_U16));
-        size_t z1EndPointIndicesSize = tty_calc_mem_size(&totalSize, font->hint.zone1.maxEndPoints * sizeof(TTY_U16)  , 1);
-        size_t z1TouchTypesSize      = tty_calc_mem_size(&totalSize, font->hint.zone1.maxPoints    * sizeof(TTY_U8)   , 1);
-        /* size_t z1PointTypesSize = */tty_calc_mem_size(&totalSize, font->hint.zone1.maxPoints    * sizeof(TTY_U8)   , 1);
+        size_t funcBodiesSize        = tty_calc_mem_size(&totalSize, font->hint.funcs.cap          * sizeof(TTY_Program), TTY_ALIGN_OF(TTY_Op));
+        size_t fpgmOpsSize           = tty_calc_mem_size(&totalSize, numFontProgramOps             * sizeof(TTY_Op)     , TTY_ALIGN_OF(TTY_S32));
+        size_t fpgmValuesSize        = tty_calc_mem_size(&totalSize, numFontProgramValues          * sizeof(TTY_S32)    , TTY_ALIGN_OF(TTY_U32));
+        size_t fpgmBranchOffsSize    = tty_calc_mem_size(&totalSize, numFontProgramOps             * sizeof(TTY_U32)    , 1);
+        size_t fpgmOpIdxsSize        = tty_calc_mem_size(&totalSize, numFontProgramBytes           * sizeof(TTY_U32)    , TTY_ALIGN_OF(TTY_Op));
+        size_t prepOpsSize           = tty_calc_mem_size(&totalSize, numCVProgramOps               * sizeof(TTY_Op)     , TTY_ALIGN_OF(TTY_S32));
+        size_t prepValuesSize        = tty_calc_mem_size(&totalSize, numCVProgramValues            * sizeof(TTY_S32)    , TTY_ALIGN_OF(TTY_U32));
+        size_t prepBranchOffsSize    = tty_calc_mem_size(&totalSize, numCVProgramOps               * sizeof(TTY_U32)    , 1);
+        /* size_t prepOpIdxsSize = */  tty_calc_mem_size(&totalSize, numCVProgramBytes             * sizeof(TTY_U32)    , 1);
         
-        font->hint.mem = (TTY_U8*)calloc(totalSize, 1);
+        font->hint.mem = (TTY_U8*)calloc(TTY_MAX(totalSize, 1), 1);
         if (font->hint.mem == NULL) {
-            free(font->fileData);
-            font->fileData = NULL;
+            tty_font_free_file_data(font);
             return TTY_ERROR_OUT_OF_MEMORY;
         }
         
-        font->hint.curves.buff           = (TTY_Curve*)(font->hint.mem);
-        font->hint.funcs.insPtrs         = (TTY_U8**)  (font->hint.mem + (off += curvesSize));
-        font->hint.funcs.sizes           = (TTY_U32*)  (font->hint.mem + (off += funcInsPtrsSize));
-        font->hint.stack.buff            = (TTY_U32*)  (font->hint.mem + (off += funcSizesSize));
-        font->hint.zone1.org             = (TTY_V2*)   (font->hint.mem + (off += stackSize));
-        font->hint.zone1.orgScaled       = (TTY_V2*)   (font->hint.mem + (off += z1OrgSize));
-        font->hint.zone1.cur             = (TTY_V2*)   (font->hint.mem + (off += z1OrgScaledSize));
-        font->hint.zone1.endPointIndices = (TTY_U16*)  (font->hint.mem + (off += z1CurSize));
-        font->hint.zone1.touchFlags      = (TTY_U8*)   (font->hint.mem + (off += z1EndPointIndicesSize));
-        font->hint.zone1.pointTypes      = (TTY_U8*)   (font->hint.mem + (off += z1TouchTypesSize));
+        font->hint.funcs.bodies          = (TTY_Program*)(font->hint.mem);
+        font->hint.fontProgram.ops       = (TTY_Op*)   (font->hint.mem + (off += funcBodiesSize));
+        font->hint.fontProgram.values    = (TTY_S32*)  (font->hint.mem + (off += fpgmOpsSize));
+        font->hint.fontProgram.branchOffs= (TTY_U32*)  (font->hint.mem + (off += fpgmValuesSize));
+        font->hint.fontProgram.opIdxs    = (TTY_U32*)  (font->hint.mem + (off += fpgmBranchOffsSize));
+        font->hint.cvProgram.ops         = (TTY_Op*)   (font->hint.mem + (off += fpgmOpIdxsSize));
+        font->hint.cvProgram.values      = (TTY_S32*)  (font->hint.mem + (off += prepOpsSize));
+        font->hint.cvProgram.branchOffs  = (TTY_U32*)  (font->hint.mem + (off += prepValuesSize));
+        font->hint.cvProgram.opIdxs      = (TTY_U32*)  (font->hint.mem + (off += prepBranchOffsSize));
+
+        if (font->hasHinting) {
+            TTY_Program* fpgm = &font->hint.fontProgram;
+            TTY_Program* prep = &font->hint.cvProgram;
+            tty_program_init(fpgm, font->fileData + font->fpgm.off, font->fpgm.size, fpgm->ops, fpgm->values, fpgm->branchOffs, fpgm->opIdxs);
+            tty_program_init(prep, font->fileData + font->prep.off, font->prep.size, prep->ops, prep->values, prep->branchOffs, prep->opIdxs);
+        }
+
+        TTY_PROFILE_ADD(font->stats.bytesAllocated, totalSize);
     }
 
+    // Allocate the font's own render context
+    // Note: Even if the font doesn't have hinting, glyph points are still 
+    //       stored in zone 1
+    {
+        size_t size;
+        if (tty_render_context_alloc(font, &font->renderCtx, &size) != TTY_ERROR_NONE) {
+            tty_font_free(font);
+            return TTY_ERROR_OUT_OF_MEMORY;
+        }
+        TTY_PROFILE_ADD(font->stats.bytesAllocated, size);
+    }
 
-    // Execute the font program if the font has hinting
-    if (font->hasHinting) {
-        TTY_Error           error;
-        TTY_Program_Context ctx;
-        ctx.font                    = font;
-        ctx.instance                = NULL;
-        ctx.glyph                   = NULL;
-        ctx.iupState                = TTY_IUP_STATE_DEFAULT;
-        ctx.foundUnknownIns         = TTY_FALSE;
-        ctx.stream.execute_next_ins = tty_execute_next_font_program_ins;
-        ctx.stream.buff             = font->fileData + font->fpgm.off;
-        ctx.stream.cap              = font->fpgm.size;
-        ctx.stream.off              = 0;
+    TTY_PROFILE_LAP(timer, font->stats.hintAllocNs);
 
-        TTY_LOG_PROGRAM("Font Program");
-        
-        error = tty_execute_program(&ctx);
-        if (error != TTY_ERROR_NONE) {
+
+    // Decode the loca table into native offsets so that finding a glyph's
+    // glyf block doesn't require any big-endian reads
+    if (flags & TTY_FONT_CACHE_LOCA) {
+        font->glyfOffsets = (TTY_U32*)malloc(font->numGlyphs * sizeof(TTY_U32));
+        if (font->glyfOffsets == NULL) {
             tty_font_free(font);
-            return error;
+            return TTY_ERROR_OUT_OF_MEMORY;
+        }
+
+        for (TTY_U32 i = 0; i < font->numGlyphs; i++) {
+            font->glyfOffsets[i] = tty_read_glyf_offset(font, i);
+        }
+
+        TTY_PROFILE_ADD(font->stats.bytesAllocated, font->numGlyphs * sizeof(TTY_U32));
+    }
+
+
+    // Build a page table for the format 12 subtable so that looking up a code
+    // point doesn't require searching the groups
+    if ((flags & TTY_FONT_CACHE_CMAP) && font->encoding.format == 12) {
+        if (tty_build_cmap_pages(font) != TTY_ERROR_NONE) {
+            tty_font_free(font);
+            return TTY_ERROR_OUT_OF_MEMORY;
+        }
+    }
+
+
+    // Cache the glyph index of every BMP code point so that the common case
+    // is a single array access regardless of the cmap format
+    if (flags & TTY_FONT_CACHE_BMP) {
+        font->bmpGlyphIndices = (TTY_U16*)malloc(TTY_CMAP_BMP_SIZE * sizeof(TTY_U16));
+        if (font->bmpGlyphIndices == NULL) {
+            tty_font_free(font);
+            return TTY_ERROR_OUT_OF_MEMORY;
+        }
+
+        for (TTY_U32 cp = 0; cp < TTY_CMAP_BMP_SIZE; cp++) {
+            font->bmpGlyphIndices[cp] = tty_get_glyph_index_uncached(font, cp);
+        }
+
+        TTY_PROFILE_ADD(font->stats.bytesAllocated, TTY_CMAP_BMP_SIZE * sizeof(TTY_U16));
+    }
+
+
+    // Decode the horizontal metrics so that getting a glyph's advance width
+    // and left side bearing is a single load
+    if (flags & TTY_FONT_CACHE_HMTX) {
+        font->horMetrics = (TTY_Hor_Metric*)malloc(font->numGlyphs * sizeof(TTY_Hor_Metric));
+        if (font->horMetrics == NULL) {
+            tty_font_free(font);
+            return TTY_ERROR_OUT_OF_MEMORY;
+        }
+
+        for (TTY_U32 i = 0; i < font->numGlyphs; i++) {
+            font->horMetrics[i].advanceWidth    = tty_read_glyph_advance_width(font, i);
+            font->horMetrics[i].leftSideBearing = tty_read_glyph_left_side_bearing(font, i);
+        }
+
+        TTY_PROFILE_ADD(font->stats.bytesAllocated, font->numGlyphs * sizeof(TTY_Hor_Metric));
+    }
+
+
+    // Same as the horizontal metrics, but for vertical layout
+    if ((flags & TTY_FONT_CACHE_VMTX) && font->vmtx.exists) {
+        font->vertMetrics = (TTY_Vert_Metric*)malloc(font->numGlyphs * sizeof(TTY_Vert_Metric));
+        if (font->vertMetrics == NULL) {
+            tty_font_free(font);
+            return TTY_ERROR_OUT_OF_MEMORY;
+        }
+
+        for (TTY_U32 i = 0; i < font->numGlyphs; i++) {
+            font->vertMetrics[i].advanceHeight  = tty_read_glyph_advance_height(font, i);
+            font->vertMetrics[i].topSideBearing = tty_read_glyph_top_side_bearing(font, i);
+        }
+
+        TTY_PROFILE_ADD(font->stats.bytesAllocated, font->numGlyphs * sizeof(TTY_Vert_Metric));
+    }
+
+
+    // Parse the component records of the composite glyphs so that rendering a
+    // composite glyph doesn't require decoding its glyf block
+    if (flags & TTY_FONT_CACHE_COMPOSITES) {
+        if (tty_build_composite_table(font) != TTY_ERROR_NONE) {
+            tty_font_free(font);
+            return TTY_ERROR_OUT_OF_MEMORY;
+        }
+    }
+
+
+    // Measure every glyph so that renders can allocate their edges up front
+    if (flags & TTY_FONT_CACHE_COMPLEXITY) {
+        if (tty_build_complexity_table(font) != TTY_ERROR_NONE) {
+            tty_font_free(font);
+            return TTY_ERROR_OUT_OF_MEMORY;
+        }
+    }
+
+    TTY_PROFILE_LAP(timer, font->stats.tablesNs);
+
+
+    // Execute the font program if the font has hinting. If it is deferred, it
+    // is either restored from a snapshot or executed when the first hinted 
+    // instance is created.
+    if (font->hasHinting) {
+        if (flags & TTY_FONT_DEFER_FONT_PROGRAM) {
+            font->isFontProgramPending = TTY_TRUE;
+        }
+        else {
+            TTY_Error error = tty_execute_font_program(font);
+            if (error != TTY_ERROR_NONE) {
+                tty_font_free(font);
+                return error;
+            }
         }
     }
 
@@ -2783,18 +4313,366 @@ TTY_Error tty_font_init(TTY_Font* font, const char* path) {
     return TTY_ERROR_NONE;
 }
 
+TTY_Error tty_font_init(TTY_Font* font, const char* path) {
+    return tty_font_init_ex(font, path, TTY_FONT_DEFAULT);
+}
+
+TTY_Error tty_font_init_ex(TTY_Font* font, const char* path, TTY_U32 flags) {
+    memset(font, 0, sizeof(TTY_Font));
+
+    {
+        TTY_Error error;
+        TTY_PROFILE_START(timer);
+        if ((error = tty_read_file(path, &font->fileData, &font->fileSize))) {
+            return error;
+        }
+        TTY_PROFILE_LAP(timer, font->stats.fileNs);
+        TTY_PROFILE_ADD(font->stats.bytesAllocated, font->fileSize);
+    }
+
+    font->fileDataOwner = TTY_FILE_DATA_ALLOCATED;
+    return tty_font_init_impl(font, 0, flags);
+}
+
+TTY_Error tty_font_init_mmap(TTY_Font* font, const char* path) {
+    return tty_font_init_mmap_ex(font, path, TTY_FONT_DEFAULT);
+}
+
+TTY_Error tty_font_init_mmap_ex(TTY_Font* font, const char* path, TTY_U32 flags) {
+    memset(font, 0, sizeof(TTY_Font));
+
+    {
+        TTY_Error error;
+        TTY_PROFILE_START(timer);
+        if ((error = tty_map_file(path, &font->fileData, &font->fileSize))) {
+            return error;
+        }
+        TTY_PROFILE_LAP(timer, font->stats.fileNs);
+    }
+
+    font->fileDataOwner = TTY_FILE_DATA_MAPPED;
+    return tty_font_init_impl(font, 0, flags);
+}
+
+TTY_Error tty_font_init_from_memory(TTY_Font* font, const TTY_U8* data, TTY_S32 size) {
+    return tty_font_init_from_memory_ex(font, data, size, TTY_FONT_DEFAULT);
+}
+
+TTY_Error tty_font_init_from_memory_ex(TTY_Font* font, const TTY_U8* data, TTY_S32 size, TTY_U32 flags) {
+    memset(font, 0, sizeof(TTY_Font));
+
+    // The font data is only ever read, so the const qualifier can safely be
+    // discarded
+    font->fileData      = (TTY_U8*)data;
+    font->fileSize      = size;
+    font->fileDataOwner = TTY_FILE_DATA_USER;
+    return tty_font_init_impl(font, 0, flags);
+}
+
+TTY_Error tty_font_init_from_collection(TTY_Font* font, TTY_Collection* collection, TTY_U32 faceIdx) {
+    return tty_font_init_from_collection_ex(font, collection, faceIdx, TTY_FONT_DEFAULT);
+}
+
+TTY_Error tty_font_init_from_collection_ex(TTY_Font* font, TTY_Collection* collection, TTY_U32 faceIdx, TTY_U32 flags) {
+    memset(font, 0, sizeof(TTY_Font));
+
+    // The font borrows the collection's file data so that every face shares
+    // the same buffer or mapping
+    font->fileData      = collection->fileData;
+    font->fileSize      = collection->fileSize;
+    font->fileDataOwner = TTY_FILE_DATA_USER;
+    return tty_font_init_impl(font, faceIdx, flags);
+}
+
 void tty_font_free(TTY_Font* font) {
-    free(font->fileData);
-    font->fileData = NULL;
+    tty_font_free_file_data(font);
 
     free(font->hint.mem);
     font->hint.mem = NULL;
+
+    tty_render_context_free(&font->renderCtx);
+
+    free(font->glyfOffsets);
+    font->glyfOffsets = NULL;
+
+    free(font->cmapPageDir);
+    font->cmapPageDir = NULL;
+    font->cmapPages   = NULL;
+
+    free(font->bmpGlyphIndices);
+    font->bmpGlyphIndices = NULL;
+
+    free(font->horMetrics);
+    free(font->vertMetrics);
+    font->horMetrics  = NULL;
+    font->vertMetrics = NULL;
+
+    free(font->componentStarts);
+    free(font->components);
+    font->componentStarts = NULL;
+    font->components      = NULL;
+
+    free(font->complexity);
+    font->complexity = NULL;
+
+    tty_outline_cache_free(&font->outlineCache);
+
+    free(font->compiledRuntime.funcs);
+    font->compiledRuntime.funcs = NULL;
+    font->compiledGlyphs        = NULL;
+    font->compiledModule        = NULL;
+}
+
+TTY_Error tty_font_enable_outline_cache(TTY_Font* font, TTY_U32 maxBytes) {
+    return tty_outline_cache_init(&font->outlineCache, maxBytes, font->numGlyphs);
+}
+
+
+static TTY_Error tty_collection_init_impl(TTY_Collection* collection) {
+    if (collection->fileSize >= 12 && TTY_TAG_EQUALS(collection->fileData, "ttcf")) {
+        collection->numFaces = tty_get_u32(collection->fileData + 8);
+    }
+    else {
+        // A standalone font file is treated as a collection with one face
+        collection->numFaces = 1;
+    }
+    return TTY_ERROR_NONE;
+}
+
+TTY_Error tty_collection_init(TTY_Collection* collection, const char* path) {
+    memset(collection, 0, sizeof(TTY_Collection));
+
+    {
+        TTY_Error error;
+        if ((error = tty_read_file(path, &collection->fileData, &collection->fileSize))) {
+            return error;
+        }
+    }
+
+    collection->fileDataOwner = TTY_FILE_DATA_ALLOCATED;
+    return tty_collection_init_impl(collection);
+}
+
+TTY_Error tty_collection_init_mmap(TTY_Collection* collection, const char* path) {
+    memset(collection, 0, sizeof(TTY_Collection));
+
+    {
+        TTY_Error error;
+        if ((error = tty_map_file(path, &collection->fileData, &collection->fileSize))) {
+            return error;
+        }
+    }
+
+    collection->fileDataOwner = TTY_FILE_DATA_MAPPED;
+    return tty_collection_init_impl(collection);
+}
+
+void tty_collection_free(TTY_Collection* collection) {
+    tty_free_file_data(collection->fileData, collection->fileSize, collection->fileDataOwner);
+    collection->fileData = NULL;
+}
+
+
+// Functions are stored as file offsets so that they can be resolved against a
+// different copy or mapping of the file
+static TTY_U8* tty_write_snapshot_funcs(TTY_Font* font, TTY_U8* data) {
+    for (TTY_U32 i = 0; i < font->hint.funcs.cap; i++, data += 8) {
+        TTY_Program* body = font->hint.funcs.bodies + i;
+        if (body->ops == NULL) {
+            tty_set_u32(data, TTY_SNAPSHOT_NULL_FUNC);
+            tty_set_u32(data + 4, 0);
+        }
+        else {
+            tty_set_u32(data, body->bytes - font->fileData + body->start);
+            tty_set_u32(data + 4, body->end - body->start);
+        }
+    }
+    return data;
+}
+
+// Finds the decoded ops of a function from the location of its instructions
+// in the file. Functions can only be defined by the font and CV programs.
+static TTY_Bool tty_find_func_body(TTY_Font* font, TTY_U32 off, TTY_U32 size, TTY_Program* body) {
+    TTY_Program* programs[] = { &font->hint.fontProgram, &font->hint.cvProgram };
+
+    for (TTY_U32 i = 0; i < 2; i++) {
+        TTY_Program* program = programs[i];
+        TTY_U32      base    = program->bytes - font->fileData;
+
+        if (off >= base && (TTY_U64)off + size <= (TTY_U64)base + program->end) {
+            TTY_U32 startIdx = program->opIdxs[off - base];
+            TTY_U32 endIdx   = program->opIdxs[off - base + size];
+            tty_program_init_body(body, program, startIdx, endIdx);
+            return TTY_TRUE;
+        }
+    }
+
+    return TTY_FALSE;
+}
+
+static TTY_Bool tty_validate_snapshot_funcs(TTY_Font* font, const TTY_U8* data) {
+    for (TTY_U32 i = 0; i < font->hint.funcs.cap; i++, data += 8) {
+        TTY_U32     off  = tty_get_u32(data);
+        TTY_U32     size = tty_get_u32(data + 4);
+        TTY_Program body;
+        if (off != TTY_SNAPSHOT_NULL_FUNC && !tty_find_func_body(font, off, size, &body)) {
+            return TTY_FALSE;
+        }
+    }
+    return TTY_TRUE;
+}
+
+// Checks whether the font's function table is the same as the one in the 
+// snapshot
+static TTY_Bool tty_snapshot_funcs_match(TTY_Font* font, const TTY_U8* data) {
+    for (TTY_U32 i = 0; i < font->hint.funcs.cap; i++, data += 8) {
+        TTY_Program* body = font->hint.funcs.bodies + i;
+        TTY_U32      off  = tty_get_u32(data);
+        if (body->ops == NULL) {
+            if (off != TTY_SNAPSHOT_NULL_FUNC) {
+                return TTY_FALSE;
+            }
+        }
+        else if (off  != (TTY_U32)(body->bytes - font->fileData) + body->start ||
+                 tty_get_u32(data + 4) != body->end - body->start)
+        {
+            return TTY_FALSE;
+        }
+    }
+    return TTY_TRUE;
+}
+
+static const TTY_U8* tty_read_snapshot_funcs(TTY_Font* font, const TTY_U8* data) {
+    for (TTY_U32 i = 0; i < font->hint.funcs.cap; i++, data += 8) {
+        TTY_U32 off = tty_get_u32(data);
+        if (off == TTY_SNAPSHOT_NULL_FUNC) {
+            memset(font->hint.funcs.bodies + i, 0, sizeof(TTY_Program));
+        }
+        else {
+            tty_find_func_body(font, off, tty_get_u32(data + 4), font->hint.funcs.bodies + i);
+        }
+        tty_bind_compiled_func(font, i);
+    }
+    return data;
+}
+
+TTY_Error tty_font_save_program_snapshot(TTY_Font* font, TTY_U8* data, TTY_U32* size) {
+    if (!font->hasHinting) {
+        return TTY_ERROR_UNSUPPORTED_FEATURE;
+    }
+
+    if (font->isFontProgramPending) {
+        TTY_Error error = tty_execute_font_program(font);
+        if (error != TTY_ERROR_NONE) {
+            return error;
+        }
+    }
+
+    TTY_U32 requiredSize = TTY_FONT_SNAPSHOT_HEADER_SIZE + 8 * font->hint.funcs.cap;
+
+    if (data == NULL) {
+        *size = requiredSize;
+        return TTY_ERROR_NONE;
+    }
+
+    if (*size < requiredSize) {
+        return TTY_ERROR_BUFFER_TOO_SMALL;
+    }
+    *size = requiredSize;
+
+    memcpy(data, "TTYF", 4);
+    tty_set_u32(data +  4, TTY_SNAPSHOT_VERSION);
+    tty_set_u64(data +  8, tty_calc_font_checksum(font));
+    tty_set_u16(data + 16, font->hint.funcs.cap);
+    tty_set_u16(data + 18, font->renderCtx.stack.cap);
+    tty_set_u32(data + 20, 0);
+    data += TTY_FONT_SNAPSHOT_HEADER_SIZE;
+
+    tty_write_snapshot_funcs(font, data);
+    return TTY_ERROR_NONE;
+}
+
+TTY_Error tty_font_load_program_snapshot(TTY_Font* font, const TTY_U8* data, TTY_U32 size) {
+    if (!font->isFontProgramPending) {
+        return TTY_ERROR_NONE;
+    }
+
+    if (size < TTY_FONT_SNAPSHOT_HEADER_SIZE                   ||
+        !TTY_TAG_EQUALS(data, "TTYF")                          ||
+        tty_get_u32(data +  4) != TTY_SNAPSHOT_VERSION         ||
+        tty_get_u64(data +  8) != tty_calc_font_checksum(font) ||
+        tty_get_u16(data + 16) != font->hint.funcs.cap         ||
+        tty_get_u16(data + 18) != font->renderCtx.stack.cap    ||
+        size != TTY_FONT_SNAPSHOT_HEADER_SIZE + 8u * font->hint.funcs.cap)
+    {
+        return TTY_ERROR_SNAPSHOT_MISMATCH;
+    }
+    data += TTY_FONT_SNAPSHOT_HEADER_SIZE;
+
+    // Validate the functions before modifying the font so that a bad 
+    // snapshot leaves the font program pending
+    if (!tty_validate_snapshot_funcs(font, data)) {
+        return TTY_ERROR_SNAPSHOT_MISMATCH;
+    }
+    tty_read_snapshot_funcs(font, data);
+
+    font->isFontProgramPending = TTY_FALSE;
+    return TTY_ERROR_NONE;
+}
+
+TTY_U64 tty_font_get_checksum(TTY_Font* font) {
+    return tty_calc_font_checksum(font);
+}
+
+TTY_Error tty_font_register_compiled_module(TTY_Font* font, const TTY_Compiled_Module* module) {
+    if (!font->hasHinting) {
+        return TTY_ERROR_UNSUPPORTED_FEATURE;
+    }
+
+    if (module != NULL && module->checksum != tty_calc_font_checksum(font)) {
+        return TTY_ERROR_MODULE_MISMATCH;
+    }
+
+    if (font->compiledRuntime.funcs == NULL) {
+        // The function table and the glyph table share one allocation
+        TTY_Compiled_Program* mem = (TTY_Compiled_Program*)calloc(font->hint.funcs.cap + font->numGlyphs, sizeof(TTY_Compiled_Program));
+        if (mem == NULL) {
+            return TTY_ERROR_OUT_OF_MEMORY;
+        }
+        font->compiledRuntime.funcs   = mem;
+        font->compiledRuntime.execute = tty_compiled_execute;
+        font->compiledRuntime.call    = tty_compiled_call;
+        font->compiledGlyphs          = mem + font->hint.funcs.cap;
+    }
+
+    font->compiledModule = module;
+    memset(font->compiledGlyphs, 0, font->numGlyphs * sizeof(TTY_Compiled_Program));
+
+    if (module != NULL) {
+        for (TTY_U32 i = 0; i < module->numGlyphs; i++) {
+            if (module->glyphs[i].glyphIdx < font->numGlyphs) {
+                font->compiledGlyphs[module->glyphs[i].glyphIdx] = module->glyphs[i].program;
+            }
+        }
+    }
+
+    for (TTY_U32 i = 0; i < font->hint.funcs.cap; i++) {
+        tty_bind_compiled_func(font, i);
+    }
+    return TTY_ERROR_NONE;
 }
 
 
 /* ---------------- */
 /* Instance Loading */
 /* ---------------- */
+enum {
+    TTY_GASP_GRIDFIT             = 0x1,
+    TTY_GASP_DOGRAY              = 0x2,
+    TTY_GASP_SYMMETRIC_GRIDFIT   = 0x4,
+    TTY_GASP_SYMMETRIC_SMOOTHING = 0x8,
+};
+
 static void tty_reset_graphics_state(TTY_Graphics_State* gs, TTY_Zone* zone1) {
     gs->move_point        = tty_move_point_x;
     gs->zp0               = zone1;
@@ -2826,76 +4704,416 @@ static void tty_reset_graphics_state(TTY_Graphics_State* gs, TTY_Zone* zone1) {
     gs->autoFlip          = TTY_TRUE;
 }
 
-static void tty_execute_next_cv_program_ins(TTY_Program_Context* ctx) {
-    TTY_U8 ins = tty_ins_stream_next(&ctx->stream);
+static TTY_Error tty_instance_init_impl(TTY_Font* font, TTY_Instance* instance, TTY_U32 flags) {
+    memset(instance, 0, sizeof(TTY_Instance));
+
+    TTY_PROFILE_START(timer);
+    
+    instance->useHinting           = font->hasHinting && !(flags & TTY_INSTANCE_NO_HINTING);
+    instance->useSubpixelRendering = flags & TTY_INSTANCE_SUBPIXEL_RENDERING_RGB;
+    instance->useGasp              = (flags & TTY_INSTANCE_USE_GASP) && font->gasp.exists;
+    instance->useEmbeddedBitmaps   = !(flags & TTY_INSTANCE_NO_EMBEDDED_BITMAPS) && (font->EBLC.exists || font->CBLC.exists);
+    instance->isRotated            = TTY_FALSE;
+    instance->isStretched          = TTY_FALSE;
+
+    // Allocate hinting data if the instance uses hinting
+    // Note: If the gasp table is used, the data is allocated even if the 
+    //       initial ppem doesn't use hinting since the instance can be resized
+    if (instance->useHinting) {
+        instance->hint.cvt.cap         = font->cvt.size / sizeof(TTY_S16);
+        instance->hint.storage.cap     = tty_get_u16(font->fileData + font->maxp.off + 18);
+        instance->hint.zone0.maxPoints = tty_get_u16(font->fileData + font->maxp.off + 16);
+        
+        size_t off             = 0;
+        size_t totalSize       = 0;
+        size_t cvtSize         = tty_calc_mem_size(&totalSize, instance->hint.cvt.cap         * sizeof(TTY_F26Dot6), TTY_ALIGN_OF(TTY_S32));
+        size_t storeSize       = tty_calc_mem_size(&totalSize, instance->hint.storage.cap     * sizeof(TTY_S32)    , TTY_ALIGN_OF(TTY_V2));
+        size_t z0OrgScaledSize = tty_calc_mem_size(&totalSize, instance->hint.zone0.maxPoints * sizeof(TTY_V2)     , 1);
+        size_t z0CurSize       = tty_calc_mem_size(&totalSize, z0OrgScaledSize                                     , 1);
+        /*size_t z0TouchSize = */tty_calc_mem_size(&totalSize, instance->hint.zone0.maxPoints * sizeof(TTY_U8)     , 1);
+        
+        instance->hint.mem = (TTY_U8*)calloc(totalSize, 1);
+        if (instance->hint.mem == NULL) {
+            return TTY_ERROR_OUT_OF_MEMORY;
+        }
+        
+        instance->hint.cvt.buff         = (TTY_F26Dot6*)(instance->hint.mem);
+        instance->hint.storage.buff     = (TTY_S32*)    (instance->hint.mem + (off += cvtSize));
+        instance->hint.zone0.orgScaled  = (TTY_V2*)     (instance->hint.mem + (off += storeSize));
+        instance->hint.zone0.cur        = (TTY_V2*)     (instance->hint.mem + (off += z0OrgScaledSize));
+        instance->hint.zone0.touchFlags = (TTY_U8*)     (instance->hint.mem + (off += z0CurSize));
+
+        TTY_PROFILE_ADD(instance->stats.bytesAllocated, totalSize);
+    }
+
+    TTY_PROFILE_LAP(timer, instance->stats.allocNs);
+    return TTY_ERROR_NONE;
+}
+
+// Checks whether the font's gasp table wants grid-fitting at the given ppem.
+// Version 1 tables can request symmetric grid-fitting instead, which is what 
+// the interpreter's subpixel (V40) behavior corresponds to.
+static TTY_Bool tty_gasp_allows_gridfit(TTY_Font* font, TTY_U32 ppem) {
+    TTY_U8* gasp      = font->fileData + font->gasp.off;
+    TTY_U16 version   = tty_get_u16(gasp);
+    TTY_U16 numRanges = tty_get_u16(gasp + 2);
+    TTY_U16 mask      = version >= 1 ? TTY_GASP_GRIDFIT | TTY_GASP_SYMMETRIC_GRIDFIT : TTY_GASP_GRIDFIT;
+
+    // The ranges were validated when the font was loaded
+    for (TTY_U32 i = 0; i < numRanges; i++) {
+        TTY_U8* range = gasp + 4 + 4 * i;
+        if (ppem <= tty_get_u16(range)) {
+            return (tty_get_u16(range + 2) & mask) != 0;
+        }
+    }
+
+    // The last range should end at 0xFFFF, but if it doesn't, keep hinting
+    return TTY_TRUE;
+}
+
+static TTY_U8* tty_find_hdmx_widths(TTY_Font* font, TTY_U32 ppem) {
+    TTY_U8* hdmx       = font->fileData + font->hdmx.off;
+    TTY_S16 numRecords = tty_get_s16(hdmx + 2);
+    TTY_U32 recordSize = tty_get_u32(hdmx + 4);
+
+    // The records were validated when the font was loaded
+    for (TTY_S32 i = 0; i < numRecords; i++) {
+        TTY_U8* record = hdmx + 8 + i * recordSize;
+        if (record[0] == ppem) {
+            return record + 2;
+        }
+    }
+
+    return NULL;
+}
+
+// Gets the maximum and minimum y-values, in pixels, of the font's hinted 
+// glyphs at the given ppem from the VDMX table. Only ratios that include 1:1
+// are considered since pixels are square.
+static TTY_Bool tty_find_vdmx_extents(TTY_Font* font, TTY_U32 ppem, TTY_S16* yMax, TTY_S16* yMin) {
+    TTY_U8* vdmx      = font->fileData + font->VDMX.off;
+    TTY_U16 numRatios = tty_get_u16(vdmx + 4);
+
+    for (TTY_U32 i = 0; i < numRatios; i++) {
+        TTY_U8* ratio = vdmx + 6 + 4 * i;
+
+        // A ratio of 0:0-0 matches every aspect ratio
+        if (ratio[2] > ratio[1] || ratio[3] < ratio[1]) {
+            continue;
+        }
+
+        TTY_U8* group   = vdmx + tty_get_u16(vdmx + 6 + 4 * numRatios + 2 * i);
+        TTY_U16 numRecs = tty_get_u16(group);
+
+        for (TTY_U32 j = 0; j < numRecs; j++) {
+            TTY_U8* rec = group + 4 + 6 * j;
+            if (tty_get_u16(rec) == ppem) {
+                *yMax = tty_get_s16(rec + 2);
+                *yMin = tty_get_s16(rec + 4);
+                return TTY_TRUE;
+            }
+        }
+
+        // Only the first matching ratio is used
+        return TTY_FALSE;
+    }
+
+    return TTY_FALSE;
+}
+
+// Gets the location and data tables of the font's bitmap strikes. EBLC is 
+// preferred since CBLC strikes are almost always color.
+static TTY_Bool tty_get_bitmap_tables(TTY_Font* font, TTY_Table** loc, TTY_Table** data) {
+    if (font->EBLC.exists) {
+        *loc  = &font->EBLC;
+        *data = &font->EBDT;
+        return TTY_TRUE;
+    }
+    if (font->CBLC.exists) {
+        *loc  = &font->CBLC;
+        *data = &font->CBDT;
+        return TTY_TRUE;
+    }
+    return TTY_FALSE;
+}
+
+// Finds the BitmapSize record of the strike for the given ppem. Only 
+// grayscale strikes with square pixels are used since the rasterizer only 
+// produces coverage values.
+static TTY_U8* tty_find_bitmap_strike(TTY_Font* font, TTY_U32 ppem) {
+    TTY_Table* loc;
+    TTY_Table* data;
+    if (!tty_get_bitmap_tables(font, &loc, &data) || loc->size < 8) {
+        return NULL;
+    }
+
+    TTY_U8* blc      = font->fileData + loc->off;
+    TTY_U32 numSizes = tty_get_u32(blc + 4);
+    
+    if (numSizes > (loc->size - 8) / 48) {
+        return NULL;
+    }
+
+    for (TTY_U32 i = 0; i < numSizes; i++) {
+        TTY_U8* strike   = blc + 8 + 48 * i;
+        TTY_U8  bitDepth = strike[46];
+
+        if (strike[44] != ppem || strike[45] != ppem) {
+            continue;
+        }
+
+        if (bitDepth != 1 && bitDepth != 2 && bitDepth != 4 && bitDepth != 8) {
+            continue;
+        }
+
+        // The strike's IndexSubTableArray must be inside the table
+        TTY_U64 arrayEnd = (TTY_U64)tty_get_u32(strike) + 8 * (TTY_U64)tty_get_u32(strike + 8);
+        if (arrayEnd <= loc->size) {
+            return strike;
+        }
+    }
+
+    return NULL;
+}
+
+static void tty_instance_set_scale(TTY_Font* font, TTY_Instance* instance, TTY_U32 ppem) {
+    if (instance->useGasp) {
+        // Hinting data is only allocated if hinting is allowed at all
+        instance->useHinting = instance->hint.mem != NULL && tty_gasp_allows_gridfit(font, ppem);
+    }
+
+    instance->scale          = tty_rounded_div((TTY_S64)ppem << 22, font->upem);
+    instance->ppem           = ppem;
+    instance->ascender       = tty_f26dot6_ceil(TTY_F10DOT22_MUL(font->ascender      << 6, instance->scale)) >> 6;
+    instance->descender      = tty_f26dot6_ceil(TTY_F10DOT22_MUL(font->descender     << 6, instance->scale)) >> 6;
+    instance->lineGap        = tty_f26dot6_ceil(TTY_F10DOT22_MUL(font->lineGap       << 6, instance->scale)) >> 6;
+    instance->maxGlyphSize.x = tty_f26dot6_ceil(TTY_F10DOT22_MUL(font->maxHoriExtent << 6, instance->scale)) >> 6;
+    instance->maxGlyphSize.y = instance->ascender - instance->descender;
+    instance->hdmxWidths     = NULL;
+
+    // Hinted outlines are only valid for the ppem they were hinted at
+    tty_outline_cache_clear(&instance->hintedCache);
+
+    if (instance->useHinting) {
+        TTY_S16 yMax, yMin;
+
+        if (font->hdmx.exists) {
+            instance->hdmxWidths = tty_find_hdmx_widths(font, ppem);
+        }
+
+        if (font->VDMX.exists && tty_find_vdmx_extents(font, ppem, &yMax, &yMin)) {
+            // The extents of the hinted glyphs are used as the line metrics. 
+            // The max glyph size is only ever increased so that glyphs which 
+            // our hinter places slightly differently still fit.
+            instance->ascender       = yMax;
+            instance->descender      = yMin;
+            instance->maxGlyphSize.y = TTY_MAX(instance->maxGlyphSize.y, yMax - yMin);
+        }
+    }
+
+    instance->bitmapStrike = instance->useEmbeddedBitmaps ? tty_find_bitmap_strike(font, ppem) : NULL;
+
+    if (instance->bitmapStrike != NULL) {
+        // The outline's line metrics are kept, but the max glyph size has to 
+        // hold the strike's bitmaps (hori.ascender, hori.descender, and 
+        // hori.widthMax)
+        TTY_S8 yMax     = (TTY_S8)instance->bitmapStrike[16];
+        TTY_S8 yMin     = (TTY_S8)instance->bitmapStrike[17];
+        TTY_U8 widthMax = instance->bitmapStrike[18];
+
+        instance->maxGlyphSize.x = TTY_MAX(instance->maxGlyphSize.x, widthMax);
+        instance->maxGlyphSize.y = TTY_MAX(instance->maxGlyphSize.y, yMax - yMin);
+    }
+}
+
+static TTY_U32 tty_calc_instance_snapshot_size(TTY_Font* font, TTY_Instance* instance) {
+    return 
+        TTY_INSTANCE_SNAPSHOT_HEADER_SIZE                  +
+        instance->hint.cvt.cap         * 4                 +
+        instance->hint.storage.cap     * 4                 +
+        instance->hint.zone0.maxPoints * (8 + 8 + 1)       + // orgScaled, cur, and touchFlags
+        font->hint.funcs.cap           * 8;
+}
+
+// The flags are part of the snapshot's key since they are observable by the
+// CV program (i.e. subpixel rendering through GETINFO)
+static TTY_U32 tty_get_instance_snapshot_flags(TTY_Instance* instance) {
+    TTY_U32 flags = 0;
+
+    if (instance->useSubpixelRendering) {
+        flags |= TTY_INSTANCE_SUBPIXEL_RENDERING_RGB;
+    }
+    if (instance->useGasp) {
+        flags |= TTY_INSTANCE_USE_GASP;
+    }
+    if (!instance->useEmbeddedBitmaps) {
+        flags |= TTY_INSTANCE_NO_EMBEDDED_BITMAPS;
+    }
+
+    return flags;
+}
+
+static TTY_Bool tty_load_instance_snapshot(TTY_Font* font, TTY_Instance* instance, const TTY_U8* data, TTY_U32 size) {
+    if (size < TTY_INSTANCE_SNAPSHOT_HEADER_SIZE                            ||
+        !TTY_TAG_EQUALS(data, "TTYI")                                       ||
+        tty_get_u32(data +  4) != TTY_SNAPSHOT_VERSION                      ||
+        tty_get_u64(data +  8) != tty_calc_font_checksum(font)              ||
+        tty_get_u32(data + 16) != instance->ppem                            ||
+        tty_get_s16(data + 20) != instance->hint.cvt.cap                    ||
+        tty_get_u16(data + 22) != instance->hint.storage.cap                ||
+        tty_get_u16(data + 24) != instance->hint.zone0.maxPoints            ||
+        tty_get_u16(data + 26) != font->hint.funcs.cap                      ||
+        tty_get_u32(data + 28) != tty_get_instance_snapshot_flags(instance) ||
+        size != tty_calc_instance_snapshot_size(font, instance))
+    {
+        return TTY_FALSE;
+    }
+    data += TTY_INSTANCE_SNAPSHOT_HEADER_SIZE;
+
+    // The snapshot only restores the instance's state. The CV program can 
+    // define functions, so the snapshot can only be used if the font's 
+    // function table is already the one the CV program left behind.
+    {
+        const TTY_U8* funcs = 
+            data + size - TTY_INSTANCE_SNAPSHOT_HEADER_SIZE - font->hint.funcs.cap * 8;
+
+        if (!tty_snapshot_funcs_match(font, funcs)) {
+            return TTY_FALSE;
+        }
+    }
+
+    for (TTY_S32 i = 0; i < instance->hint.cvt.cap; i++, data += 4) {
+        instance->hint.cvt.buff[i] = (TTY_S32)tty_get_u32(data);
+    }
+
+    for (TTY_U32 i = 0; i < instance->hint.storage.cap; i++, data += 4) {
+        instance->hint.storage.buff[i] = (TTY_S32)tty_get_u32(data);
+    }
+
+    for (TTY_U32 i = 0; i < instance->hint.zone0.maxPoints; i++, data += 16) {
+        instance->hint.zone0.orgScaled[i].x = (TTY_S32)tty_get_u32(data);
+        instance->hint.zone0.orgScaled[i].y = (TTY_S32)tty_get_u32(data + 4);
+        instance->hint.zone0.cur      [i].x = (TTY_S32)tty_get_u32(data + 8);
+        instance->hint.zone0.cur      [i].y = (TTY_S32)tty_get_u32(data + 12);
+    }
+
+    memcpy(instance->hint.zone0.touchFlags, data, instance->hint.zone0.maxPoints);
+    return TTY_TRUE;
+}
+
+TTY_Error tty_instance_init(TTY_Font* font, TTY_Instance* instance, TTY_U32 ppem, TTY_U32 flags) {
+    TTY_Error error;
+    if ((error = tty_instance_init_impl(font, instance, flags))) {
+        return error;
+    }
+    return tty_instance_resize(font, instance, ppem);
+}
+
+TTY_Error tty_instance_init_from_snapshot(TTY_Font* font, TTY_Instance* instance, TTY_U32 ppem, TTY_U32 flags, const TTY_U8* data, TTY_U32 size) {
+    TTY_Error error;
 
-    if (tty_try_execute_shared_ins(ctx, ins)) {
-        return;
+    if ((error = tty_instance_init_impl(font, instance, flags))) {
+        return error;
     }
 
-    switch (ins) {
-        case TTY_FDEF:
-            tty_FDEF(ctx);
-            return;
-        // case TTY_IDEF:
-        //     tty_IDEF(ctx);
-        //     return TTY_TRUE;
+    tty_instance_set_scale(font, instance, ppem);
+
+    if (!instance->useHinting) {
+        // There is nothing to restore
+        return TTY_ERROR_NONE;
+    }
+
+    // A deferred font program still needs to execute since the snapshot only
+    // restores the instance's state, and the functions it defines are 
+    // compared with the snapshot's function table
+    if (font->isFontProgramPending) {
+        if ((error = tty_execute_font_program(font))) {
+            tty_instance_free(instance);
+            return error;
+        }
+    }
+
+    if (tty_load_instance_snapshot(font, instance, data, size)) {
+        return TTY_ERROR_NONE;
+    }
+
+    // Fall back to executing the font program (if needed) and the CV program
+    if ((error = tty_instance_resize(font, instance, ppem))) {
+        tty_instance_free(instance);
+        return error;
     }
 
-    TTY_LOG_UNKNOWN_INS(ins);
-    ctx->foundUnknownIns = TTY_TRUE;
+    return TTY_ERROR_SNAPSHOT_MISMATCH;
 }
 
-TTY_Error tty_instance_init(TTY_Font* font, TTY_Instance* instance, TTY_U32 ppem, TTY_U32 flags) {
-    memset(instance, 0, sizeof(TTY_Instance));
-    
-    instance->useHinting           = font->hasHinting && (flags ^ TTY_INSTANCE_NO_HINTING);
-    instance->useSubpixelRendering = flags & TTY_INSTANCE_SUBPIXEL_RENDERING_RGB;
-    instance->isRotated            = TTY_FALSE;
-    instance->isStretched          = TTY_FALSE;
+TTY_Error tty_instance_save_snapshot(TTY_Font* font, TTY_Instance* instance, TTY_U8* data, TTY_U32* size) {
+    if (!instance->useHinting) {
+        return TTY_ERROR_UNSUPPORTED_FEATURE;
+    }
 
-    // Allocate hinting data if the instance uses hinting
-    if (instance->useHinting) {
-        instance->hint.cvt.cap         = font->cvt.size / sizeof(TTY_S16);
-        instance->hint.storage.cap     = tty_get_u16(font->fileData + font->maxp.off + 18);
-        instance->hint.zone0.maxPoints = tty_get_u16(font->fileData + font->maxp.off + 16);
-        
-        size_t off             = 0;
-        size_t totalSize       = 0;
-        size_t cvtSize         = tty_calc_mem_size(&totalSize, instance->hint.cvt.cap         * sizeof(TTY_F26Dot6), TTY_ALIGN_OF(TTY_S32));
-        size_t storeSize       = tty_calc_mem_size(&totalSize, instance->hint.storage.cap     * sizeof(TTY_S32)    , TTY_ALIGN_OF(TTY_V2));
-        size_t z0OrgScaledSize = tty_calc_mem_size(&totalSize, instance->hint.zone0.maxPoints * sizeof(TTY_V2)     , 1);
-        size_t z0CurSize       = tty_calc_mem_size(&totalSize, z0OrgScaledSize                                     , 1);
-        /*size_t z0TouchSize = */tty_calc_mem_size(&totalSize, instance->hint.zone0.maxPoints * sizeof(TTY_U8)     , 1);
-        
-        instance->hint.mem = (TTY_U8*)calloc(totalSize, 1);
-        if (instance->hint.mem == NULL) {
-            return TTY_ERROR_OUT_OF_MEMORY;
-        }
-        
-        instance->hint.cvt.buff         = (TTY_F26Dot6*)(instance->hint.mem);
-        instance->hint.storage.buff     = (TTY_S32*)    (instance->hint.mem + (off += cvtSize));
-        instance->hint.zone0.orgScaled  = (TTY_V2*)     (instance->hint.mem + (off += storeSize));
-        instance->hint.zone0.cur        = (TTY_V2*)     (instance->hint.mem + (off += z0OrgScaledSize));
-        instance->hint.zone0.touchFlags = (TTY_U8*)     (instance->hint.mem + (off += z0CurSize));
+    TTY_U32 requiredSize = tty_calc_instance_snapshot_size(font, instance);
+
+    if (data == NULL) {
+        *size = requiredSize;
+        return TTY_ERROR_NONE;
     }
 
-    return tty_instance_resize(font, instance, ppem);
+    if (*size < requiredSize) {
+        return TTY_ERROR_BUFFER_TOO_SMALL;
+    }
+    *size = requiredSize;
+
+    memcpy(data, "TTYI", 4);
+    tty_set_u32(data +  4, TTY_SNAPSHOT_VERSION);
+    tty_set_u64(data +  8, tty_calc_font_checksum(font));
+    tty_set_u32(data + 16, instance->ppem);
+    tty_set_u16(data + 20, instance->hint.cvt.cap);
+    tty_set_u16(data + 22, instance->hint.storage.cap);
+    tty_set_u16(data + 24, instance->hint.zone0.maxPoints);
+    tty_set_u16(data + 26, font->hint.funcs.cap);
+    tty_set_u32(data + 28, tty_get_instance_snapshot_flags(instance));
+    data += TTY_INSTANCE_SNAPSHOT_HEADER_SIZE;
+
+    for (TTY_S32 i = 0; i < instance->hint.cvt.cap; i++, data += 4) {
+        tty_set_u32(data, instance->hint.cvt.buff[i]);
+    }
+
+    for (TTY_U32 i = 0; i < instance->hint.storage.cap; i++, data += 4) {
+        tty_set_u32(data, instance->hint.storage.buff[i]);
+    }
+
+    for (TTY_U32 i = 0; i < instance->hint.zone0.maxPoints; i++, data += 16) {
+        tty_set_u32(data,      instance->hint.zone0.orgScaled[i].x);
+        tty_set_u32(data +  4, instance->hint.zone0.orgScaled[i].y);
+        tty_set_u32(data +  8, instance->hint.zone0.cur      [i].x);
+        tty_set_u32(data + 12, instance->hint.zone0.cur      [i].y);
+    }
+
+    memcpy(data, instance->hint.zone0.touchFlags, instance->hint.zone0.maxPoints);
+    data += instance->hint.zone0.maxPoints;
+
+    tty_write_snapshot_funcs(font, data);
+    return TTY_ERROR_NONE;
 }
 
 TTY_Error tty_instance_resize(TTY_Font* font, TTY_Instance* instance, TTY_U32 ppem) {
-    instance->scale          = tty_rounded_div((TTY_S64)ppem << 22, font->upem);
-    instance->ppem           = ppem;
-    instance->ascender       = tty_f26dot6_ceil(TTY_F10DOT22_MUL(font->ascender      << 6, instance->scale)) >> 6;
-    instance->descender      = tty_f26dot6_ceil(TTY_F10DOT22_MUL(font->descender     << 6, instance->scale)) >> 6;
-    instance->lineGap        = tty_f26dot6_ceil(TTY_F10DOT22_MUL(font->lineGap       << 6, instance->scale)) >> 6;
-    instance->maxGlyphSize.x = tty_f26dot6_ceil(TTY_F10DOT22_MUL(font->maxHoriExtent << 6, instance->scale)) >> 6;
-    instance->maxGlyphSize.y = instance->ascender - instance->descender;
+    tty_instance_set_scale(font, instance, ppem);
 
     if (!instance->useHinting) {
         return TTY_ERROR_NONE;
     }
 
+    if (font->isFontProgramPending) {
+        // The font program is deferred until the first hinted instance size
+        // is set
+        TTY_Error error = tty_execute_font_program(font);
+        if (error != TTY_ERROR_NONE) {
+            return error;
+        }
+    }
+
+    TTY_PROFILE_START(timer);
+
     // Convert default CVT values from font units to 26.6 pixel units
     {
         TTY_U32 idx = 0;
@@ -2905,6 +5123,8 @@ TTY_Error tty_instance_resize(TTY_Font* font, TTY_Instance* instance, TTY_U32 pp
         }
     }
 
+    TTY_PROFILE_LAP(timer, instance->stats.cvtScaleNs);
+
     // Execute the CV program
     {
         // "Every time the control value program is run, the zone 0 contour data is
@@ -2913,23 +5133,28 @@ TTY_Error tty_instance_resize(TTY_Font* font, TTY_Instance* instance, TTY_U32 pp
         memset(instance->hint.zone0.cur,        0, instance->hint.zone0.maxPoints * sizeof(TTY_V2));
         memset(instance->hint.zone0.touchFlags, 0, instance->hint.zone0.maxPoints * sizeof(TTY_U8));
 
-        tty_reset_graphics_state(&font->hint.gs, &font->hint.zone1);
-        tty_interp_stack_clear(&font->hint.stack);
+        tty_reset_graphics_state(&font->renderCtx.gs, &font->renderCtx.zone1);
+        tty_interp_stack_clear(&font->renderCtx.stack);
 
         {
             TTY_Program_Context ctx;
             ctx.font                    = font;
             ctx.instance                = instance;
             ctx.glyph                   = NULL;
+            ctx.render                  = &font->renderCtx;
+            ctx.cvt                     = &instance->hint.cvt;
+            ctx.storage                 = &instance->hint.storage;
+            ctx.zone0                   = &instance->hint.zone0;
             ctx.iupState                = TTY_IUP_STATE_DEFAULT;
             ctx.foundUnknownIns         = TTY_FALSE;
-            ctx.stream.execute_next_ins = tty_execute_next_cv_program_ins;
-            ctx.stream.buff             = font->fileData + font->prep.off;
-            ctx.stream.cap              = font->prep.size;
-            ctx.stream.off              = 0;
+            TTY_PROFILE_INIT_CTX(ctx);
 
             TTY_LOG_PROGRAM("CV Program");   
-            return tty_execute_program(&ctx);
+
+            TTY_Error error = tty_execute_program(&ctx, &font->hint.cvProgram, TTY_OP_FDEF, TTY_OP_LAST_SHARED);
+            TTY_PROFILE_LAP(timer, instance->stats.cvProgramNs);
+            TTY_PROFILE_ADD(instance->stats.cvProgramInsCount, ctx.numInsExecuted);
+            return error;
         }
     }
 }
@@ -2937,12 +5162,155 @@ TTY_Error tty_instance_resize(TTY_Font* font, TTY_Instance* instance, TTY_U32 pp
 void tty_instance_free(TTY_Instance* instance) {
     free(instance->hint.mem);
     instance->hint.mem = NULL;
+
+    tty_outline_cache_free(&instance->hintedCache);
+}
+
+TTY_Error tty_instance_enable_hinted_cache(TTY_Font* font, TTY_Instance* instance, TTY_U32 maxBytes) {
+    return tty_outline_cache_init(&instance->hintedCache, maxBytes, font->numGlyphs);
+}
+
+
+/* -------------- */
+/* Render Context */
+/* -------------- */
+static TTY_Error tty_render_context_alloc(TTY_Font* font, TTY_Render_Context* render, size_t* size) {
+    memset(render, 0, sizeof(TTY_Render_Context));
+
+    render->startingEdgeCap = 100;
+
+    // The copies of the instance's hinting data are sized the same way as the
+    // instance's (see tty_instance_init_impl)
+    if (font->hasHinting) {
+        render->stack.cap        = tty_get_u16(font->fileData + font->maxp.off + 24);
+        render->cvt.cap          = font->cvt.size / sizeof(TTY_S16);
+        render->storage.cap      = tty_get_u16(font->fileData + font->maxp.off + 18);
+        render->zone0.maxPoints  = tty_get_u16(font->fileData + font->maxp.off + 16);
+        render->numGlyphPrograms = font->numGlyphs;
+    }
+
+    {
+        TTY_U16 maxContours          = tty_get_u16(font->fileData + font->maxp.off + 8);
+        TTY_U16 maxCompositeContours = tty_get_u16(font->fileData + font->maxp.off + 12);
+        render->zone1.maxEndPoints      = TTY_MAX(maxContours, maxCompositeContours);
+    }
+    
+    {
+        // Note: Not sure if maxPoints or maxCompositePoints includes phantom points,
+        //       so will add them just to be safe
+        TTY_U16 maxPoints          = tty_get_u16(font->fileData + font->maxp.off + 6);
+        TTY_U16 maxCompositePoints = tty_get_u16(font->fileData + font->maxp.off + 10);
+        render->zone1.maxPoints       = TTY_MAX(maxPoints, maxCompositePoints) + TTY_NUM_PHANTOM_POINTS;
+        render->curves.cap            = maxCompositePoints; // The number of curves a glyph has is <= the number of points it has
+    }
+
+    // The entries are in order of decreasing alignment, so none of them need
+    // padding
+    size_t off                   = 0;
+    size_t totalSize             = 0;
+    size_t glyphProgramsSize     = tty_calc_mem_size(&totalSize, render->numGlyphPrograms   * sizeof(TTY_Program), 1);
+    size_t curvesSize            = tty_calc_mem_size(&totalSize, render->curves.cap         * sizeof(TTY_Curve)  , 1);
+    size_t stackSize             = tty_calc_mem_size(&totalSize, render->stack.cap          * sizeof(TTY_U32)    , 1);
+    size_t cvtSize               = tty_calc_mem_size(&totalSize, render->cvt.cap            * sizeof(TTY_F26Dot6), 1);
+    size_t storeSize             = tty_calc_mem_size(&totalSize, render->storage.cap        * sizeof(TTY_S32)    , 1);
+    size_t z0OrgScaledSize       = tty_calc_mem_size(&totalSize, render->zone0.maxPoints    * sizeof(TTY_V2)     , 1);
+    size_t z0CurSize             = tty_calc_mem_size(&totalSize, z0OrgScaledSize                              , 1);
+    size_t z1OrgSize             = tty_calc_mem_size(&totalSize, render->zone1.maxPoints    * sizeof(TTY_V2)     , 1);
+    size_t z1OrgScaledSize       = tty_calc_mem_size(&totalSize, z1OrgSize                                    , 1);
+    size_t z1CurSize             = tty_calc_mem_size(&totalSize, z1OrgSize                                    , 1);
+    size_t z1EndPointIndicesSize = tty_calc_mem_size(&totalSize, render->zone1.maxEndPoints * sizeof(TTY_U16)    , 1);
+    size_t z0TouchSize           = tty_calc_mem_size(&totalSize, render->zone0.maxPoints    * sizeof(TTY_U8)     , 1);
+    size_t z1TouchTypesSize      = tty_calc_mem_size(&totalSize, render->zone1.maxPoints    * sizeof(TTY_U8)     , 1);
+    /* size_t z1PointTypesSize = */tty_calc_mem_size(&totalSize, render->zone1.maxPoints    * sizeof(TTY_U8)     , 1);
+
+    render->mem = (TTY_U8*)calloc(totalSize, 1);
+    if (render->mem == NULL) {
+        return TTY_ERROR_OUT_OF_MEMORY;
+    }
+
+    render->glyphPrograms         = (TTY_Program*)(render->mem);
+    render->curves.buff           = (TTY_Curve*)  (render->mem + (off += glyphProgramsSize));
+    render->stack.buff            = (TTY_U32*)    (render->mem + (off += curvesSize));
+    render->cvt.buff              = (TTY_F26Dot6*)(render->mem + (off += stackSize));
+    render->storage.buff          = (TTY_S32*)    (render->mem + (off += cvtSize));
+    render->zone0.orgScaled       = (TTY_V2*)     (render->mem + (off += storeSize));
+    render->zone0.cur             = (TTY_V2*)     (render->mem + (off += z0OrgScaledSize));
+    render->zone1.org             = (TTY_V2*)     (render->mem + (off += z0CurSize));
+    render->zone1.orgScaled       = (TTY_V2*)     (render->mem + (off += z1OrgSize));
+    render->zone1.cur             = (TTY_V2*)     (render->mem + (off += z1OrgScaledSize));
+    render->zone1.endPointIndices = (TTY_U16*)    (render->mem + (off += z1CurSize));
+    render->zone0.touchFlags      = (TTY_U8*)     (render->mem + (off += z1EndPointIndicesSize));
+    render->zone1.touchFlags      = (TTY_U8*)     (render->mem + (off += z0TouchSize));
+    render->zone1.pointTypes      = (TTY_U8*)     (render->mem + (off += z1TouchTypesSize));
+
+    *size = totalSize;
+    return TTY_ERROR_NONE;
+}
+
+// Copies the instance's CVT, storage area, and zone0 so that the glyph 
+// programs of the glyph that is about to be loaded can modify them. The copies
+// are made once per glyph since the glyph programs of a composite glyph's 
+// components share them.
+static void tty_render_context_copy_instance(TTY_Render_Context* render, TTY_Instance* instance) {
+    TTY_ASSERT(render->cvt.cap         == instance->hint.cvt.cap);
+    TTY_ASSERT(render->storage.cap     == instance->hint.storage.cap);
+    TTY_ASSERT(render->zone0.maxPoints == instance->hint.zone0.maxPoints);
+    memcpy(render->cvt.buff,         instance->hint.cvt.buff,         render->cvt.cap         * sizeof(TTY_F26Dot6));
+    memcpy(render->storage.buff,     instance->hint.storage.buff,     render->storage.cap     * sizeof(TTY_S32));
+    memcpy(render->zone0.orgScaled,  instance->hint.zone0.orgScaled,  render->zone0.maxPoints * sizeof(TTY_V2));
+    memcpy(render->zone0.cur,        instance->hint.zone0.cur,        render->zone0.maxPoints * sizeof(TTY_V2));
+    memcpy(render->zone0.touchFlags, instance->hint.zone0.touchFlags, render->zone0.maxPoints * sizeof(TTY_U8));
+}
+
+// Clears the zone1 state that is left over from the previous glyph so that
+// loading a glyph doesn't depend on which glyphs were loaded before it. The
+// points and end point indices are overwritten by every load, but the touch
+// flags are only set by glyph programs, which can touch any point including 
+// the phantom points.
+static void tty_render_context_reset_zone1(TTY_Render_Context* render) {
+    memset(render->zone1.touchFlags, TTY_UNTOUCHED, render->zone1.maxPoints * sizeof(TTY_U8));
+    memset(render->zone1.pointTypes, 0,             render->zone1.maxPoints * sizeof(TTY_U8));
+    render->zone1.numPoints        = 0;
+    render->zone1.numOutlinePoints = 0;
+    render->zone1.numEndPoints     = 0;
+}
+
+TTY_Error tty_render_context_init(TTY_Font* font, TTY_Render_Context* render) {
+    size_t size;
+    return tty_render_context_alloc(font, render, &size);
+}
+
+void tty_render_context_free(TTY_Render_Context* render) {
+    if (render->glyphPrograms != NULL) {
+        for (TTY_U32 i = 0; i < render->numGlyphPrograms; i++) {
+            free(render->glyphPrograms[i].ops);
+        }
+    }
+
+    free(render->mem);
+    render->mem           = NULL;
+    render->glyphPrograms = NULL;
 }
 
 
 /* ------------- */
 /* Glyph Loading */
 /* ------------- */
+enum {
+    TTY_GLYF_ARG_1_AND_2_ARE_WORDS     = 0x01  ,
+    TTY_GLYF_ARGS_ARE_XY_VALUES        = 0x02  ,
+    TTY_GLYF_ROUND_XY_TO_GRID          = 0x04  ,
+    TTY_GLYF_WE_HAVE_A_SCALE           = 0x08  ,
+    TTY_GLYF_MORE_COMPONENTS           = 0x20  ,
+    TTY_GLYF_WE_HAVE_AN_X_AND_Y_SCALE  = 0x40  ,
+    TTY_GLYF_WE_HAVE_A_TWO_BY_TWO      = 0x80  ,
+    TTY_GLYF_WE_HAVE_INSTRUCTIONS      = 0x100 ,
+    TTY_GLYF_USE_MY_METRICS            = 0x200 ,
+    TTY_GLYF_OVERLAP_COMPOUND          = 0x400 ,
+    TTY_GLYF_SCALED_COMPONENT_OFFSET   = 0x800 ,
+    TTY_GLYF_UNSCALED_COMPONENT_OFFSET = 0x1000,
+};
+
 static TTY_U16 tty_get_glyph_index_format_4(TTY_U8* subtable, TTY_U32 cp) {
     #define TTY_GET_FORMAT_4_END_CODE(index) tty_get_u16(subtable + 14 + 2 * (index))
     
@@ -2998,82 +5366,316 @@ static TTY_U32 tty_get_glyph_index_format_6(TTY_U8* subtable, TTY_U32 cp) {
 }
 
 static TTY_U32 tty_get_glyph_index_format_12(TTY_U8* subtable, TTY_U32 cp) {
-    TTY_U32 numGroups = tty_get_u32(subtable + 12);
-    for (TTY_U64 i = 0; i < numGroups; i++) {
-        TTY_U8* group   = subtable + 16 + i * 12;
+    // The groups are sorted by start code point. If groups overlap, the code
+    // point maps to whichever covering group the search reaches first. The
+    // page table is built with this function, so it resolves overlaps the
+    // same way.
+    TTY_U32 left  = 0;
+    TTY_U32 right = tty_get_u32(subtable + 12);
+
+    while (left < right) {
+        TTY_U32 mid     = left + (right - left) / 2;
+        TTY_U8* group   = subtable + 16 + mid * 12;
         TTY_U32 cpStart = tty_get_u32(group);
-        TTY_U32 cpEnd   = tty_get_u32(group + 4);
-        if (cp >= cpStart && cp <= cpEnd) {
+        
+        if (cp < cpStart) {
+            right = mid;
+        }
+        else if (cp > tty_get_u32(group + 4)) {
+            left = mid + 1;
+        }
+        else {
             TTY_U32 startId = tty_get_u32(group + 8);
             return startId + cp - cpStart;
         }
     }
+
     return 0;
 }
 
-static TTY_U8* tty_get_glyf_data_block(TTY_Font* font, TTY_U32 glyphIdx) {
-    #define TTY_GET_OFF_16(idx)\
-        (tty_get_u16(font->fileData + font->loca.off + (2 * (idx))) * 2)
-
-    #define TTY_GET_OFF_32(idx)\
-        tty_get_u32(font->fileData + font->loca.off + (4 * (idx)))
-
-    TTY_S16 version = tty_get_s16(font->fileData + font->head.off + 50);
+static TTY_U8* tty_get_glyf_data_block(TTY_Font* font, TTY_U32 glyphIdx, TTY_U32* size) {
     TTY_U32 blockOff;
     TTY_U32 nextBlockOff;
 
-    if (glyphIdx == font->numGlyphs - 1u) {
-        blockOff = version == 0 ? TTY_GET_OFF_16(glyphIdx) : TTY_GET_OFF_32(glyphIdx);
-        return font->fileData + font->glyf.off + blockOff;
-    }
+    if (font->glyfOffsets != NULL) {
+        blockOff = font->glyfOffsets[glyphIdx];
 
-    if (version == 0) {
-        blockOff     = TTY_GET_OFF_16(glyphIdx);
-        nextBlockOff = TTY_GET_OFF_16(glyphIdx + 1);
+        if (glyphIdx == font->numGlyphs - 1u) {
+            nextBlockOff = font->glyf.size;
+        }
+        else {
+            nextBlockOff = font->glyfOffsets[glyphIdx + 1];
+        }
     }
     else {
-        blockOff     = TTY_GET_OFF_32(glyphIdx);
-        nextBlockOff = TTY_GET_OFF_32(glyphIdx + 1);
+        blockOff = tty_read_glyf_offset(font, glyphIdx);
+
+        if (glyphIdx == font->numGlyphs - 1u) {
+            nextBlockOff = font->glyf.size;
+        }
+        else {
+            nextBlockOff = tty_read_glyf_offset(font, glyphIdx + 1);
+        }
     }
     
-    if (blockOff == nextBlockOff) {
+    if (blockOff >= nextBlockOff) {
         // "If a glyph has no outline, then loca[n] = loca [n+1]"
+        *size = 0;
         return NULL;
     }
 
+    *size = nextBlockOff - blockOff;
     return font->fileData + font->glyf.off + blockOff;
-    
-    #undef TTY_GET_OFF_16
-    #undef TTY_GET_OFF_32
 }
 
-TTY_Error tty_get_glyph_index(TTY_Font* font, TTY_U32 codePoint, TTY_U32* idx) {
+static TTY_Bool tty_parse_composite_component(TTY_U8* glyfBlock, TTY_U32 glyfSize, TTY_U32 off, TTY_Composite_Component* component) {
+    if (off + 4 > glyfSize) {
+        return TTY_FALSE;
+    }
+
+    component->flags    = tty_get_u16(glyfBlock + off);
+
+    {
+        TTY_U32 size = 4;
+
+        size += component->flags & TTY_GLYF_ARG_1_AND_2_ARE_WORDS ? 4 : 2;
+
+        if (component->flags & TTY_GLYF_WE_HAVE_A_SCALE) {
+            size += 2;
+        }
+        else if (component->flags & TTY_GLYF_WE_HAVE_AN_X_AND_Y_SCALE) {
+            size += 4;
+        }
+        else if (component->flags & TTY_GLYF_WE_HAVE_A_TWO_BY_TWO) {
+            size += 8;
+        }
+
+        if (off + size > glyfSize) {
+            return TTY_FALSE;
+        }
+    }
+
+    component->glyphIdx = tty_get_u16(glyfBlock + off + 2);
+    off += 4;
+
+    // The arguments are offsets if they are xy values, otherwise they are
+    // unsigned point indices
+    if (component->flags & TTY_GLYF_ARG_1_AND_2_ARE_WORDS) {
+        if (component->flags & TTY_GLYF_ARGS_ARE_XY_VALUES) {
+            component->arg1 = tty_get_s16(glyfBlock + off);
+            component->arg2 = tty_get_s16(glyfBlock + off + 2);
+        }
+        else {
+            component->arg1 = tty_get_u16(glyfBlock + off);
+            component->arg2 = tty_get_u16(glyfBlock + off + 2);
+        }
+        off += 4;
+    }
+    else {
+        if (component->flags & TTY_GLYF_ARGS_ARE_XY_VALUES) {
+            component->arg1 = (TTY_S8)glyfBlock[off];
+            component->arg2 = (TTY_S8)glyfBlock[off + 1];
+        }
+        else {
+            component->arg1 = glyfBlock[off];
+            component->arg2 = glyfBlock[off + 1];
+        }
+        off += 2;
+    }
+
+    component->transform[0] = 0x4000;
+    component->transform[1] = 0;
+    component->transform[2] = 0;
+    component->transform[3] = 0x4000;
+
+    if (component->flags & TTY_GLYF_WE_HAVE_A_SCALE) {
+        component->transform[0] = tty_get_s16(glyfBlock + off);
+        component->transform[3] = component->transform[0];
+        off += 2;
+    }
+    else if (component->flags & TTY_GLYF_WE_HAVE_AN_X_AND_Y_SCALE) {
+        component->transform[0] = tty_get_s16(glyfBlock + off    );
+        component->transform[3] = tty_get_s16(glyfBlock + off + 2);
+        off += 4;
+    }
+    else if (component->flags & TTY_GLYF_WE_HAVE_A_TWO_BY_TWO) {
+        component->transform[0] = tty_get_s16(glyfBlock + off    );
+        component->transform[1] = tty_get_s16(glyfBlock + off + 2);
+        component->transform[2] = tty_get_s16(glyfBlock + off + 4);
+        component->transform[3] = tty_get_s16(glyfBlock + off + 6);
+        off += 8;
+    }
+
+    component->endOff = off;
+    return TTY_TRUE;
+}
+
+static TTY_Error tty_build_composite_table(TTY_Font* font) {
+    TTY_U32 numComponents = 0;
+
+    font->componentStarts = (TTY_U32*)malloc((font->numGlyphs + 1) * sizeof(TTY_U32));
+    if (font->componentStarts == NULL) {
+        return TTY_ERROR_OUT_OF_MEMORY;
+    }
+
+    // Count the components of every glyph. A simple or empty glyph has none,
+    // and neither does a composite glyph whose records run past its block,
+    // which fails to render.
+    for (TTY_U32 i = 0; i < font->numGlyphs; i++) {
+        TTY_U32 glyfSize;
+        TTY_U8* glyfBlock = tty_get_glyf_data_block(font, i, &glyfSize);
+        
+        font->componentStarts[i] = numComponents;
+
+        if (glyfBlock != NULL && tty_get_s16(glyfBlock) < 0) {
+            TTY_Composite_Component component;
+            TTY_U32                 off = 10;
+
+            do {
+                if (!tty_parse_composite_component(glyfBlock, glyfSize, off, &component)) {
+                    numComponents = font->componentStarts[i];
+                    break;
+                }
+                off = component.endOff;
+                numComponents++;
+            } while (component.flags & TTY_GLYF_MORE_COMPONENTS);
+        }
+    }
+
+    font->componentStarts[font->numGlyphs] = numComponents;
+    TTY_PROFILE_ADD(font->stats.bytesAllocated, (font->numGlyphs + 1) * sizeof(TTY_U32));
+
+    if (numComponents == 0) {
+        return TTY_ERROR_NONE;
+    }
+
+    font->components = (TTY_Composite_Component*)malloc(numComponents * sizeof(TTY_Composite_Component));
+    if (font->components == NULL) {
+        return TTY_ERROR_OUT_OF_MEMORY;
+    }
+    TTY_PROFILE_ADD(font->stats.bytesAllocated, numComponents * sizeof(TTY_Composite_Component));
+
+    for (TTY_U32 i = 0; i < font->numGlyphs; i++) {
+        TTY_U32 glyfSize;
+        TTY_U8* glyfBlock = tty_get_glyf_data_block(font, i, &glyfSize);
+        TTY_U32 off       = 10;
+        
+        for (TTY_U32 j = font->componentStarts[i]; j < font->componentStarts[i + 1]; j++) {
+            tty_parse_composite_component(glyfBlock, glyfSize, off, font->components + j);
+            off = font->components[j].endOff;
+        }
+    }
+
+    return TTY_ERROR_NONE;
+}
+
+static TTY_U32 tty_get_glyph_index_uncached(TTY_Font* font, TTY_U32 codePoint) {
     TTY_U8* subtable = font->fileData + font->cmap.off + font->encoding.off;
     
-    *idx = 0;
-    
     switch (font->encoding.format) {
         case 4:
-            *idx = tty_get_glyph_index_format_4(subtable, codePoint);
-            break;
+            return tty_get_glyph_index_format_4(subtable, codePoint);
         case 6:
-            *idx = tty_get_glyph_index_format_6(subtable, codePoint);
-            break;
+            return tty_get_glyph_index_format_6(subtable, codePoint);
         case 12:
-            *idx = tty_get_glyph_index_format_12(subtable, codePoint);
-            break;
+            return tty_get_glyph_index_format_12(subtable, codePoint);
+    }
+    
+    return 0;
+}
+
+static TTY_U32 tty_lookup_glyph_index(TTY_Font* font, TTY_U32 codePoint) {
+    if (font->bmpGlyphIndices != NULL && codePoint < TTY_CMAP_BMP_SIZE) {
+        return font->bmpGlyphIndices[codePoint];
+    }
+    
+    if (font->cmapPageDir != NULL) {
+        if (codePoint >= TTY_CMAP_NUM_PAGES * TTY_CMAP_PAGE_SIZE) {
+            return 0;
+        }
+        TTY_U32 page = font->cmapPageDir[codePoint / TTY_CMAP_PAGE_SIZE];
+        return font->cmapPages[page * TTY_CMAP_PAGE_SIZE + codePoint % TTY_CMAP_PAGE_SIZE];
     }
     
+    return tty_get_glyph_index_uncached(font, codePoint);
+}
+
+TTY_Error tty_get_glyph_index(TTY_Font* font, TTY_U32 codePoint, TTY_U32* idx) {
+    *idx = tty_lookup_glyph_index(font, codePoint);
     return *idx == 0 ? TTY_ERROR_UNSUPPORTED_FEATURE : TTY_ERROR_NONE;
 }
 
+// Counts the glyph indices that are 0, i.e. the code points that are not in
+// the font
+static TTY_U32 tty_count_missing_glyphs(const TTY_U32* indices, TTY_U32 count) {
+    TTY_U32 numMissing = 0;
+    TTY_U32 i          = 0;
+
+#ifdef TTY_SSE2
+    {
+        // Each lane of the compare is -1 for a missing glyph, so subtracting
+        // it counts the missing glyphs in 4 lanes that are summed at the end.
+        // The lanes can't overflow since count is a TTY_U32.
+        __m128i zero   = _mm_setzero_si128();
+        __m128i counts = _mm_setzero_si128();
+
+        for (; i + 4 <= count; i += 4) {
+            __m128i idxs = _mm_loadu_si128((const __m128i*)(indices + i));
+            counts = _mm_sub_epi32(counts, _mm_cmpeq_epi32(idxs, zero));
+        }
+
+        TTY_U32 lanes[4];
+        _mm_storeu_si128((__m128i*)lanes, counts);
+        numMissing = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+    }
+#endif
+
+    for (; i < count; i++) {
+        numMissing += indices[i] == 0;
+    }
+
+    return numMissing;
+}
+
+TTY_Error tty_get_glyph_indices_utf8(TTY_Font* font, const char* text, TTY_U32 len, TTY_U32* indices, TTY_U32* numIndices, TTY_U32* numMissing) {
+    const TTY_U8* data  = (const TTY_U8*)text;
+    TTY_U32       off   = 0;
+    TTY_U32       count = 0;
+
+    while (off < len) {
+        TTY_U32 asciiEnd = off + tty_get_ascii_run_length(data + off, len - off);
+
+        if (font->bmpGlyphIndices != NULL) {
+            for (; off < asciiEnd; off++) {
+                indices[count++] = font->bmpGlyphIndices[data[off]];
+            }
+        }
+        else {
+            for (; off < asciiEnd; off++) {
+                indices[count++] = tty_lookup_glyph_index(font, data[off]);
+            }
+        }
+
+        if (off < len) {
+            TTY_U32 cp;
+            off += tty_decode_utf8(data + off, len - off, &cp);
+            indices[count++] = tty_lookup_glyph_index(font, cp);
+        }
+    }
+
+    *numIndices = count;
+    *numMissing = tty_count_missing_glyphs(indices, count);
+    return TTY_ERROR_NONE;
+}
+
 TTY_Error tty_glyph_init(TTY_Font* font, TTY_Glyph* glyph, TTY_U32 idx) {
     // Note: Glyph advance, offset, and size are calculated when the glyph is rendered
+    //       or its metrics are requested
     
     memset(glyph, 0, sizeof(TTY_Glyph));
 
     glyph->idx       = idx;
-    glyph->glyfBlock = tty_get_glyf_data_block(font, idx);
+    glyph->glyfBlock = tty_get_glyf_data_block(font, idx, &glyph->glyfSize);
     
     // If glyfBlock is NULL, the glyph is an empty glyph (i.e. space)
     if (glyph->glyfBlock != NULL) {
@@ -3121,25 +5723,10 @@ enum {
     TTY_GLYF_ON_CURVE_POINT = 0x01,
     TTY_GLYF_X_SHORT_VECTOR = 0x02,
     TTY_GLYF_Y_SHORT_VECTOR = 0x04,
-    TTY_GLYF_REPEAT_FLAG    = 0x08,
-    TTY_GLYF_X_DUAL         = 0x10, /* X_IS_SAME_OR_POSITIVE_X_SHORT_VECTOR */
-    TTY_GLYF_Y_DUAL         = 0x20, /* Y_IS_SAME_OR_POSITIVE_Y_SHORT_VECTOR */
-    TTY_GLYF_OVERLAP_SIMPLE = 0x40,
-};
-
-enum {
-    TTY_GLYF_ARG_1_AND_2_ARE_WORDS     = 0x01  ,
-    TTY_GLYF_ARGS_ARE_XY_VALUES        = 0x02  ,
-    TTY_GLYF_ROUND_XY_TO_GRID          = 0x04  ,
-    TTY_GLYF_WE_HAVE_A_SCALE           = 0x08  ,
-    TTY_GLYF_MORE_COMPONENTS           = 0x20  ,
-    TTY_GLYF_WE_HAVE_AN_X_AND_Y_SCALE  = 0x40  ,
-    TTY_GLYF_WE_HAVE_A_TWO_BY_TWO      = 0x80  ,
-    TTY_GLYF_WE_HAVE_INSTRUCTIONS      = 0x100 ,
-    TTY_GLYF_USE_MY_METRICS            = 0x200 ,
-    TTY_GLYF_OVERLAP_COMPOUND          = 0x400 ,
-    TTY_GLYF_SCALED_COMPONENT_OFFSET   = 0x800 ,
-    TTY_GLYF_UNSCALED_COMPONENT_OFFSET = 0x1000,
+    TTY_GLYF_REPEAT_FLAG    = 0x08,
+    TTY_GLYF_X_DUAL         = 0x10, /* X_IS_SAME_OR_POSITIVE_X_SHORT_VECTOR */
+    TTY_GLYF_Y_DUAL         = 0x20, /* Y_IS_SAME_OR_POSITIVE_Y_SHORT_VECTOR */
+    TTY_GLYF_OVERLAP_SIMPLE = 0x40,
 };
 
 typedef struct {
@@ -3177,73 +5764,64 @@ typedef struct {
     TTY_Active_Edge*   reusableEdges;
 } TTY_Active_Edge_List;
 
+/* A glyph's image in an embedded bitmap strike */
+typedef struct {
+    TTY_U8*   data;           /* Rows of pixels, most significant bit first */
+    TTY_U8    width;
+    TTY_U8    height;
+    TTY_S8    bearingX;
+    TTY_S8    bearingY;
+    TTY_U8    advance;
+    TTY_U8    vertAdvance;    /* Only valid if hasVertAdvance is true */
+    TTY_U8    bitDepth;
+    TTY_Bool  hasVertAdvance;
+    TTY_Bool  isBitAligned;   /* Rows aren't padded to a byte boundary */
+} TTY_Bitmap_Glyph;
+
 
-static TTY_Error tty_add_glyph_points_to_zone_1(TTY_Font* font, TTY_Instance* instance, TTY_Glyph* glyph);
+static TTY_Error tty_add_glyph_points_to_zone_1(TTY_Font* font, TTY_Instance* instance, TTY_Render_Context* render, TTY_Glyph* glyph, TTY_U32 depth);
 
 static TTY_U16 tty_get_glyph_advance_width(TTY_Font* font, TTY_U32 glyphIdx) {
-    TTY_U8* hmtxData    = font->fileData + font->hmtx.off;
-    TTY_U16 numHMetrics = tty_get_u16(font->fileData + font->hhea.off + 34);
-    if (numHMetrics == 0) {
-        TTY_ASSERT(0);
-        return 0;
+    if (font->horMetrics != NULL) {
+        return font->horMetrics[glyphIdx].advanceWidth;
     }
-    if (glyphIdx >= numHMetrics) {
-        // "As an optimization, the number of records can be less than the 
-        // number of glyphs, in which case the advance width value of the 
-        // last record applies to all remaining glyph IDs."
-        glyphIdx = numHMetrics - 1;
-    }
-    return tty_get_u16(hmtxData + 4 * glyphIdx);
+    return tty_read_glyph_advance_width(font, glyphIdx);
 }
 
-static TTY_S32 tty_get_glyph_advance_height(TTY_Font* font) {
-    if (font->vmtx.exists) {
-        // TODO: Get from vmtx
-        TTY_ASSERT(TTY_FALSE);
+static TTY_S32 tty_get_glyph_advance_height(TTY_Font* font, TTY_U32 glyphIdx) {
+    if (font->vertMetrics != NULL) {
+        return font->vertMetrics[glyphIdx].advanceHeight;
     }
-    
-    if (font->OS2.exists) {
-        TTY_U8* os2Data   = font->fileData + font->OS2.off;
-        TTY_S16 ascender  = tty_get_s16(os2Data + 68);
-        TTY_S16 descender = tty_get_s16(os2Data + 70);
-        return ascender - descender;
+    if (font->vmtx.exists) {
+        return tty_read_glyph_advance_height(font, glyphIdx);
     }
-    
-    // Use hhea
-    return font->ascender - font->descender;
+    return font->typoAscender - font->typoDescender;
 }
 
 static TTY_S16 tty_get_glyph_left_side_bearing(TTY_Font* font, TTY_U32 glyphIdx) {
-    TTY_U8* hmtxData    = font->fileData + font->hmtx.off;
-    TTY_U16 numHMetrics = tty_get_u16(font->fileData + font->hhea.off + 34);
-    if (glyphIdx < numHMetrics) {
-        return tty_get_s16(hmtxData + 4 * glyphIdx + 2);
+    if (font->horMetrics != NULL) {
+        return font->horMetrics[glyphIdx].leftSideBearing;
     }
-    return tty_get_s16(hmtxData + 4 * numHMetrics + 2 * (glyphIdx - numHMetrics));
+    return tty_read_glyph_left_side_bearing(font, glyphIdx);
 }
 
-static TTY_S32 tty_get_glyph_top_side_bearing(TTY_Font* font, TTY_S16 yMax) {
-    if (font->vmtx.exists) {
-        // TODO: Get from vmtx
-        TTY_ASSERT(TTY_FALSE);
+static TTY_S32 tty_get_glyph_top_side_bearing(TTY_Font* font, TTY_U32 glyphIdx, TTY_S16 yMax) {
+    if (font->vertMetrics != NULL) {
+        return font->vertMetrics[glyphIdx].topSideBearing;
     }
-
-    if (font->OS2.exists) {
-        TTY_S16 ascender = tty_get_s16(font->fileData + font->OS2.off + 68);
-        return ascender - yMax;
+    if (font->vmtx.exists) {
+        return tty_read_glyph_top_side_bearing(font, glyphIdx);
     }
-
-    // Use hhea
-    return font->ascender - yMax;
+    return font->typoAscender - yMax;
 }
 
 static void tty_get_phantom_points_and_types(TTY_Font* font, TTY_Glyph* glyph, TTY_V2* phantomPoints, TTY_U8* phantomTypes) {
     TTY_S16 xMin = tty_get_s16(glyph->glyfBlock + 2);
     TTY_S16 yMax = tty_get_s16(glyph->glyfBlock + 8);
     TTY_U16 xAdv = tty_get_glyph_advance_width(font, glyph->idx);
-    TTY_S32 yAdv = tty_get_glyph_advance_height(font);
+    TTY_S32 yAdv = tty_get_glyph_advance_height(font, glyph->idx);
     TTY_S16 lsb  = tty_get_glyph_left_side_bearing(font, glyph->idx);
-    TTY_S32 tsb  = tty_get_glyph_top_side_bearing(font, yMax);
+    TTY_S32 tsb  = tty_get_glyph_top_side_bearing(font, glyph->idx, yMax);
 
     phantomPoints[0].x = xMin - lsb;
     phantomPoints[0].y = 0;
@@ -3276,227 +5854,351 @@ static void tty_round_phantom_points(TTY_V2* phantomPoints) {
     phantomPoints[3].y = tty_f26dot6_round(phantomPoints[3].y);
 }
 
-static void tty_execute_next_glyph_program_ins(TTY_Program_Context* ctx) {
-    TTY_U8 ins = tty_ins_stream_next(&ctx->stream);
+// Returns the decoded glyph program of the given glyph, decoding it and 
+// building its control flow tables the first time the glyph is hinted with 
+// this render context. The tables only depend on the font's bytes, so they are
+// kept for the lifetime of the render context.
+static TTY_Error tty_get_glyph_program(TTY_Render_Context* render, TTY_Glyph* glyph, TTY_U8* insBuff, TTY_U32 insCount, TTY_Program** program) {
+    *program = render->glyphPrograms + glyph->idx;
+
+    if ((*program)->ops == NULL) {
+        TTY_U32 numOps    = 0;
+        TTY_U32 numValues = 0;
+        tty_decode_program(insBuff, insCount, NULL, NULL, &numOps, &numValues);
+
+        // The byte to op table needs one more entry for the end of the program
+        size_t off            = 0;
+        size_t totalSize      = 0;
+        size_t opsSize        = tty_calc_mem_size(&totalSize, numOps         * sizeof(TTY_Op) , TTY_ALIGN_OF(TTY_S32));
+        size_t valuesSize     = tty_calc_mem_size(&totalSize, numValues      * sizeof(TTY_S32), TTY_ALIGN_OF(TTY_U32));
+        size_t branchOffsSize = tty_calc_mem_size(&totalSize, numOps         * sizeof(TTY_U32), 1);
+        /* size_t opIdxsSize = */tty_calc_mem_size(&totalSize, (insCount + 1) * sizeof(TTY_U32), 1);
+
+        TTY_U8* mem = (TTY_U8*)malloc(totalSize);
+        if (mem == NULL) {
+            return TTY_ERROR_OUT_OF_MEMORY;
+        }
 
-    if (tty_try_execute_shared_ins(ctx, ins)) {
-        return;
+        {
+            TTY_Op*  ops        = (TTY_Op*) (mem);
+            TTY_S32* values     = (TTY_S32*)(mem + (off += opsSize));
+            TTY_U32* branchOffs = (TTY_U32*)(mem + (off += valuesSize));
+            TTY_U32* opIdxs     = (TTY_U32*)(mem + (off += branchOffsSize));
+            tty_program_init(*program, insBuff, insCount, ops, values, branchOffs, opIdxs);
+        }
     }
 
-    switch (ins) {
-        case TTY_ALIGNRP:
-            tty_ALIGNRP(ctx);
-            return;
-        case TTY_DELTAP1:
-            tty_DELTAP1(ctx);
-            return;
-        case TTY_DELTAP2:
-            tty_DELTAP2(ctx);
-            return;
-        case TTY_DELTAP3:
-            tty_DELTAP3(ctx);
-            return;
-        case TTY_IP:
-            tty_IP(ctx);
-            return;
-        case TTY_ISECT:
-            tty_ISECT(ctx);
-            return;
-        case TTY_SHPIX:
-            tty_SHPIX(ctx);
-            return;
-        case TTY_SMD:
-            tty_SMD(ctx);
-            return;
-        case TTY_SRP0:
-            tty_SRP0(ctx);
-            return;
-        case TTY_SRP1:
-            tty_SRP1(ctx);
-            return;
-        case TTY_SRP2:
-            tty_SRP2(ctx);
-            return;
-        case TTY_SZPS:
-            tty_SZPS(ctx);
-            return;
-        case TTY_SZP0:
-            tty_SZP0(ctx);
-            return;
-        case TTY_SZP1:
-            tty_SZP1(ctx);
-            return;
-        case TTY_SZP2:
-            tty_SZP2(ctx);
-            return;
-    }
+    return TTY_ERROR_NONE;
+}
 
-    if (ins >= TTY_GC && ins <= TTY_GC_MAX) {
-        tty_GC(ctx, ins);
-    }
-    else if (ins >= TTY_IUP && ins <= TTY_IUP_MAX) {
-        tty_IUP(ctx, ins);
-    }
-    else if (ins >= TTY_MD && ins <= TTY_MD_MAX) {
-        tty_MD(ctx, ins);
-    }
-    else if (ins >= TTY_MDAP && ins <= TTY_MDAP_MAX) {
-        tty_MDAP(ctx, ins);
-    }
-    else if (ins >= TTY_MDRP && ins <= TTY_MDRP_MAX) {
-        tty_MDRP(ctx, ins);
-    }
-    else if (ins >= TTY_MIAP && ins <= TTY_MIAP_MAX) {
-        tty_MIAP(ctx, ins);
-    }
-    else if (ins >= TTY_MIRP && ins <= TTY_MIRP_MAX) {
-        tty_MIRP(ctx, ins);
-    }
-    else if (ins >= TTY_SDPVTL && ins <= TTY_SDPVTL_MAX) {
-        tty_SDPVTL(ctx, ins);
-    }
-    else if (ins >= TTY_SFVTL && ins <= TTY_SFVTL_MAX) {
-        tty_SFVTL(ctx, ins);
-    }
-    else if (ins >= TTY_SHP && ins <= TTY_SHP_MAX) {
-        tty_SHP(ctx, ins);
-    }
-    else {
-        TTY_LOG_UNKNOWN_INS(ins);
-        ctx->foundUnknownIns = TTY_TRUE;
+static TTY_Error tty_execute_glyph_program(TTY_Font* font, TTY_Instance* instance, TTY_Render_Context* render, TTY_Glyph* glyph, TTY_U8* insBuff, TTY_U32 insCount) {
+    TTY_Compiled_Program compiled = font->compiledGlyphs != NULL ? font->compiledGlyphs[glyph->idx] : NULL;
+    TTY_Program*         program  = NULL;
+
+    if (compiled == NULL) {
+        TTY_Error error = tty_get_glyph_program(render, glyph, insBuff, insCount, &program);
+        if (error != TTY_ERROR_NONE) {
+            return error;
+        }
     }
-}
 
-static TTY_Error tty_execute_glyph_program(TTY_Font* font, TTY_Instance* instance, TTY_Glyph* glyph, TTY_U8* insBuff, TTY_U32 insCount) {
-    tty_reset_graphics_state(&font->hint.gs, &font->hint.zone1);
-    tty_interp_stack_clear(&font->hint.stack);
+    tty_reset_graphics_state(&render->gs, &render->zone1);
+    tty_interp_stack_clear(&render->stack);
 
     {
         TTY_Program_Context ctx;
         ctx.font                    = font;
         ctx.instance                = instance;
         ctx.glyph                   = glyph;
+        ctx.render                  = render;
+        ctx.cvt                     = &render->cvt;
+        ctx.storage                 = &render->storage;
+        ctx.zone0                   = &render->zone0;
         ctx.iupState                = TTY_IUP_STATE_DEFAULT;
         ctx.foundUnknownIns         = TTY_FALSE;
-        ctx.stream.execute_next_ins = tty_execute_next_glyph_program_ins;
-        ctx.stream.buff             = insBuff;
-        ctx.stream.cap              = insCount;
-        ctx.stream.off              = 0;
+        TTY_PROFILE_INIT_CTX(ctx);
 
         TTY_LOG_PROGRAM("Glyph Program");
-        return tty_execute_program(&ctx);
+
+        if (compiled != NULL) {
+            ctx.program   = NULL;
+            ctx.opIdx     = 0;
+            ctx.firstCode = TTY_OP_PUSH;
+            ctx.lastCode  = TTY_OP_LAST_GLYPH;
+            return compiled(&ctx, &font->compiledRuntime, &render->stack) ? TTY_ERROR_NONE : TTY_ERROR_UNKNOWN_INSTRUCTION;
+        }
+        return tty_execute_program(&ctx, program, TTY_OP_PUSH, TTY_OP_LAST_GLYPH);
     }
 }
 
-static TTY_S16 tty_get_next_simple_glyph_coord_off(TTY_U8** data, TTY_U8 dualFlag, TTY_U8 shortFlag, TTY_U8 flags) {
-    TTY_S16 coord;
-    if (flags & shortFlag) {
-        coord = !(flags & dualFlag) ? -(**data) : **data;
-        (*data)++;
+// Reads the coordinate delta at `off` without branching on the flag. Reads
+// are clamped to the last byte of the coordinate data.
+static TTY_S32 tty_read_simple_glyph_delta(TTY_U8* data, TTY_U32 last, TTY_U32 off, TTY_U8 flag, TTY_U8 shortFlag, TTY_U8 dualFlag) {
+    TTY_S32 isShort = (flag & shortFlag) != 0;
+    TTY_S32 isDual  = (flag & dualFlag)  != 0;
+    TTY_S32 isWord  = !isShort & !isDual;
+    TTY_S32 byte0   = data[TTY_MIN(off,     last)];
+    TTY_S32 byte1   = data[TTY_MIN(off + 1, last)];
+    TTY_S32 byteVal = (byte0 ^ -!isDual) + !isDual; // Negated if isDual is not set
+    TTY_S32 wordVal = (TTY_S16)(byte0 << 8 | byte1);
+    return (byteVal & -isShort) | (wordVal & -isWord);
+}
+
+#ifdef TTY_SSE2
+// Calculates the deltas of 16 coordinates as 16-bit lanes, 8 in each vector.
+// byte0 and byte1 are the two bytes at each coordinate's offset and isShort and
+// isDual are the coordinates' flags as byte masks.
+static void tty_calc_simple_glyph_deltas_sse2(TTY_U8* byte0, TTY_U8* byte1, __m128i isShort, __m128i isDual, __m128i* deltas) {
+    __m128i b0     = _mm_loadu_si128((const __m128i*)byte0);
+    __m128i b1     = _mm_loadu_si128((const __m128i*)byte1);
+    __m128i zeroes = _mm_setzero_si128();
+    __m128i isWord = _mm_andnot_si128(_mm_or_si128(isShort, isDual), _mm_set1_epi8(-1));
+
+    for (TTY_U32 i = 0; i < 2; i++) {
+        __m128i bytes  = i == 0 ? _mm_unpacklo_epi8(b0, zeroes)    : _mm_unpackhi_epi8(b0, zeroes);
+        __m128i words  = i == 0 ? _mm_unpacklo_epi8(b1, b0)        : _mm_unpackhi_epi8(b1, b0);
+        __m128i shorts = i == 0 ? _mm_unpacklo_epi8(isShort, isShort) : _mm_unpackhi_epi8(isShort, isShort);
+        __m128i duals  = i == 0 ? _mm_unpacklo_epi8(isDual, isDual)   : _mm_unpackhi_epi8(isDual, isDual);
+        __m128i wordM  = i == 0 ? _mm_unpacklo_epi8(isWord, isWord)   : _mm_unpackhi_epi8(isWord, isWord);
+
+        // Short vectors are negative unless the dual flag is set
+        __m128i negate = _mm_andnot_si128(duals, _mm_set1_epi16(-1));
+        bytes = _mm_sub_epi16(_mm_xor_si128(bytes, negate), negate);
+
+        deltas[i] = _mm_or_si128(_mm_and_si128(bytes, shorts), _mm_and_si128(words, wordM));
     }
-    else if (flags & dualFlag) {
-        coord = 0;
+}
+#endif
+
+// Decodes the coordinates of every outline point. The flags have already been
+// expanded into a flat array, so the size of each coordinate only depends on
+// its flag. The byte offset of each coordinate is the prefix sum of the sizes
+// of the coordinates before it, and each position is the prefix sum of the
+// deltas up to it. With SSE2, points are decoded 16 at a time: the offsets
+// of the block are computed together in byte lanes, each delta is read from
+// its offset (SSE2 has no gather), and the x and y positions of 2 points at a
+// time are summed in 32-bit lanes.
+static void tty_decode_simple_glyph_coords(TTY_U8* flags, TTY_U32 numPoints, TTY_U8* xData, TTY_U32 xSize, TTY_U8* yData, TTY_U32 ySize, TTY_V2* points) {
+    // An axis without data only has zero deltas, but its reads still need a
+    // byte to read
+    TTY_U8 zero = 0;
+    if (xSize == 0) {
+        xData = &zero;
+        xSize = 1;
+    }
+    if (ySize == 0) {
+        yData = &zero;
+        ySize = 1;
+    }
+
+    TTY_U32 i    = 0;
+    TTY_U32 xOff = 0;
+    TTY_U32 yOff = 0;
+    TTY_V2  pos;
+    pos.x = 0;
+    pos.y = 0;
+
+#ifdef TTY_SSE2
+    {
+        __m128i xShortFlag = _mm_set1_epi8(TTY_GLYF_X_SHORT_VECTOR);
+        __m128i yShortFlag = _mm_set1_epi8(TTY_GLYF_Y_SHORT_VECTOR);
+        __m128i xDualFlag  = _mm_set1_epi8(TTY_GLYF_X_DUAL);
+        __m128i yDualFlag  = _mm_set1_epi8(TTY_GLYF_Y_DUAL);
+        __m128i one        = _mm_set1_epi8(1);
+        __m128i two        = _mm_set1_epi8(2);
+        __m128i carry      = _mm_setzero_si128();
+
+        for (; i + 16 <= numPoints; i += 16) {
+            __m128i f      = _mm_loadu_si128((const __m128i*)(flags + i));
+            __m128i xShort = _mm_cmpeq_epi8(_mm_and_si128(f, xShortFlag), xShortFlag);
+            __m128i yShort = _mm_cmpeq_epi8(_mm_and_si128(f, yShortFlag), yShortFlag);
+            __m128i xDual  = _mm_cmpeq_epi8(_mm_and_si128(f, xDualFlag),  xDualFlag);
+            __m128i yDual  = _mm_cmpeq_epi8(_mm_and_si128(f, yDualFlag),  yDualFlag);
+
+            // 1 byte for short vectors, 0 for repeated coordinates, otherwise 2
+            __m128i xSizes = _mm_or_si128(_mm_and_si128(xShort, one), _mm_andnot_si128(_mm_or_si128(xShort, xDual), two));
+            __m128i ySizes = _mm_or_si128(_mm_and_si128(yShort, one), _mm_andnot_si128(_mm_or_si128(yShort, yDual), two));
+
+            // Inclusive prefix sums, which are at most 32 so they fit in bytes
+            __m128i xEnds = _mm_add_epi8(xSizes, _mm_slli_si128(xSizes, 1));
+            __m128i yEnds = _mm_add_epi8(ySizes, _mm_slli_si128(ySizes, 1));
+            xEnds = _mm_add_epi8(xEnds, _mm_slli_si128(xEnds, 2));
+            yEnds = _mm_add_epi8(yEnds, _mm_slli_si128(yEnds, 2));
+            xEnds = _mm_add_epi8(xEnds, _mm_slli_si128(xEnds, 4));
+            yEnds = _mm_add_epi8(yEnds, _mm_slli_si128(yEnds, 4));
+            xEnds = _mm_add_epi8(xEnds, _mm_slli_si128(xEnds, 8));
+            yEnds = _mm_add_epi8(yEnds, _mm_slli_si128(yEnds, 8));
+
+            TTY_U8 xStarts[16];
+            TTY_U8 yStarts[16];
+            _mm_storeu_si128((__m128i*)xStarts, _mm_sub_epi8(xEnds, xSizes));
+            _mm_storeu_si128((__m128i*)yStarts, _mm_sub_epi8(yEnds, ySizes));
+
+            // Gather the two bytes at each offset, the second byte is only
+            // used by words
+            TTY_U8 bytes[4][16];
+            for (TTY_U32 j = 0; j < 16; j++) {
+                TTY_U32 x = xOff + xStarts[j];
+                TTY_U32 y = yOff + yStarts[j];
+                bytes[0][j] = xData[TTY_MIN(x,     xSize - 1)];
+                bytes[1][j] = xData[TTY_MIN(x + 1, xSize - 1)];
+                bytes[2][j] = yData[TTY_MIN(y,     ySize - 1)];
+                bytes[3][j] = yData[TTY_MIN(y + 1, ySize - 1)];
+            }
+
+            __m128i xDeltas[2];
+            __m128i yDeltas[2];
+            tty_calc_simple_glyph_deltas_sse2(bytes[0], bytes[1], xShort, xDual, xDeltas);
+            tty_calc_simple_glyph_deltas_sse2(bytes[2], bytes[3], yShort, yDual, yDeltas);
+
+            // Each vector holds the x and y deltas of 2 points. Adding the
+            // vector shifted by one point and then the positions of the
+            // previous point gives the positions of both points.
+            for (TTY_U32 j = 0; j < 2; j++) {
+                __m128i xy[2];
+                xy[0] = _mm_unpacklo_epi16(xDeltas[j], yDeltas[j]);
+                xy[1] = _mm_unpackhi_epi16(xDeltas[j], yDeltas[j]);
+
+                for (TTY_U32 k = 0; k < 2; k++) {
+                    // Sign extend the 16-bit deltas
+                    __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(xy[k], xy[k]), 16);
+                    __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(xy[k], xy[k]), 16);
+                    TTY_V2* out = points + i + 8 * j + 4 * k;
+
+                    lo    = _mm_add_epi32(_mm_add_epi32(lo, _mm_slli_si128(lo, 8)), carry);
+                    carry = _mm_shuffle_epi32(lo, _MM_SHUFFLE(3, 2, 3, 2));
+                    hi    = _mm_add_epi32(_mm_add_epi32(hi, _mm_slli_si128(hi, 8)), carry);
+                    carry = _mm_shuffle_epi32(hi, _MM_SHUFFLE(3, 2, 3, 2));
+                    _mm_storeu_si128((__m128i*)(out),     lo);
+                    _mm_storeu_si128((__m128i*)(out + 2), hi);
+                }
+            }
+
+            xOff += (TTY_U32)_mm_extract_epi16(xEnds, 7) >> 8;
+            yOff += (TTY_U32)_mm_extract_epi16(yEnds, 7) >> 8;
+        }
+
+        pos.x = _mm_cvtsi128_si32(carry);
+        pos.y = _mm_cvtsi128_si32(_mm_srli_si128(carry, 4));
     }
-    else {
-        coord = tty_get_s16(*data);
-        (*data) += 2;
+#endif
+
+    for (; i < numPoints; i++) {
+        pos.x    += tty_read_simple_glyph_delta(xData, xSize - 1, xOff, flags[i], TTY_GLYF_X_SHORT_VECTOR, TTY_GLYF_X_DUAL);
+        pos.y    += tty_read_simple_glyph_delta(yData, ySize - 1, yOff, flags[i], TTY_GLYF_Y_SHORT_VECTOR, TTY_GLYF_Y_DUAL);
+        points[i] = pos;
+        xOff     += flags[i] & TTY_GLYF_X_SHORT_VECTOR ? 1 : flags[i] & TTY_GLYF_X_DUAL ? 0 : 2;
+        yOff     += flags[i] & TTY_GLYF_Y_SHORT_VECTOR ? 1 : flags[i] & TTY_GLYF_Y_DUAL ? 0 : 2;
     }
-    return coord;
 }
 
-static TTY_Error tty_add_simple_glyph_points_to_zone1(TTY_Font* font, TTY_Instance* instance, TTY_Glyph* glyph) {
-    font->hint.zone1.numOutlinePoints = tty_get_u16(glyph->glyfBlock + 8 + 2 * glyph->numContours) + 1;
-    font->hint.zone1.numPoints        = font->hint.zone1.numOutlinePoints + TTY_NUM_PHANTOM_POINTS;
-    font->hint.zone1.numEndPoints     = glyph->numContours;
+static void tty_decode_simple_glyph_points(TTY_Font* font, TTY_Render_Context* render, TTY_Glyph* glyph) {
+    render->zone1.numOutlinePoints = tty_get_u16(glyph->glyfBlock + 8 + 2 * glyph->numContours) + 1;
+    render->zone1.numPoints        = render->zone1.numOutlinePoints + TTY_NUM_PHANTOM_POINTS;
+    render->zone1.numEndPoints     = glyph->numContours;
 
-    TTY_U8* flagData, *xData, *yData;
+    // The flags are expanded into pointTypes, which is converted from glyf 
+    // flags into point types once the coordinates have been decoded
+    TTY_U8* flags = render->zone1.pointTypes;
+    TTY_U8* xData;
+    TTY_U32 xSize = 0;
+    TTY_U32 ySize = 0;
     
     {
-        // Calculate pointers to the glyph's flag data, x-coordinate data, and
-        // y-coordinate data
+        // Expand the repeated flags and calculate the sizes of the glyph's 
+        // x-coordinate data and y-coordinate data
         
-        TTY_U32 flagsSize = 0;
-        TTY_U32 xfileSize = 0;
-        
-        flagData  = glyph->glyfBlock + (10 + 2 * font->hint.zone1.numEndPoints);
+        TTY_U8* flagData = glyph->glyfBlock + (10 + 2 * render->zone1.numEndPoints);
         flagData += 2 + tty_get_u16(flagData);
         
-        for (TTY_U32 i = 0; i < font->hint.zone1.numOutlinePoints;) {
-            TTY_U8 flags = flagData[flagsSize];
-            TTY_U8 xSize = flags & TTY_GLYF_X_SHORT_VECTOR ? 1 : flags & TTY_GLYF_X_DUAL ? 0 : 2;
-            TTY_U8 flagsReps;
-
-            if (flags & TTY_GLYF_REPEAT_FLAG) {
-                flagsReps = 1 + flagData[flagsSize + 1];
-                flagsSize += 2;
-            }
-            else {
-                flagsReps = 1;
-                flagsSize++;
-            }
+        for (TTY_U32 i = 0; i < render->zone1.numOutlinePoints;) {
+            TTY_U8  flag      = *flagData++;
+            TTY_U32 flagsReps = 1;
 
-            i += flagsReps;
+            if (flag & TTY_GLYF_REPEAT_FLAG) {
+                flagsReps += *flagData++;
+                flagsReps  = TTY_MIN(flagsReps, render->zone1.numOutlinePoints - i);
+            }
 
-            while (flagsReps > 0) {
-                xfileSize += xSize;
-                flagsReps--;
+            xSize += flagsReps * (flag & TTY_GLYF_X_SHORT_VECTOR ? 1 : flag & TTY_GLYF_X_DUAL ? 0 : 2);
+            ySize += flagsReps * (flag & TTY_GLYF_Y_SHORT_VECTOR ? 1 : flag & TTY_GLYF_Y_DUAL ? 0 : 2);
+            
+            for (; flagsReps > 0; flagsReps--) {
+                flags[i++] = flag;
             }
         }
         
-        xData = flagData + flagsSize;
-        yData = xData    + xfileSize;
+        xData = flagData;
     }
     
-    {
-        // Add the points that make up the glyph's contours (i.e. outline points)
-        
-        TTY_V2 absPos = { 0 };
-        
-        for (TTY_U32 i = 0; i < font->hint.zone1.numOutlinePoints;) {
-            TTY_U8 flags = *flagData;
-            TTY_U8 flagsReps;
-            
-            if (flags & TTY_GLYF_REPEAT_FLAG) {
-                flagsReps = 1 + flagData[1];
-                flagData += 2;
-            }
-            else {
-                flagsReps = 1;
-                flagData++;
-            }
-            
-            for (; flagsReps > 0; ++i, --flagsReps) {
-                TTY_S16 xOff = tty_get_next_simple_glyph_coord_off(&xData, TTY_GLYF_X_DUAL, TTY_GLYF_X_SHORT_VECTOR, flags);
-                TTY_S16 yOff = tty_get_next_simple_glyph_coord_off(&yData, TTY_GLYF_Y_DUAL, TTY_GLYF_Y_SHORT_VECTOR, flags);
-
-                font->hint.zone1.pointTypes[i] = flags & TTY_GLYF_ON_CURVE_POINT ? TTY_ON_CURVE_POINT : TTY_OFF_CURVE_POINT;
-                font->hint.zone1.org[i].x      = absPos.x + xOff;
-                font->hint.zone1.org[i].y      = absPos.y + yOff;
-                absPos                         = font->hint.zone1.org[i];
-            }
-        }
+    // Add the points that make up the glyph's contours (i.e. outline points)
+    tty_decode_simple_glyph_coords(flags, render->zone1.numOutlinePoints, xData, xSize, xData + xSize, ySize, render->zone1.org);
+
+    for (TTY_U32 i = 0; i < render->zone1.numOutlinePoints; i++) {
+        flags[i] = flags[i] & TTY_GLYF_ON_CURVE_POINT ? TTY_ON_CURVE_POINT : TTY_OFF_CURVE_POINT;
     }
 
-    tty_get_phantom_points_and_types(font, glyph, font->hint.zone1.org + font->hint.zone1.numOutlinePoints, font->hint.zone1.pointTypes + font->hint.zone1.numOutlinePoints);
-    tty_scale_points(font->hint.zone1.org, font->hint.zone1.numPoints, instance->scale, font->hint.zone1.orgScaled);
-    memcpy(font->hint.zone1.cur, font->hint.zone1.orgScaled, font->hint.zone1.numPoints * sizeof(TTY_V2));
-    tty_round_phantom_points(font->hint.zone1.cur + font->hint.zone1.numOutlinePoints);
+    tty_get_phantom_points_and_types(font, glyph, render->zone1.org + render->zone1.numOutlinePoints, render->zone1.pointTypes + render->zone1.numOutlinePoints);
     
-    for (TTY_U32 i = 0; i < font->hint.zone1.numEndPoints; i++) {
-        font->hint.zone1.endPointIndices[i] = tty_get_u16(glyph->glyfBlock + 10 + 2 * i);
+    for (TTY_U32 i = 0; i < render->zone1.numEndPoints; i++) {
+        render->zone1.endPointIndices[i] = tty_get_u16(glyph->glyfBlock + 10 + 2 * i);
+    }
+}
+
+// Checks that the glyph's header and end points are within its block and that
+// its points fit in zone1, which is sized from maxp
+static TTY_Bool tty_simple_glyph_fits_in_zone1(TTY_Zone* zone1, TTY_Glyph* glyph) {
+    TTY_U32 insCountOff = 10 + 2 * glyph->numContours;
+
+    if (insCountOff + 2 > glyph->glyfSize || glyph->numContours > zone1->maxEndPoints) {
+        return TTY_FALSE;
+    }
+
+    TTY_U32 numPoints = tty_get_u16(glyph->glyfBlock + insCountOff - 2) + 1u + TTY_NUM_PHANTOM_POINTS;
+    return numPoints <= zone1->maxPoints;
+}
+
+static TTY_Error tty_add_simple_glyph_points_to_zone1(TTY_Font* font, TTY_Instance* instance, TTY_Render_Context* render, TTY_Glyph* glyph) {
+    if (!tty_simple_glyph_fits_in_zone1(&render->zone1, glyph)) {
+        return TTY_ERROR_FILE_IS_CORRUPTED;
     }
 
+    // The unscaled points don't depend on the instance, so they can be reused
+    // from the outline cache if the glyph has been decoded before
+    if (font->outlineCache.chainHeads == NULL) {
+        tty_decode_simple_glyph_points(font, render, glyph);
+    }
+    else {
+        TTY_Outline_Cache_Node* node = tty_outline_cache_get(&font->outlineCache, glyph->idx);
+
+        if (node == NULL) {
+            tty_decode_simple_glyph_points(font, render, glyph);
+            tty_outline_cache_insert(&font->outlineCache, &render->zone1, render->zone1.org, glyph->idx);
+        }
+        else {
+            tty_outline_cache_node_to_zone1(node, &render->zone1, render->zone1.org);
+        }
+    }
+
+    tty_scale_points(render->zone1.org, render->zone1.numPoints, instance->scale, render->zone1.orgScaled);
+    memcpy(render->zone1.cur, render->zone1.orgScaled, render->zone1.numPoints * sizeof(TTY_V2));
+    tty_round_phantom_points(render->zone1.cur + render->zone1.numOutlinePoints);
+
     if (instance->useHinting) {
         TTY_U32 off      = 10 + glyph->numContours * 2;
         TTY_U16 insCount = tty_get_u16(glyph->glyfBlock + off);
         TTY_U8* insBuff  = glyph->glyfBlock + off + 2;
-        return tty_execute_glyph_program(font, instance, glyph, insBuff, insCount);
+        return tty_execute_glyph_program(font, instance, render, glyph, insBuff, insCount);
     }
 
     return TTY_ERROR_NONE;
 }
 
 static void tty_offset_zone1_buffs(TTY_Zone* zone1, TTY_S32 pointOff, TTY_S32 endPointOff) {
+    // The capacities shrink along with the buffers so that the next component
+    // is checked against the space that is left
+    zone1->maxPoints       -= pointOff;
+    zone1->maxEndPoints    -= endPointOff;
     zone1->org             += pointOff;
     zone1->orgScaled       += pointOff;
     zone1->cur             += pointOff;
@@ -3505,219 +6207,371 @@ static void tty_offset_zone1_buffs(TTY_Zone* zone1, TTY_S32 pointOff, TTY_S32 en
     zone1->endPointIndices += endPointOff;
 }
 
-static TTY_Error tty_add_composite_glyph_points_to_zone1(TTY_Font* font, TTY_Instance* instance, TTY_Glyph* glyph) {
-    TTY_U32  off             = 10;
-    TTY_U32  totalPoints     = 0;
-    TTY_U32  totalEndPoints  = 0;
-    TTY_U32  endPointOff     = 0;
-    TTY_Bool hasInstructions = TTY_FALSE;
-    
-    while (TTY_TRUE) {
-        TTY_U16 flags         = tty_get_u16(glyph->glyfBlock + off);
-        TTY_U16 childGlyphIdx = tty_get_u16(glyph->glyfBlock + off + 2);
-        off += 4;
-        
-        TTY_Glyph childGlyph;
-        tty_glyph_init(font, &childGlyph, childGlyphIdx);
+// Transforms and moves the points of a component that was just added to zone1.
+// The zone1 buffers are offset so that they point to the component's points,
+// which means the points already added by the composite glyph precede them.
+static TTY_Error tty_position_composite_component(TTY_Render_Context* render, TTY_Instance* instance, TTY_Composite_Component* component, TTY_U32 numPrevPoints) {
+    TTY_Zone* zone1 = &render->zone1;
+    TTY_S32   xOff, yOff;
+
+    if (component->flags & (TTY_GLYF_WE_HAVE_A_SCALE | TTY_GLYF_WE_HAVE_AN_X_AND_Y_SCALE | TTY_GLYF_WE_HAVE_A_TWO_BY_TWO)) {
+        TTY_F2Dot14* transform = component->transform;
         
-        if (childGlyph.glyfBlock == NULL) {
-            // The glyph is an empty glyph (I don't see why this would ever occur)
-            continue;
+        for (TTY_U32 i = 0; i < zone1->numPoints; i++) {
+            TTY_F26Dot6 x = zone1->cur[i].x;
+            TTY_F26Dot6 y = zone1->cur[i].y;
+            zone1->cur[i].x = TTY_F2DOT14_MUL(x, transform[0]) + TTY_F2DOT14_MUL(y, transform[2]);
+            zone1->cur[i].y = TTY_F2DOT14_MUL(x, transform[1]) + TTY_F2DOT14_MUL(y, transform[3]);
         }
+    }
+    
+    if (component->flags & TTY_GLYF_ARGS_ARE_XY_VALUES) {
+        xOff = component->arg1;
+        yOff = component->arg2;
         
-        tty_add_glyph_points_to_zone_1(font, instance, &childGlyph);
+        if ((component->flags & TTY_GLYF_UNSCALED_COMPONENT_OFFSET) == 0 && 
+            (component->flags & TTY_GLYF_SCALED_COMPONENT_OFFSET)) 
+        {
+            // Note: This follows FreeType, which applies the transform to the 
+            //       offset only when the flags say to
+            TTY_F2Dot14* transform = component->transform;
+            TTY_S32      x         = xOff;
+            xOff = transform[0] * x + transform[2] * yOff;
+            yOff = transform[1] * x + transform[3] * yOff;
+        }
+        else {
+            xOff <<= 14;
+            yOff <<= 14;
+        }
+
+        xOff = TTY_F10DOT22_MUL(xOff, instance->scale);
+        yOff = TTY_F10DOT22_MUL(yOff, instance->scale);
         
-        // Make the end point indices of the current child glyph a continuation
-        // of the end point indices of the prev child glyph
-        for (TTY_U32 i = 0; i < font->hint.zone1.numEndPoints; i++) {
-            font->hint.zone1.endPointIndices[i] += endPointOff;
+        if (component->flags & TTY_GLYF_ROUND_XY_TO_GRID) {
+            xOff = tty_f2dot14_round_to_grid(xOff) >> 8;
+            yOff = tty_f2dot14_round_to_grid(yOff) >> 8;
+        }
+        else {
+            xOff = TTY_ROUNDED_DIV_POW2(xOff, 0x80, 8);
+            yOff = TTY_ROUNDED_DIV_POW2(yOff, 0x80, 8);
+        }
+    }
+    else {
+        // Point matching, the component is moved so that its point arg2 lands
+        // on the point arg1 of the points that have already been added
+        TTY_U32 prevPointIdx = component->arg1;
+        TTY_U32 pointIdx     = component->arg2;
+
+        if (prevPointIdx >= numPrevPoints || pointIdx >= zone1->numOutlinePoints) {
+            return TTY_ERROR_FILE_IS_CORRUPTED;
         }
 
-        totalPoints    += font->hint.zone1.numOutlinePoints;
-        totalEndPoints += font->hint.zone1.numEndPoints;
-        endPointOff     = font->hint.zone1.endPointIndices[totalEndPoints - 1];
+        TTY_F26Dot6_V2* prevPoint = zone1->cur - numPrevPoints + prevPointIdx;
+        xOff = prevPoint->x - zone1->cur[pointIdx].x;
+        yOff = prevPoint->y - zone1->cur[pointIdx].y;
+    }
+    
+    for (TTY_U32 i = 0; i < zone1->numPoints; i++) {
+        zone1->cur[i].x += xOff;
+        zone1->cur[i].y += yOff;
+    }
+
+    return TTY_ERROR_NONE;
+}
+
+static TTY_Error tty_add_composite_glyph_points_to_zone1(TTY_Font* font, TTY_Instance* instance, TTY_Render_Context* render, TTY_Glyph* glyph, TTY_U32 depth) {
+    TTY_Error                error           = TTY_ERROR_NONE;
+    TTY_U32                  off             = 10;
+    TTY_U32                  totalPoints     = 0;
+    TTY_U32                  totalEndPoints  = 0;
+    TTY_Bool                 hasInstructions = TTY_FALSE;
+    TTY_Composite_Component* cachedComponent = NULL;
+
+    // A composite glyph that references itself, directly or indirectly, would
+    // otherwise recurse until the stack overflows
+    if (depth == TTY_MAX_COMPONENT_DEPTH) {
+        return TTY_ERROR_FILE_IS_CORRUPTED;
+    }
+    
+    if (font->componentStarts != NULL) {
+        if (font->componentStarts[glyph->idx] == font->componentStarts[glyph->idx + 1]) {
+            return TTY_ERROR_FILE_IS_CORRUPTED;
+        }
+        cachedComponent = font->components + font->componentStarts[glyph->idx];
+    }
+    
+    while (TTY_TRUE) {
+        TTY_Composite_Component  parsedComponent;
+        TTY_Composite_Component* component;
         
-        {
-            TTY_S32 arg1, arg2;
-            
-            if (flags & TTY_GLYF_ARGS_ARE_XY_VALUES) {
-                if (flags & TTY_GLYF_ARG_1_AND_2_ARE_WORDS) {
-                    arg1 = tty_get_s16(glyph->glyfBlock + off);
-                    arg2 = tty_get_s16(glyph->glyfBlock + off + 2);
-                    off += 4;
-                }
-                else {
-                    arg1 = (TTY_S8)glyph->glyfBlock[off];
-                    arg2 = (TTY_S8)glyph->glyfBlock[off + 1];
-                    off += 2;
-                }
-                
-                if ((flags & TTY_GLYF_UNSCALED_COMPONENT_OFFSET) == 0 && 
-                    (flags & TTY_GLYF_SCALED_COMPONENT_OFFSET)) 
-                {
-                    // TODO: This needs testing
-                    TTY_ASSERT(TTY_FALSE);
-                    
-                    // TODO: Spec says to apply the transform to the glyph's points,
-                    //       however, FreeType only applies it to the offset (when the
-                    //       flags say to).
-                    TTY_F2Dot14 transform[4] = {0};
-
-                    if (flags & TTY_GLYF_WE_HAVE_A_SCALE) {
-                        transform[0] = tty_get_s16(glyph->glyfBlock + off);
-                        transform[3] = 0x4000;
-                        off += 2;
-                    }
-                    else if (flags & TTY_GLYF_WE_HAVE_AN_X_AND_Y_SCALE) {
-                        transform[0] = tty_get_s16(glyph->glyfBlock + off    );
-                        transform[3] = tty_get_s16(glyph->glyfBlock + off + 2);
-                        off += 4;
-                    }
-                    else if (flags & TTY_GLYF_WE_HAVE_A_TWO_BY_TWO) {
-                        transform[0] = tty_get_s16(glyph->glyfBlock + off    );
-                        transform[1] = tty_get_s16(glyph->glyfBlock + off + 2);
-                        transform[2] = tty_get_s16(glyph->glyfBlock + off + 4);
-                        transform[3] = tty_get_s16(glyph->glyfBlock + off + 6);
-                        off += 8;
-                    }
-                    else {
-                        transform[0] = 0x4000;
-                        transform[3] = 0x4000;
-                    }
+        if (cachedComponent != NULL) {
+            component = cachedComponent++;
+        }
+        else {
+            if (!tty_parse_composite_component(glyph->glyfBlock, glyph->glyfSize, off, &parsedComponent)) {
+                error = TTY_ERROR_FILE_IS_CORRUPTED;
+                break;
+            }
+            component = &parsedComponent;
+        }
+        off = component->endOff;
+        
+        TTY_Glyph childGlyph;
+        tty_glyph_init(font, &childGlyph, component->glyphIdx);
+        
+        // An empty child glyph doesn't add any points
+        if (childGlyph.glyfBlock != NULL) {
+            error = tty_add_glyph_points_to_zone_1(font, instance, render, &childGlyph, depth + 1);
+            if (error != TTY_ERROR_NONE) {
+                break;
+            }
 
-                    arg1 = transform[0] * arg1 + transform[1] * arg2;
-                    arg2 = transform[2] * arg1 + transform[3] * arg2;
-                    arg1 = TTY_F10DOT22_MUL(arg1, instance->scale);
-                    arg2 = TTY_F10DOT22_MUL(arg2, instance->scale);
-                }
-                else {
-                    if (flags & TTY_GLYF_WE_HAVE_A_SCALE) {
-                        off += 2;
-                    }
-                    else if (flags & TTY_GLYF_WE_HAVE_AN_X_AND_Y_SCALE) {
-                        off += 4;
-                    }
-                    else if (flags & TTY_GLYF_WE_HAVE_A_TWO_BY_TWO) {
-                        off += 8;
-                    }
-                    arg1 = TTY_F10DOT22_MUL(arg1 << 14, instance->scale);
-                    arg2 = TTY_F10DOT22_MUL(arg2 << 14, instance->scale);
-                }
-                
-                if (flags & TTY_GLYF_ROUND_XY_TO_GRID) {
-                    arg1 = tty_f2dot14_round_to_grid(arg1) >> 8;
-                    arg2 = tty_f2dot14_round_to_grid(arg2) >> 8;
-                }
-                else {
-                    arg1 = TTY_ROUNDED_DIV_POW2(arg1, 0x80, 8);
-                    arg2 = TTY_ROUNDED_DIV_POW2(arg2, 0x80, 8);
-                }
-                
-                for (TTY_U32 i = 0; i < font->hint.zone1.numPoints; i++) {
-                    font->hint.zone1.cur[i].x += arg1;
-                    font->hint.zone1.cur[i].y += arg2;
-                }
+            error = tty_position_composite_component(render, instance, component, totalPoints);
+            if (error != TTY_ERROR_NONE) {
+                break;
             }
-            else {
-                // TODO: Handle point matching (stb_truetype doesn't even
-                //       bother implementing this)
-                return TTY_ERROR_UNSUPPORTED_FEATURE;
+
+            // Make the end point indices of the current child glyph a
+            // continuation of the end point indices of the prev child glyph
+            for (TTY_U32 i = 0; i < render->zone1.numEndPoints; i++) {
+                render->zone1.endPointIndices[i] += totalPoints;
             }
-        }
 
-        // Temporarily offset the zone1 buffers so the data of the next
-        // child glyph can be added successively
-        tty_offset_zone1_buffs(&font->hint.zone1, font->hint.zone1.numOutlinePoints, font->hint.zone1.numEndPoints);
+            totalPoints    += render->zone1.numOutlinePoints;
+            totalEndPoints += render->zone1.numEndPoints;
+
+            // Temporarily offset the zone1 buffers so the data of the next
+            // child glyph can be added successively
+            tty_offset_zone1_buffs(&render->zone1, render->zone1.numOutlinePoints, render->zone1.numEndPoints);
+        }
         
-        if (!(flags & TTY_GLYF_MORE_COMPONENTS)) {
-            hasInstructions = (flags & TTY_GLYF_WE_HAVE_INSTRUCTIONS) != 0;
+        if (!(component->flags & TTY_GLYF_MORE_COMPONENTS)) {
+            hasInstructions = (component->flags & TTY_GLYF_WE_HAVE_INSTRUCTIONS) != 0;
             break;
         }
     }
+
+    if (error != TTY_ERROR_NONE) {
+        tty_offset_zone1_buffs(&render->zone1, -(TTY_S32)totalPoints, -(TTY_S32)totalEndPoints);
+        return error;
+    }
     
     // Note: The zone1 buffers still have the temporary offsets applied to them
     //       so they point to the phantom points
-    tty_get_phantom_points_and_types(font, glyph, font->hint.zone1.org, font->hint.zone1.pointTypes);
-    tty_scale_points(font->hint.zone1.org, TTY_NUM_PHANTOM_POINTS, instance->scale, font->hint.zone1.orgScaled);
-    memcpy(font->hint.zone1.cur, font->hint.zone1.orgScaled, TTY_NUM_PHANTOM_POINTS * sizeof(TTY_F26Dot6_V2));
-    tty_round_phantom_points(font->hint.zone1.cur);
+    tty_get_phantom_points_and_types(font, glyph, render->zone1.org, render->zone1.pointTypes);
+    tty_scale_points(render->zone1.org, TTY_NUM_PHANTOM_POINTS, instance->scale, render->zone1.orgScaled);
+    memcpy(render->zone1.cur, render->zone1.orgScaled, TTY_NUM_PHANTOM_POINTS * sizeof(TTY_F26Dot6_V2));
+    tty_round_phantom_points(render->zone1.cur);
     
-    tty_offset_zone1_buffs(&font->hint.zone1, -(TTY_S32)totalPoints, -(TTY_S32)totalEndPoints);
-
     // Undo the temporary offset applied to the zone1 buffers
-    font->hint.zone1.numPoints        = totalPoints + TTY_NUM_PHANTOM_POINTS;
-    font->hint.zone1.numOutlinePoints = totalPoints;
-    font->hint.zone1.numEndPoints     = totalEndPoints;
+    tty_offset_zone1_buffs(&render->zone1, -(TTY_S32)totalPoints, -(TTY_S32)totalEndPoints);
+
+    render->zone1.numPoints        = totalPoints + TTY_NUM_PHANTOM_POINTS;
+    render->zone1.numOutlinePoints = totalPoints;
+    render->zone1.numEndPoints     = totalEndPoints;
 
     if (instance->useHinting && hasInstructions) {
+        if (off + 2 > glyph->glyfSize) {
+            return TTY_ERROR_FILE_IS_CORRUPTED;
+        }
+
         TTY_U16 insCount = tty_get_u16(glyph->glyfBlock + off);
         TTY_U8* insBuff  = glyph->glyfBlock + off + 2;
-        return tty_execute_glyph_program(font, instance, glyph, insBuff, insCount);
+
+        if (off + 2 + insCount > glyph->glyfSize) {
+            return TTY_ERROR_FILE_IS_CORRUPTED;
+        }
+
+        return tty_execute_glyph_program(font, instance, render, glyph, insBuff, insCount);
+    }
+
+    return TTY_ERROR_NONE;
+}
+
+static TTY_Error tty_add_glyph_points_to_zone_1(TTY_Font* font, TTY_Instance* instance, TTY_Render_Context* render, TTY_Glyph* glyph, TTY_U32 depth) {
+    if (glyph->glyfBlock == NULL) {
+        return TTY_ERROR_NONE;
+    }
+    if (glyph->numContours < 0) {
+        return tty_add_composite_glyph_points_to_zone1(font, instance, render, glyph, depth);
+    }
+    return tty_add_simple_glyph_points_to_zone1(font, instance, render, glyph);
+}
+
+static void tty_convert_zone1_points_into_curves(TTY_Render_Context* render) {
+    TTY_U32 startPointIdx    = 0;
+    render->curves.count = 0;
+
+    for (TTY_U32 i = 0; i < render->zone1.numEndPoints; i++) {
+        TTY_U32  endPointIdx   = render->zone1.endPointIndices[i];
+        TTY_Bool addFinalCurve = TTY_TRUE;
+
+        TTY_F26Dot6_V2* startPoint = render->zone1.cur + startPointIdx;
+        TTY_F26Dot6_V2* nextP0     = startPoint;
+        
+        for (TTY_U32 j = startPointIdx + 1; j <= endPointIdx; j++) {
+            TTY_ASSERT(render->curves.count < render->curves.cap);
+            TTY_Curve* curve = render->curves.buff + render->curves.count;
+            curve->p0 = *nextP0;
+            curve->p1 = render->zone1.cur[j];
+
+            if (render->zone1.pointTypes[j] == TTY_ON_CURVE_POINT) {
+                curve->p2 = curve->p1;
+            }
+            else if (j == endPointIdx) {
+                curve->p2     = *startPoint;
+                addFinalCurve = TTY_FALSE;
+            }
+            else if (render->zone1.pointTypes[j + 1] == TTY_ON_CURVE_POINT) {
+                curve->p2 = render->zone1.cur[++j];
+            }
+            else { // Implied on-curve point
+                TTY_F26Dot6_V2* nextPoint = render->zone1.cur + j + 1;
+                TTY_FIX_V2_SUB(&curve->p1, nextPoint, &curve->p2);
+                curve->p2.x = TTY_F26DOT6_MUL(curve->p2.x, 0x20);
+                curve->p2.y = TTY_F26DOT6_MUL(curve->p2.y, 0x20);
+                TTY_FIX_V2_ADD(nextPoint, &curve->p2, &curve->p2);
+            }
+
+            nextP0 = &curve->p2;
+            render->curves.count++;
+        }
+
+        if (addFinalCurve) {
+            TTY_ASSERT(render->curves.count < render->curves.cap);
+            TTY_Curve* finalCurve = render->curves.buff + render->curves.count;
+            finalCurve->p0 = *nextP0;
+            finalCurve->p1 = *startPoint;
+            finalCurve->p2 = *startPoint;
+            render->curves.count++;
+        }
+
+        startPointIdx = endPointIdx + 1;
+    }
+}
+
+static void tty_add_glyph_complexity(TTY_Glyph_Complexity* total, TTY_Glyph_Complexity* complexity) {
+    total->numPoints   = TTY_MIN(total->numPoints   + complexity->numPoints  , 0xFFFF);
+    total->numContours = TTY_MIN(total->numContours + complexity->numContours, 0xFFFF);
+    total->numLines    = TTY_MIN(total->numLines    + complexity->numLines   , 0xFFFF);
+    total->numCurves   = TTY_MIN(total->numCurves   + complexity->numCurves  , 0xFFFF);
+    total->numInsBytes += complexity->numInsBytes;
+    total->curveWeight += complexity->curveWeight;
+}
+
+static void tty_measure_simple_glyph(TTY_Font* font, TTY_Glyph* glyph, TTY_Glyph_Complexity* complexity) {
+    TTY_Render_Context* render = &font->renderCtx;
+
+    if (!tty_simple_glyph_fits_in_zone1(&render->zone1, glyph)) {
+        return;
+    }
+
+    complexity->numInsBytes = tty_get_u16(glyph->glyfBlock + 10 + 2 * glyph->numContours);
+
+    if (glyph->numContours == 0) {
+        return;
+    }
+
+    // The curves are built from the unscaled points, so they are in font units
+    tty_decode_simple_glyph_points(font, render, glyph);
+    memcpy(render->zone1.cur, render->zone1.org, render->zone1.numOutlinePoints * sizeof(TTY_V2));
+    tty_convert_zone1_points_into_curves(render);
+
+    complexity->numPoints   = render->zone1.numOutlinePoints;
+    complexity->numContours = render->zone1.numEndPoints;
+
+    for (TTY_U32 i = 0; i < render->curves.count; i++) {
+        TTY_Curve* curve = render->curves.buff + i;
+
+        if (curve->p1.x == curve->p2.x && curve->p1.y == curve->p2.y) {
+            if (curve->p0.y != curve->p2.y) {
+                complexity->numLines++;
+            }
+        }
+        else {
+            // d is four times the distance between the midpoint of the chord
+            // and the midpoint of the curve
+            TTY_S64 dx  = curve->p0.x - 2 * curve->p1.x + curve->p2.x;
+            TTY_S64 dy  = curve->p0.y - 2 * curve->p1.y + curve->p2.y;
+            TTY_U32 mag = tty_isqrt(dx * dx + dy * dy);
+            
+            complexity->numCurves++;
+            complexity->curveWeight += tty_isqrt((TTY_U64)mag << 10); // sqrt(mag / 4) in 26.6
+        }
     }
-
-    return TTY_ERROR_NONE;
 }
 
-static TTY_Error tty_add_glyph_points_to_zone_1(TTY_Font* font, TTY_Instance* instance, TTY_Glyph* glyph) {
-    if (glyph->glyfBlock == NULL) {
-        return TTY_ERROR_NONE;
-    }
-    if (glyph->numContours < 0) {
-        return tty_add_composite_glyph_points_to_zone1(font, instance, glyph);
+static void tty_measure_glyph(TTY_Font* font, TTY_U32 glyphIdx, TTY_U32 depth, TTY_Glyph_Complexity* complexity) {
+    TTY_Glyph glyph;
+    tty_glyph_init(font, &glyph, glyphIdx);
+    memset(complexity, 0, sizeof(TTY_Glyph_Complexity));
+
+    if (glyph.glyfBlock == NULL) {
+        return;
     }
-    return tty_add_simple_glyph_points_to_zone1(font, instance, glyph);
-}
 
-static void tty_convert_zone1_points_into_curves(TTY_Font* font) {
-    TTY_U32 startPointIdx    = 0;
-    font->hint.curves.count = 0;
+    if (glyph.numContours >= 0) {
+        tty_measure_simple_glyph(font, &glyph, complexity);
+        return;
+    }
 
-    for (TTY_U32 i = 0; i < font->hint.zone1.numEndPoints; i++) {
-        TTY_U32  endPointIdx   = font->hint.zone1.endPointIndices[i];
-        TTY_Bool addFinalCurve = TTY_TRUE;
+    if (depth == TTY_MAX_COMPONENT_DEPTH) {
+        return;
+    }
 
-        TTY_F26Dot6_V2* startPoint = font->hint.zone1.cur + startPointIdx;
-        TTY_F26Dot6_V2* nextP0     = startPoint;
-        
-        for (TTY_U32 j = startPointIdx + 1; j <= endPointIdx; j++) {
-            TTY_ASSERT(font->hint.curves.count < font->hint.curves.cap);
-            TTY_Curve* curve = font->hint.curves.buff + font->hint.curves.count;
-            curve->p0 = *nextP0;
-            curve->p1 = font->hint.zone1.cur[j];
+    {
+        TTY_Composite_Component component;
+        TTY_U32                 off = 10;
 
-            if (font->hint.zone1.pointTypes[j] == TTY_ON_CURVE_POINT) {
-                curve->p2 = curve->p1;
-            }
-            else if (j == endPointIdx) {
-                curve->p2     = *startPoint;
-                addFinalCurve = TTY_FALSE;
+        do {
+            if (!tty_parse_composite_component(glyph.glyfBlock, glyph.glyfSize, off, &component)) {
+                return;
             }
-            else if (font->hint.zone1.pointTypes[j + 1] == TTY_ON_CURVE_POINT) {
-                curve->p2 = font->hint.zone1.cur[++j];
+            off = component.endOff;
+
+            TTY_Glyph            childGlyph;
+            TTY_Glyph_Complexity childComplexity;
+            tty_glyph_init(font, &childGlyph, component.glyphIdx);
+
+            if (font->complexity != NULL && childGlyph.numContours >= 0) {
+                // Simple glyphs are measured before composite glyphs when the
+                // table is built
+                childComplexity = font->complexity[component.glyphIdx];
             }
-            else { // Implied on-curve point
-                TTY_F26Dot6_V2* nextPoint = font->hint.zone1.cur + j + 1;
-                TTY_FIX_V2_SUB(&curve->p1, nextPoint, &curve->p2);
-                curve->p2.x = TTY_F26DOT6_MUL(curve->p2.x, 0x20);
-                curve->p2.y = TTY_F26DOT6_MUL(curve->p2.y, 0x20);
-                TTY_FIX_V2_ADD(nextPoint, &curve->p2, &curve->p2);
+            else {
+                tty_measure_glyph(font, component.glyphIdx, depth + 1, &childComplexity);
             }
 
-            nextP0 = &curve->p2;
-            font->hint.curves.count++;
-        }
+            tty_add_glyph_complexity(complexity, &childComplexity);
+        } while (component.flags & TTY_GLYF_MORE_COMPONENTS);
 
-        if (addFinalCurve) {
-            TTY_ASSERT(font->hint.curves.count < font->hint.curves.cap);
-            TTY_Curve* finalCurve = font->hint.curves.buff + font->hint.curves.count;
-            finalCurve->p0 = *nextP0;
-            finalCurve->p1 = *startPoint;
-            finalCurve->p2 = *startPoint;
-            font->hint.curves.count++;
+        if ((component.flags & TTY_GLYF_WE_HAVE_INSTRUCTIONS) && off + 2 <= glyph.glyfSize) {
+            complexity->numInsBytes += tty_get_u16(glyph.glyfBlock + off);
         }
+    }
+}
 
-        startPointIdx = endPointIdx + 1;
+static TTY_Error tty_build_complexity_table(TTY_Font* font) {
+    font->complexity = (TTY_Glyph_Complexity*)calloc(font->numGlyphs, sizeof(TTY_Glyph_Complexity));
+    if (font->complexity == NULL) {
+        return TTY_ERROR_OUT_OF_MEMORY;
+    }
+
+    // Simple glyphs are measured first so that composite glyphs can add up the
+    // measurements of their components
+    for (TTY_U32 composites = 0; composites <= 1; composites++) {
+        for (TTY_U32 i = 0; i < font->numGlyphs; i++) {
+            TTY_U32 glyfSize;
+            TTY_U8* glyfBlock = tty_get_glyf_data_block(font, i, &glyfSize);
+
+            if (glyfBlock != NULL && (tty_get_s16(glyfBlock) < 0) == composites) {
+                tty_measure_glyph(font, i, 0, font->complexity + i);
+            }
+        }
     }
+
+    TTY_PROFILE_ADD(font->stats.bytesAllocated, font->numGlyphs * sizeof(TTY_Glyph_Complexity));
+    return TTY_ERROR_NONE;
 }
 
 static TTY_F16Dot16 tty_get_inv_slope(TTY_F26Dot6_V2 p0, TTY_F26Dot6_V2 p1) {
@@ -3737,6 +6591,23 @@ static void tty_edge_init(TTY_Edge* edge, TTY_F26Dot6_V2 p0, TTY_F26Dot6_V2 p1)
     tty_max_min(p0.y, p1.y, &edge->yMax, &edge->yMin);
 }
 
+static TTY_Error tty_add_edge(TTY_Edges* edges, TTY_F26Dot6_V2 p0, TTY_F26Dot6_V2 p1) {
+    if (edges->count == edges->cap) {
+        TTY_U32   newCap  = edges->cap * 2;
+        TTY_Edge* newBuff = (TTY_Edge*)realloc(edges->buff, newCap * sizeof(TTY_Edge));
+        if (newBuff == NULL) {
+            return TTY_ERROR_OUT_OF_MEMORY;
+        }
+
+        edges->cap  = newCap;
+        edges->buff = newBuff;
+    }
+
+    tty_edge_init(edges->buff + edges->count, p0, p1);
+    edges->count++;
+    return TTY_ERROR_NONE;
+}
+
 static TTY_Error tty_subdivide_curve_into_edges(TTY_Edges* edges, TTY_F26Dot6_V2 p0, TTY_F26Dot6_V2 p1, TTY_F26Dot6_V2 p2) {
     #define TTY_SUBDIVIDE(a, b)\
         { TTY_F26DOT6_MUL((a.x + b.x), 0x20),\
@@ -3754,20 +6625,7 @@ static TTY_Error tty_subdivide_curve_into_edges(TTY_Edges* edges, TTY_F26Dot6_V2
         TTY_F26Dot6 sqrdError = TTY_F26DOT6_MUL(d.x, d.x) + TTY_F26DOT6_MUL(d.y, d.y);
 
         if (sqrdError <= TTY_SUBDIVIDE_SQRD_ERROR) {
-            if (edges->count == edges->cap) {
-                TTY_U32   newCap  = edges->cap * 2;
-                TTY_Edge* newBuff = (TTY_Edge*)realloc(edges->buff, newCap * sizeof(TTY_Edge));
-                if (newBuff == NULL) {
-                    return TTY_ERROR_OUT_OF_MEMORY;
-                }
-
-                edges->cap  = newCap;
-                edges->buff = newBuff;
-            }
-
-            tty_edge_init(edges->buff + edges->count, p0, p2);
-            edges->count++;
-            return TTY_ERROR_NONE;
+            return tty_add_edge(edges, p0, p2);
         }
     }
 
@@ -3785,23 +6643,25 @@ static TTY_Error tty_subdivide_curve_into_edges(TTY_Edges* edges, TTY_F26Dot6_V2
     #undef TTY_SUBDIVIDE
 }
 
-static TTY_Error tty_subdivide_curves_into_edges(TTY_Font* font, TTY_Edges* edges, TTY_U32 startingEdgeCap) {    
-    edges->cap   = startingEdgeCap;
+static TTY_Error tty_subdivide_curves_into_edges(TTY_Render_Context* render, TTY_Edges* edges, TTY_U32 startingEdgeCap) {    
+    edges->cap   = TTY_MAX(startingEdgeCap, 1);
     edges->count = 0;
     edges->buff  = (TTY_Edge*)malloc(edges->cap * sizeof(TTY_Edge));
     if (edges->buff == NULL) {
         return TTY_ERROR_OUT_OF_MEMORY;
     }
 
-    for (TTY_U32 i = 0; i < font->hint.curves.count; i++) {
-        TTY_Curve* curve = font->hint.curves.buff + i;
+    for (TTY_U32 i = 0; i < render->curves.count; i++) {
+        TTY_Curve* curve = render->curves.buff + i;
 
         if (curve->p1.x == curve->p2.x && curve->p1.y == curve->p2.y) {
             // The curve is a already straight line, no need to flatten it
 
             if (curve->p0.y != curve->p2.y) { // Horizontal lines can be ignored 
-                tty_edge_init(edges->buff + edges->count, curve->p0, curve->p2);
-                edges->count++;
+                TTY_Error error;
+                if ((error = tty_add_edge(edges, curve->p0, curve->p2))) {
+                    return error;
+                }
             }
         }
         else {
@@ -3830,9 +6690,9 @@ static TTY_S32 tty_get_unhinted_glyph_x_advance(TTY_Font* font, TTY_U32 glyphIdx
     return adv;
 }
 
-static TTY_S32 tty_get_unhinted_glyph_y_advance(TTY_Font* font, TTY_F10Dot22 scale) {
+static TTY_S32 tty_get_unhinted_glyph_y_advance(TTY_Font* font, TTY_U32 glyphIdx, TTY_F10Dot22 scale) {
     TTY_S32 adv;
-    adv = tty_get_glyph_advance_height(font);
+    adv = tty_get_glyph_advance_height(font, glyphIdx);
     adv = TTY_F10DOT22_MUL(adv << 6, scale);
     adv = tty_f26dot6_round(adv) >> 6;
     return adv;
@@ -3859,8 +6719,8 @@ static void tty_get_min_and_max_zone1_points(TTY_Zone* zone1, TTY_F26Dot6_V2* mi
     }
 }
 
-static void tty_set_hinted_glyph_metrics(TTY_Font* font, TTY_Glyph* glyph, TTY_F26Dot6_V2 min, TTY_F26Dot6_V2 max, TTY_F10Dot22 scale) {
-    TTY_F26Dot6_V2* phantomPoints = font->hint.zone1.cur + font->hint.zone1.numOutlinePoints;
+static void tty_set_hinted_glyph_metrics(TTY_Font* font, TTY_Render_Context* render, TTY_Glyph* glyph, TTY_F26Dot6_V2 min, TTY_F26Dot6_V2 max, TTY_F10Dot22 scale) {
+    TTY_F26Dot6_V2* phantomPoints = render->zone1.cur + render->zone1.numOutlinePoints;
     
     if (font->vmtx.exists) {
         glyph->advance.y = 
@@ -3869,7 +6729,7 @@ static void tty_set_hinted_glyph_metrics(TTY_Font* font, TTY_Glyph* glyph, TTY_F
             0;
     }
     else {
-        TTY_S64 advHeight = tty_get_glyph_advance_height(font) << 6;
+        TTY_S64 advHeight = tty_get_glyph_advance_height(font, glyph->idx) << 6;
         glyph->advance.y = TTY_F10DOT22_MUL(advHeight, scale);
     }
 
@@ -3888,21 +6748,64 @@ static void tty_set_unhinted_glyph_metrics(TTY_Font* font, TTY_Glyph* glyph, TTY
     glyph->size.y = (tty_f26dot6_ceil(max.y) - tty_f26dot6_floor(min.y)) >> 6;
 
     glyph->advance.x = tty_get_unhinted_glyph_x_advance(font, glyph->idx, scale);
-    glyph->advance.y = tty_get_unhinted_glyph_y_advance(font, scale);
+    glyph->advance.y = tty_get_unhinted_glyph_y_advance(font, glyph->idx, scale);
     
     glyph->offset.x = tty_f26dot6_floor(min.x) >> 6;
     glyph->offset.y = tty_f26dot6_ceil(max.y)  >> 6;
 }
 
-static void tty_set_glyph_metrics(TTY_Font* font, TTY_Instance* instance, TTY_Glyph* glyph, TTY_V2 min, TTY_V2 max) {
+static void tty_set_glyph_metrics(TTY_Font* font, TTY_Instance* instance, TTY_Render_Context* render, TTY_Glyph* glyph, TTY_V2 min, TTY_V2 max) {
     if (instance->useHinting) {
-        tty_set_hinted_glyph_metrics(font, glyph, min, max, instance->scale);
+        tty_set_hinted_glyph_metrics(font, render, glyph, min, max, instance->scale);
     }
     else {
         tty_set_unhinted_glyph_metrics(font, glyph, min, max, instance->scale);
     }
 }
 
+// Loads the glyph's points into zone1, executing its glyph program if the 
+// instance uses hinting, and sets the glyph's metrics. Everything the 
+// rasterizer needs except the edges is ready afterwards.
+static TTY_Error tty_load_glyph_points_and_metrics(TTY_Font* font, TTY_Instance* instance, TTY_Render_Context* render, TTY_Glyph* glyph, TTY_F26Dot6_V2* min, TTY_F26Dot6_V2* max) {
+    if (glyph->glyfBlock == NULL) {
+        // The glyph is an empty glyph (i.e. space)
+        glyph->advance.x = tty_get_unhinted_glyph_x_advance(font, glyph->idx, instance->scale);
+        glyph->advance.y = tty_get_unhinted_glyph_y_advance(font, glyph->idx, instance->scale);
+        return TTY_ERROR_NONE;
+    }
+
+    // A hit skips loading the glyph's points and executing its glyph program
+    TTY_Outline_Cache_Node* node = NULL;
+    if (instance->useHinting && instance->hintedCache.chainHeads != NULL) {
+        node = tty_outline_cache_get(&instance->hintedCache, glyph->idx);
+    }
+
+    if (node != NULL) {
+        tty_outline_cache_node_to_zone1(node, &render->zone1, render->zone1.cur);
+    }
+    else {
+        tty_render_context_reset_zone1(render);
+        if (instance->useHinting) {
+            tty_render_context_copy_instance(render, instance);
+        }
+
+        TTY_Error error;
+        if ((error = tty_add_glyph_points_to_zone_1(font, instance, render, glyph, 0))) {
+            return error;
+        }
+        if (instance->useHinting && instance->hintedCache.chainHeads != NULL) {
+            tty_outline_cache_insert(&instance->hintedCache, &render->zone1, render->zone1.cur, glyph->idx);
+        }
+    }
+
+    tty_get_min_and_max_zone1_points(&render->zone1, min, max);
+    TTY_ASSERT(max->x >= 0 && max->y >= 0); // TODO: Are negative maximum coordinates allowed?
+    
+    tty_set_glyph_metrics(font, instance, render, glyph, *min, *max);
+    TTY_ASSERT(glyph->size.x > 0 && glyph->size.y > 0);
+    return TTY_ERROR_NONE;
+}
+
 static TTY_Error tty_active_edge_list_init(TTY_Active_Edge_List* list) {
     list->headChunk = (TTY_Active_Chunk*)calloc(1, sizeof(TTY_Active_Chunk));
     if (list->headChunk != NULL) {
@@ -4168,15 +7071,290 @@ static void tty_rasterize_using_active_edges(TTY_Active_Edge_List* activeEdges,
     }
 }
 
-static TTY_Error tty_render_glyph_impl(TTY_Font* font, TTY_Instance* instance, TTY_Glyph* glyph, TTY_Image* image, TTY_U32 x, TTY_U32 y) {
-    if (glyph->glyfBlock == NULL) {
-        // The glyph is an empty glyph (i.e. space)
-        glyph->advance.x = tty_get_unhinted_glyph_x_advance(font, glyph->idx, instance->scale);
-        glyph->advance.y = tty_get_unhinted_glyph_y_advance(font, instance->scale);
-        return TTY_ERROR_NONE;
+static void tty_read_small_bitmap_glyph_metrics(TTY_U8* data, TTY_Bitmap_Glyph* bitmap) {
+    bitmap->height         = data[0];
+    bitmap->width          = data[1];
+    bitmap->bearingX       = (TTY_S8)data[2];
+    bitmap->bearingY       = (TTY_S8)data[3];
+    bitmap->advance        = data[4];
+    bitmap->vertAdvance    = 0;
+    bitmap->hasVertAdvance = TTY_FALSE;
+}
+
+static void tty_read_big_bitmap_glyph_metrics(TTY_U8* data, TTY_Bitmap_Glyph* bitmap) {
+    bitmap->height         = data[0];
+    bitmap->width          = data[1];
+    bitmap->bearingX       = (TTY_S8)data[2];
+    bitmap->bearingY       = (TTY_S8)data[3];
+    bitmap->advance        = data[4];
+    bitmap->vertAdvance    = data[7];
+    bitmap->hasVertAdvance = data[7] != 0; // Horizontal strikes may leave the vertical metrics zeroed
+}
+
+// Binary searches the sorted glyph IDs of index subtable formats 4 and 5
+static TTY_Bool tty_search_bitmap_glyph_ids(TTY_U8* ids, TTY_U32 count, TTY_U32 stride, TTY_U32 glyphIdx, TTY_U32* pos) {
+    TTY_U32 lo = 0;
+    TTY_U32 hi = count;
+
+    while (lo < hi) {
+        TTY_U32 mid = lo + (hi - lo) / 2;
+        TTY_U16 id  = tty_get_u16(ids + mid * stride);
+
+        if (id == glyphIdx) {
+            *pos = mid;
+            return TTY_TRUE;
+        }
+
+        if (id < glyphIdx) {
+            lo = mid + 1;
+        }
+        else {
+            hi = mid;
+        }
+    }
+
+    return TTY_FALSE;
+}
+
+// Gets the range of the glyph's image relative to the index subtable's 
+// imageDataOffset. `cap` is the number of bytes from the start of the subtable
+// to the end of the location table. `metrics` is set to the big glyph metrics
+// shared by every glyph in the subtable, or NULL if each glyph has its own.
+static TTY_Bool tty_locate_bitmap_glyph_image(TTY_U8* subtable, TTY_U64 cap, TTY_U32 glyphIdx, TTY_U32 firstGlyphIdx, TTY_U64* start, TTY_U64* end, TTY_U8** metrics) {
+    TTY_U32 idx = glyphIdx - firstGlyphIdx;
+    *start   = 0;
+    *end     = 0;
+    *metrics = NULL;
+
+    switch (tty_get_u16(subtable)) {
+        case 1: {
+            // 4-byte offsets
+            if (16 + 4 * (TTY_U64)idx > cap) {
+                return TTY_FALSE;
+            }
+            *start = tty_get_u32(subtable + 8 + 4 * idx);
+            *end   = tty_get_u32(subtable + 12 + 4 * idx);
+            return TTY_TRUE;
+        }
+        case 2: {
+            // Every glyph has the same metrics and image size
+            if (cap < 20) {
+                return TTY_FALSE;
+            }
+            TTY_U32 imageSize = tty_get_u32(subtable + 8);
+            *start   = (TTY_U64)idx * imageSize;
+            *end     = *start + imageSize;
+            *metrics = subtable + 12;
+            return TTY_TRUE;
+        }
+        case 3: {
+            // 2-byte offsets
+            if (12 + 2 * (TTY_U64)idx > cap) {
+                return TTY_FALSE;
+            }
+            *start = tty_get_u16(subtable + 8 + 2 * idx);
+            *end   = tty_get_u16(subtable + 10 + 2 * idx);
+            return TTY_TRUE;
+        }
+        case 4: {
+            // Sparse glyph ID and offset pairs, with an extra pair for the 
+            // end of the last image
+            if (cap < 12) {
+                return TTY_FALSE;
+            }
+            TTY_U32 numGlyphs = tty_get_u32(subtable + 8);
+            TTY_U32 pos;
+            if (16 + 4 * (TTY_U64)numGlyphs > cap || !tty_search_bitmap_glyph_ids(subtable + 12, numGlyphs, 4, glyphIdx, &pos)) {
+                return TTY_FALSE;
+            }
+            *start = tty_get_u16(subtable + 14 + 4 * pos);
+            *end   = tty_get_u16(subtable + 18 + 4 * pos);
+            return TTY_TRUE;
+        }
+        case 5: {
+            // Sparse glyph IDs, every glyph has the same metrics and image 
+            // size
+            if (cap < 24) {
+                return TTY_FALSE;
+            }
+            TTY_U32 imageSize = tty_get_u32(subtable + 8);
+            TTY_U32 numGlyphs = tty_get_u32(subtable + 20);
+            TTY_U32 pos;
+            if (24 + 2 * (TTY_U64)numGlyphs > cap || !tty_search_bitmap_glyph_ids(subtable + 24, numGlyphs, 2, glyphIdx, &pos)) {
+                return TTY_FALSE;
+            }
+            *start   = (TTY_U64)pos * imageSize;
+            *end     = *start + imageSize;
+            *metrics = subtable + 12;
+            return TTY_TRUE;
+        }
     }
 
+    return TTY_FALSE;
+}
+
+static TTY_Bool tty_read_bitmap_glyph_image(TTY_U8* image, TTY_U32 size, TTY_U16 imageFormat, TTY_U8* metrics, TTY_U8 bitDepth, TTY_Bitmap_Glyph* bitmap) {
+    TTY_U32 metricsSize;
+
+    switch (imageFormat) {
+        case 1:
+        case 2:
+            // Small metrics followed by byte-aligned (1) or bit-aligned (2) 
+            // data
+            metricsSize = 5;
+            if (size < metricsSize) {
+                return TTY_FALSE;
+            }
+            tty_read_small_bitmap_glyph_metrics(image, bitmap);
+            break;
+        case 5:
+            // Bit-aligned data, the metrics are in the index subtable
+            if (metrics == NULL) {
+                return TTY_FALSE;
+            }
+            metricsSize = 0;
+            tty_read_big_bitmap_glyph_metrics(metrics, bitmap);
+            break;
+        case 6:
+        case 7:
+            // Big metrics followed by byte-aligned (6) or bit-aligned (7) 
+            // data
+            metricsSize = 8;
+            if (size < metricsSize) {
+                return TTY_FALSE;
+            }
+            tty_read_big_bitmap_glyph_metrics(image, bitmap);
+            break;
+        default:
+            // TODO: Composite bitmaps (8, 9) and PNG images (17, 18, 19) are
+            //       not supported, the outline is rasterized instead
+            return TTY_FALSE;
+    }
+
+    bitmap->data         = image + metricsSize;
+    bitmap->bitDepth     = bitDepth;
+    bitmap->isBitAligned = imageFormat == 2 || imageFormat == 5 || imageFormat == 7;
+
+    if (bitmap->width == 0 || bitmap->height == 0) {
+        return TTY_FALSE;
+    }
+
+    {
+        TTY_U32 rowBits = bitmap->width * bitDepth;
+        TTY_U32 numBits = bitmap->isBitAligned ? rowBits * bitmap->height : ((rowBits + 7) & ~7) * bitmap->height;
+        return (numBits + 7) / 8 <= size - metricsSize;
+    }
+}
+
+// Looks up the glyph in the instance's bitmap strike. False is returned if the
+// strike doesn't have the glyph or its image can't be used.
+static TTY_Bool tty_find_bitmap_glyph(TTY_Font* font, TTY_Instance* instance, TTY_U32 glyphIdx, TTY_Bitmap_Glyph* bitmap) {
+    TTY_U8*    strike = instance->bitmapStrike;
+    TTY_Table* loc;
+    TTY_Table* data;
+    
+    if (strike == NULL || glyphIdx < tty_get_u16(strike + 40) || glyphIdx > tty_get_u16(strike + 42)) {
+        return TTY_FALSE;
+    }
+
+    if (!tty_get_bitmap_tables(font, &loc, &data)) {
+        return TTY_FALSE;
+    }
+
+    TTY_U8* blc          = font->fileData + loc->off;
+    TTY_U32 arrayOff     = tty_get_u32(strike);
+    TTY_U32 numSubtables = tty_get_u32(strike + 8);
+
+    for (TTY_U32 i = 0; i < numSubtables; i++) {
+        TTY_U8* entry         = blc + arrayOff + 8 * i;
+        TTY_U16 firstGlyphIdx = tty_get_u16(entry);
+        
+        if (glyphIdx < firstGlyphIdx || glyphIdx > tty_get_u16(entry + 2)) {
+            continue;
+        }
+
+        TTY_U64 subtableOff = (TTY_U64)arrayOff + tty_get_u32(entry + 4);
+        if (subtableOff + 8 > loc->size) {
+            return TTY_FALSE;
+        }
+
+        TTY_U8* subtable     = blc + subtableOff;
+        TTY_U16 imageFormat  = tty_get_u16(subtable + 2);
+        TTY_U64 imageDataOff = tty_get_u32(subtable + 4);
+        TTY_U64 start        = 0;
+        TTY_U64 end          = 0;
+        TTY_U8* metrics      = NULL;
+
+        // The subtable that covers the glyph has an unsupported index format,
+        // or the glyph has no image
+        if (!tty_locate_bitmap_glyph_image(subtable, loc->size - subtableOff, glyphIdx, firstGlyphIdx, &start, &end, &metrics) ||
+            start >= end || imageDataOff + end > data->size)
+        {
+            return TTY_FALSE;
+        }
+
+        TTY_U8* image = font->fileData + data->off + imageDataOff + start;
+        return tty_read_bitmap_glyph_image(image, (TTY_U32)(end - start), imageFormat, metrics, strike[46], bitmap);
+    }
+
+    return TTY_FALSE;
+}
+
+static void tty_set_bitmap_glyph_metrics(TTY_Font* font, TTY_Instance* instance, TTY_Glyph* glyph, TTY_Bitmap_Glyph* bitmap) {
+    glyph->advance.x = bitmap->advance;
+    glyph->advance.y = 
+        bitmap->hasVertAdvance ? 
+        bitmap->vertAdvance : 
+        tty_get_unhinted_glyph_y_advance(font, glyph->idx, instance->scale);
+
+    glyph->size.x   = bitmap->width;
+    glyph->size.y   = bitmap->height;
+    glyph->offset.x = bitmap->bearingX;
+    glyph->offset.y = bitmap->bearingY;
+}
+
+static TTY_Error tty_render_bitmap_glyph(TTY_Font* font, TTY_Instance* instance, TTY_Glyph* glyph, TTY_Bitmap_Glyph* bitmap, TTY_Image* image, TTY_U32 x, TTY_U32 y) {
+    tty_set_bitmap_glyph_metrics(font, instance, glyph, bitmap);
+
+    if (image->pixels == NULL) {
+        TTY_Error error;
+        if ((error = tty_image_init(image, NULL, glyph->size.x, glyph->size.y, 1))) {
+            return error;
+        }
+    }
+    else if (x + glyph->size.x > image->size.x || y + glyph->size.y > image->size.y) {
+        return TTY_ERROR_GLYPH_DOES_NOT_FIT_IN_IMAGE;
+    }
+
+    // Bit depths are 1, 2, 4, or 8, so a pixel never straddles two bytes
+    TTY_U32 maxValue = (1 << bitmap->bitDepth) - 1;
+    TTY_U32 rowBits  = bitmap->width * bitmap->bitDepth;
+    
+    if (!bitmap->isBitAligned) {
+        rowBits = (rowBits + 7) & ~7;
+    }
+
+    for (TTY_U32 row = 0; row < bitmap->height; row++) {
+        TTY_U32 bitOff   = row * rowBits;
+        TTY_U32 imageOff = (y + row) * image->size.x + x;
+
+        for (TTY_U32 col = 0; col < bitmap->width; col++) {
+            TTY_U32 value    = (bitmap->data[bitOff >> 3] >> (8 - bitmap->bitDepth - (bitOff & 7))) & maxValue;
+            TTY_U32 imageIdx = (imageOff + col) * image->numChannels;
+
+            for (TTY_U32 i = 0; i < image->numChannels; i++) {
+                image->pixels[imageIdx + i] = 255;
+            }
+            image->pixels[imageIdx + image->numChannels - 1] = value * 255 / maxValue;
+
+            bitOff += bitmap->bitDepth;
+        }
+    }
+
+    return TTY_ERROR_NONE;
+}
 
+static TTY_Error tty_render_glyph_impl(TTY_Font* font, TTY_Instance* instance, TTY_Render_Context* render, TTY_Glyph* glyph, TTY_Image* image, TTY_U32 x, TTY_U32 y) {
     // The glyph's points are converted into curves and the curves are 
     // approximated by edges.
     TTY_Edges edges = {0};
@@ -4208,28 +7386,39 @@ static TTY_Error tty_render_glyph_impl(TTY_Font* font, TTY_Instance* instance, T
     TTY_Bool imagePixelsWereAllocated = TTY_FALSE;
 
 
-    // Get the glyph's points
+    // Glyphs in the instance's bitmap strike are copied instead of rasterized
+    {
+        TTY_Bitmap_Glyph bitmap;
+        if (tty_find_bitmap_glyph(font, instance, glyph->idx, &bitmap)) {
+            return tty_render_bitmap_glyph(font, instance, glyph, &bitmap, image, x, y);
+        }
+    }
+
+    // Get the glyph's points and metrics
     {
         TTY_Error error;
-        if ((error = tty_add_glyph_points_to_zone_1(font, instance, glyph))) {
+        if ((error = tty_load_glyph_points_and_metrics(font, instance, render, glyph, &min, &max))) {
             return error;
         }
-        if (instance->useHinting) {
-            // Touch flags need to be cleared here (Everything else in zone1 is 
-            // cleared elsewhere)
-            // 
-            // TODO: ?????
-            memset(font->hint.zone1.touchFlags, TTY_UNTOUCHED, sizeof(TTY_U8) * font->hint.zone1.numOutlinePoints);
+        if (glyph->glyfBlock == NULL) {
+            return TTY_ERROR_NONE;
         }
     }
 
     // Convert the glyph's points into curves
-    tty_convert_zone1_points_into_curves(font);
+    tty_convert_zone1_points_into_curves(render);
 
-    // Approximate the curves using edges
+    // Approximate the curves using edges. If the glyph was measured at load 
+    // time, the edge buffer is sized for it rather than for the largest glyph
+    // rendered so far.
     {
+        TTY_U32 edgeCap = render->startingEdgeCap;
+        if (font->complexity != NULL) {
+            edgeCap = tty_estimate_glyph_edges(instance, font->complexity + glyph->idx);
+        }
+
         TTY_Error error;
-        if ((error = tty_subdivide_curves_into_edges(font, &edges, font->startingEdgeCap))) {
+        if ((error = tty_subdivide_curves_into_edges(render, &edges, edgeCap))) {
             return error;
         }
     }
@@ -4238,19 +7427,13 @@ static TTY_Error tty_render_glyph_impl(TTY_Font* font, TTY_Instance* instance, T
     // Edges are sorted from largest to smallest y-coordinate
     qsort(edges.buff, edges.count, sizeof(TTY_Edge), tty_compare_edges);
 
-    if (edges.count > font->startingEdgeCap) {
+    if (edges.count > render->startingEdgeCap) {
         // Increase the starting edge capacity to potentially prevent a realloc
         // of the edge buffer when rasterizing future glyphs
-        font->startingEdgeCap = edges.count;
+        render->startingEdgeCap = edges.count;
     }
 
 
-    tty_get_min_and_max_zone1_points(&font->hint.zone1, &min, &max);
-    TTY_ASSERT(max.x >= 0 && max.y >= 0); // TODO: Are negative maximum coordinates allowed?
-    
-    tty_set_glyph_metrics(font, instance, glyph, min, max);
-    TTY_ASSERT(glyph->size.x > 0 && glyph->size.y > 0);
-
     if (image->pixels == NULL) {
         // The image has not been allocated, create an image that is a tight
         // bounding box of the glyph
@@ -4354,21 +7537,113 @@ static TTY_Error tty_render_glyph_impl(TTY_Font* font, TTY_Instance* instance, T
     return TTY_ERROR_NONE;
 }
 
+TTY_Error tty_get_glyph_complexity(TTY_Font* font, TTY_U32 idx, TTY_Glyph_Complexity* complexity) {
+    if (font->complexity != NULL) {
+        *complexity = font->complexity[idx];
+    }
+    else {
+        tty_measure_glyph(font, idx, 0, complexity);
+    }
+    return TTY_ERROR_NONE;
+}
+
+TTY_U32 tty_estimate_glyph_edges(TTY_Instance* instance, TTY_Glyph_Complexity* complexity) {
+    // A curve is subdivided until its chord is within 1/8 of a pixel of the 
+    // curve. Each subdivision doubles the number of edges and quarters the 
+    // distance, so a curve whose chord is d pixels away becomes fewer than 
+    // 1 + 2 * sqrt(8 * d) edges.
+    TTY_U64 curveScale = tty_isqrt((TTY_U64)instance->scale << 15); // sqrt(32 * scale) in 16.16
+    TTY_U64 curveEdges = ((TTY_U64)complexity->curveWeight * curveScale) >> 22;
+    TTY_U32 numEdges   = complexity->numLines + complexity->numCurves + (TTY_U32)curveEdges;
+
+    // Hinting moves points, which can lengthen curves and split horizontal
+    // lines, so the bound above no longer holds. Half again as many edges
+    // covers every hinted glyph of the example fonts from 8 to 256 ppem.
+    if (instance->useHinting) {
+        numEdges += numEdges / 2;
+    }
+
+    return numEdges;
+}
+
+TTY_Error tty_get_glyph_metrics(TTY_Font* font, TTY_Instance* instance, TTY_Glyph* glyph) {
+    return tty_get_glyph_metrics_with_context(font, instance, &font->renderCtx, glyph);
+}
+
+TTY_Error tty_get_glyph_metrics_with_context(TTY_Font* font, TTY_Instance* instance, TTY_Render_Context* render, TTY_Glyph* glyph) {
+    TTY_Bitmap_Glyph bitmap;
+    if (tty_find_bitmap_glyph(font, instance, glyph->idx, &bitmap)) {
+        tty_set_bitmap_glyph_metrics(font, instance, glyph, &bitmap);
+        return TTY_ERROR_NONE;
+    }
+
+    TTY_F26Dot6_V2 min, max;
+    return tty_load_glyph_points_and_metrics(font, instance, render, glyph, &min, &max);
+}
+
+TTY_Error tty_get_glyph_x_advance(TTY_Font* font, TTY_Instance* instance, TTY_Glyph* glyph, TTY_S32* advance) {
+    return tty_get_glyph_x_advance_with_context(font, instance, &font->renderCtx, glyph, advance);
+}
+
+TTY_Error tty_get_glyph_x_advance_with_context(TTY_Font* font, TTY_Instance* instance, TTY_Render_Context* render, TTY_Glyph* glyph, TTY_S32* advance) {
+    {
+        TTY_Bitmap_Glyph bitmap;
+        if (tty_find_bitmap_glyph(font, instance, glyph->idx, &bitmap)) {
+            *advance = bitmap.advance;
+            return TTY_ERROR_NONE;
+        }
+    }
+
+    if (instance->useHinting && glyph->glyfBlock != NULL) {
+        if (instance->hdmxWidths != NULL && glyph->idx < font->numGlyphs) {
+            *advance = instance->hdmxWidths[glyph->idx];
+            return TTY_ERROR_NONE;
+        }
+
+        // "The LTSH table ... stores the ppem value at which the glyph's 
+        // advance width becomes linear"
+        if (font->LTSH.exists && glyph->idx < font->numGlyphs && instance->ppem >= font->fileData[font->LTSH.off + 4 + glyph->idx]) {
+            *advance = tty_get_unhinted_glyph_x_advance(font, glyph->idx, instance->scale);
+            return TTY_ERROR_NONE;
+        }
+
+        {
+            TTY_Error error;
+            if ((error = tty_get_glyph_metrics_with_context(font, instance, render, glyph))) {
+                return error;
+            }
+        }
+
+        *advance = glyph->advance.x;
+        return TTY_ERROR_NONE;
+    }
+
+    *advance = tty_get_unhinted_glyph_x_advance(font, glyph->idx, instance->scale);
+    return TTY_ERROR_NONE;
+}
+
 TTY_Error tty_render_glyph(TTY_Font* font, TTY_Instance* instance, TTY_Glyph* glyph, TTY_Image* image) {
+    return tty_render_glyph_with_context(font, instance, &font->renderCtx, glyph, image);
+}
+
+TTY_Error tty_render_glyph_with_context(TTY_Font* font, TTY_Instance* instance, TTY_Render_Context* render, TTY_Glyph* glyph, TTY_Image* image) {
     // TODO: Allow for number of channels to be specified
     memset(image, 0, sizeof(TTY_Image));
-    return tty_render_glyph_impl(font, instance, glyph, image, 0, 0);
+    return tty_render_glyph_impl(font, instance, render, glyph, image, 0, 0);
 }
 
 TTY_Error tty_render_glyph_to_existing_image(TTY_Font* font, TTY_Instance* instance, TTY_Glyph* glyph, TTY_Image* image, TTY_U32 x, TTY_U32 y) {
-    return tty_render_glyph_impl(font, instance, glyph, image, x, y);
+    return tty_render_glyph_impl(font, instance, &font->renderCtx, glyph, image, x, y);
+}
+
+TTY_Error tty_render_glyph_to_existing_image_with_context(TTY_Font* font, TTY_Instance* instance, TTY_Render_Context* render, TTY_Glyph* glyph, TTY_Image* image, TTY_U32 x, TTY_U32 y) {
+    return tty_render_glyph_impl(font, instance, render, glyph, image, x, y);
 }
 
 
 /* ----------- */
 /* Atlas Cache */
 /* ----------- */
-#define TTY_HASH(key) (177573 + key)
 
 TTY_Error tty_atlas_cache_init(TTY_Instance* instance, TTY_Atlas_Cache* cache, TTY_U32 w, TTY_U32 h) {
     TTY_U32 maxGlyphs      =    (w / instance->maxGlyphSize.x) * (h / instance->maxGlyphSize.y);
@@ -4543,7 +7818,7 @@ TTY_Error tty_atlas_cache_get_entry(TTY_Font* font, TTY_Instance* instance, TTY_
 
         if ((error = tty_get_glyph_index(font, codePoint, &entry->glyph.idx)) ||
             (error = tty_glyph_init(font, &entry->glyph, entry->glyph.idx))   ||
-            (error = tty_render_glyph_impl(font, instance, &entry->glyph, &cache->atlas, entry->atlasPos.x, entry->atlasPos.y)))
+            (error = tty_render_glyph_impl(font, instance, &font->renderCtx, &entry->glyph, &cache->atlas, entry->atlasPos.x, entry->atlasPos.y)))
         {
             return error;
         }
@@ -9,6 +9,7 @@
 
 struct TTY_Program_Context;
 struct TTY_Zone;
+struct TTY_Compiled_Runtime;
 
 typedef uint8_t  TTY_Bool;
 typedef uint8_t  TTY_U8;
@@ -39,12 +40,36 @@ typedef enum {
     TTY_ERROR_OUT_OF_MEMORY              ,
     TTY_ERROR_UNKNOWN_INSTRUCTION        , /* TODO: This will be deprecated once all instructions are implemented */
     TTY_ERROR_GLYPH_DOES_NOT_FIT_IN_IMAGE,
+    TTY_ERROR_SNAPSHOT_MISMATCH          , /* The snapshot was created from a different font or library version */
+    TTY_ERROR_MODULE_MISMATCH            , /* The compiled module was generated from a different font */
+    TTY_ERROR_BUFFER_TOO_SMALL           , /* The buffer passed to a function that serializes data is too small */
 } TTY_Error;
 
+/* Specifies how a font's file data was obtained and how it is released */
+typedef enum {
+    TTY_FILE_DATA_ALLOCATED = 0, /* Read into a heap buffer owned by the font */
+    TTY_FILE_DATA_MAPPED    = 1, /* Memory-mapped read-only and unmapped by `tty_font_free` */
+    TTY_FILE_DATA_USER      = 2, /* Owned by the caller and never freed by the library */
+} TTY_File_Data_Owner;
+
+typedef enum {
+    TTY_FONT_DEFAULT            = 0,
+    TTY_FONT_CACHE_LOCA         = 1, /* Decode the loca table once at load time (4 bytes per glyph) */
+    TTY_FONT_CACHE_CMAP         = 2, /* Build a code point page table for format 12 cmaps (512 bytes per mapped page of 256 code points) */
+    TTY_FONT_CACHE_BMP          = 4, /* Cache the glyph index of every BMP code point (128 KiB) */
+    TTY_FONT_DEFER_FONT_PROGRAM = 8, /* Don't execute the font program during initialization, see `tty_font_load_program_snapshot` */
+    TTY_FONT_CACHE_COMPOSITES   = 16, /* Parse the component records of every composite glyph once at load time (32 bytes per component) */
+    TTY_FONT_CACHE_HMTX         = 32, /* Decode the advance width and left side bearing of every glyph once at load time (4 bytes per glyph) */
+    TTY_FONT_CACHE_VMTX         = 64, /* Decode the advance height and top side bearing of every glyph once at load time if the font has a vmtx table (4 bytes per glyph) */
+    TTY_FONT_CACHE_COMPLEXITY   = 128, /* Measure every glyph once at load time so renders can size their buffers up front (16 bytes per glyph), see `tty_get_glyph_complexity` */
+} TTY_Font_Flag;
+
 typedef enum {
     TTY_INSTANCE_DEFAULT                = 0,
     TTY_INSTANCE_NO_HINTING             = 1,
     TTY_INSTANCE_SUBPIXEL_RENDERING_RGB = 2, /* TODO: implement subpixel rendering */
+    TTY_INSTANCE_USE_GASP               = 4, /* Only use hinting at the sizes where the font's gasp table asks for grid-fitting */
+    TTY_INSTANCE_NO_EMBEDDED_BITMAPS    = 8, /* Always rasterize the outlines, even at sizes where the font has a bitmap strike */
 } TTY_Instance_Flag;
 
 typedef struct {
@@ -69,11 +94,33 @@ typedef struct {
     TTY_U32     count;
 } TTY_Curves;
 
+/* An instruction that has been decoded from a font, CV, or glyph program */
 typedef struct {
-    TTY_U8**  insPtrs;
-    TTY_U32*  sizes;
-    TTY_U16   cap;
-    TTY_U16   count;
+    TTY_U8   code;      /* Which instruction to execute, instructions that only differ by their flags share a code */
+    TTY_U8   ins;       /* The original opcode, which holds the instruction's flags */
+    TTY_U16  numValues; /* The number of values pushed by a push instruction */
+    TTY_U32  valueOff;  /* Index of the first value pushed by a push instruction */
+    TTY_U32  byteOff;   /* Offset of the instruction in the program's bytes */
+} TTY_Op;
+
+/* Function bodies share the ops, values, bytes, and control flow tables of 
+   the program that defined them */
+typedef struct {
+    TTY_Op*   ops;
+    TTY_S32*  values;
+    TTY_U8*   bytes;
+    TTY_U32*  branchOffs; /* For IF, ELSE, and FDEF ops, the distance to the op following the matching ELSE/EIF/ENDF */
+    TTY_U32*  opIdxs;     /* For each offset in bytes, the index of the first op at or after it in the defining program */
+    TTY_U32   opIdxBase;  /* The index of ops[0] in the defining program */
+    TTY_U32   numOps;
+    TTY_U32   start; /* Offset of the first instruction in bytes */
+    TTY_U32   end;   /* Offset of the byte following the last instruction */
+} TTY_Program;
+
+typedef struct {
+    TTY_Program*  bodies; /* The ops of an undefined function are NULL */
+    TTY_U16       cap;
+    TTY_U16       count;
 } TTY_Funcs;
 
 typedef struct {
@@ -94,6 +141,41 @@ typedef struct {
     TTY_U16   count;
 } TTY_Interp_Stack;
 
+/* A function or glyph program that was translated to C by 
+   tools/compile_font.c. Returns TTY_FALSE if execution stopped at an 
+   instruction that is unknown to the executing program, or because the
+   program over- or underflowed the stack. */
+typedef TTY_Bool (*TTY_Compiled_Program)(struct TTY_Program_Context* ctx, const struct TTY_Compiled_Runtime* rt, TTY_Interp_Stack* stack);
+
+/* The interpreter functions that compiled programs use for the instructions 
+   that they don't translate */
+typedef struct TTY_Compiled_Runtime {
+    TTY_Compiled_Program*  funcs; /* The compiled code of each defined function, NULL if the function is interpreted */
+    TTY_Bool               (*execute)(struct TTY_Program_Context* ctx, TTY_U8 ins);
+    TTY_Bool               (*call)(struct TTY_Program_Context* ctx, TTY_U32 funcId, TTY_U32 count);
+} TTY_Compiled_Runtime;
+
+typedef struct {
+    TTY_U32               off;  /* Offset of the function's first instruction in the file */
+    TTY_U32               size; /* Size of the function's instructions, excluding the ENDF */
+    TTY_Compiled_Program  program;
+} TTY_Compiled_Func;
+
+typedef struct {
+    TTY_U32               glyphIdx;
+    TTY_Compiled_Program  program;
+} TTY_Compiled_Glyph;
+
+/* The programs of a font that were compiled by tools/compile_font.c, see 
+   `tty_font_register_compiled_module` */
+typedef struct {
+    TTY_U64                    checksum; /* See `tty_font_get_checksum` */
+    TTY_U32                    numFuncs;
+    TTY_U32                    numGlyphs;
+    const TTY_Compiled_Func*   funcs;    /* Sorted by offset */
+    const TTY_Compiled_Glyph*  glyphs;
+} TTY_Compiled_Module;
+
 /* org, pointTypes, endPointIndices, numOutlinePoints, numEndPoints, and 
    maxEndPoints are only used by zone1 */
 typedef struct TTY_Zone {
@@ -138,16 +220,32 @@ typedef struct {
     TTY_Bool             scanControl;
 } TTY_Graphics_State;
 
-/* Glyph points/ curves are stored in zone1 even if the font doesn't have 
-   hinting or hinting is disabled */
+typedef struct {
+    TTY_U8*             mem;
+    TTY_Funcs           funcs;
+    TTY_Program         fontProgram;  /* Decoded once when the font is loaded */
+    TTY_Program         cvProgram;    /* Decoded once when the font is loaded */
+} TTY_Font_Hinting_Data;
+
+/* The scratch data that is written to while a glyph is loaded, hinted, and 
+   rasterized. Glyph points/ curves are stored in zone1 even if the font 
+   doesn't have hinting or hinting is disabled. Glyph programs modify copies of
+   the instance's CVT, storage area, and zone0, which are made each time a 
+   glyph is loaded, so that the instance isn't modified by rendering. See 
+   `tty_render_context_init`. */
 typedef struct {
     TTY_U8*             mem;
     TTY_Curves          curves;
     TTY_Zone            zone1;
     TTY_Interp_Stack    stack;
-    TTY_Funcs           funcs;
     TTY_Graphics_State  gs;
-} TTY_Font_Hinting_Data;
+    TTY_CVT             cvt;
+    TTY_Storage_Area    storage;
+    TTY_Zone            zone0;
+    TTY_Program*        glyphPrograms;    /* Indexed by glyph, each is decoded the first time the glyph is hinted */
+    TTY_U32             numGlyphPrograms;
+    TTY_U32             startingEdgeCap;
+} TTY_Render_Context;
 
 typedef struct {
     TTY_U32   off;
@@ -168,31 +266,141 @@ typedef struct {
     TTY_U16   format;
 } TTY_Encoding;
 
+/* Startup costs of a font. These are only recorded when the library is 
+   compiled with TTY_PROFILING defined, otherwise they are all 0. Times are in
+   nanoseconds. */
 typedef struct {
-    TTY_Font_Hinting_Data  hint;
-    TTY_U8*                fileData;
-    TTY_S32                fileSize;
-    TTY_Table              cmap;
-    TTY_Table              cvt;
-    TTY_Table              fpgm;
-    TTY_Table              glyf;
-    TTY_Table              head;
-    TTY_Table              hhea;
-    TTY_Table              hmtx;
-    TTY_Table              loca;
-    TTY_Table              maxp;
-    TTY_Table              OS2;
-    TTY_Table              prep;
-    TTY_Table              vmtx;
-    TTY_Encoding           encoding;
-    TTY_U32                numGlyphs;
-    TTY_U32                startingEdgeCap;
-    TTY_U16                upem;
-    TTY_S16                ascender;
-    TTY_S16                descender;
-    TTY_S16                lineGap;
-    TTY_S16                maxHoriExtent;
-    TTY_Bool               hasHinting;
+    TTY_U64  fileNs;              /* Reading or mapping the file */
+    TTY_U64  tableDirectoryNs;    /* Verifying the signature and parsing the table directory */
+    TTY_U64  cmapNs;              /* Selecting the cmap subtable */
+    TTY_U64  hintAllocNs;         /* Allocating the hinting data */
+    TTY_U64  tablesNs;            /* Building the lookup tables enabled by TTY_Font_Flag */
+    TTY_U64  fontProgramNs;       /* Executing the font program, even if it was deferred */
+    TTY_U64  bytesAllocated;      /* Including the file buffer if the file was read into memory */
+    TTY_U32  fontProgramInsCount;
+} TTY_Font_Stats;
+
+/* A glyph outline, either decoded in font units or hinted in 26.6 pixels */
+typedef struct TTY_Outline_Cache_Node {
+    TTY_U32                         glyphIdx;
+    TTY_U32                         size;             /* Bytes used by the node, including its arrays */
+    TTY_U16                         numOutlinePoints;
+    TTY_U16                         numEndPoints;
+    TTY_V2*                         points;           /* Outline points followed by the phantom points */
+    TTY_U16*                        endPointIndices;
+    TTY_U8*                         pointTypes;
+    struct TTY_Outline_Cache_Node*  lruPrev;
+    struct TTY_Outline_Cache_Node*  lruNext;
+    struct TTY_Outline_Cache_Node*  next;
+} TTY_Outline_Cache_Node;
+
+typedef struct {
+    TTY_Outline_Cache_Node** chainHeads; /* NULL if the cache is disabled */
+    TTY_Outline_Cache_Node*  lruHead;
+    TTY_Outline_Cache_Node*  lruTail;
+    TTY_U32                  numChains;
+    TTY_U32                  numBytes;
+    TTY_U32                  maxBytes;
+    TTY_U64                  numHits;
+    TTY_U64                  numMisses;
+} TTY_Outline_Cache;
+
+typedef struct {
+    TTY_U16  advanceWidth;
+    TTY_S16  leftSideBearing;
+} TTY_Hor_Metric;
+
+typedef struct {
+    TTY_U16  advanceHeight;
+    TTY_S16  topSideBearing;
+} TTY_Vert_Metric;
+
+/* How much work rendering a glyph takes. The counts of a composite glyph 
+   include its components. */
+typedef struct {
+    TTY_U16  numPoints;    /* Outline points */
+    TTY_U16  numContours;
+    TTY_U16  numLines;     /* Straight, non-horizontal contour segments */
+    TTY_U16  numCurves;    /* Quadratic contour segments */
+    TTY_U32  numInsBytes;  /* Size of the glyph program(s) */
+    TTY_U32  curveWeight;  /* Sum of the square roots of the curves' deviation from their chords (font units, 26.6), see `tty_estimate_glyph_edges` */
+} TTY_Glyph_Complexity;
+
+/* A component record of a composite glyph */
+typedef struct {
+    TTY_U16      glyphIdx;
+    TTY_U16      flags;
+    TTY_S32      arg1;         /* x offset, or the index of the matched point in the composite glyph */
+    TTY_S32      arg2;         /* y offset, or the index of the matched point in the component */
+    TTY_F2Dot14  transform[4]; /* xx, yx, xy, yy, identity if the component isn't transformed */
+    TTY_U32      endOff;       /* Offset of the byte after the record in the composite glyph's glyf block */
+} TTY_Composite_Component;
+
+/* The file data of a TrueType collection (.ttc) which is shared by all fonts
+   created from it */
+typedef struct {
+    TTY_U8*  fileData;
+    TTY_S32  fileSize;
+    TTY_U8   fileDataOwner; /* One of TTY_File_Data_Owner */
+    TTY_U32  numFaces;
+} TTY_Collection;
+
+typedef struct {
+    TTY_Font_Hinting_Data     hint;
+    TTY_Render_Context        renderCtx; /* Used by the functions that don't take a TTY_Render_Context */
+    TTY_U8*                   fileData;
+    TTY_S32                   fileSize;
+    TTY_U8                    fileDataOwner; /* One of TTY_File_Data_Owner */
+    TTY_U32                   faceOff;       /* Offset of the face's table directory, nonzero for collection faces */
+    TTY_Table                 CBDT; /* Only marked as existing if CBLC also exists, and vice versa */
+    TTY_Table                 CBLC;
+    TTY_Table                 cmap;
+    TTY_Table                 cvt;
+    TTY_Table                 EBDT; /* Only marked as existing if EBLC also exists, and vice versa */
+    TTY_Table                 EBLC;
+    TTY_Table                 fpgm;
+    TTY_Table                 gasp;
+    TTY_Table                 glyf;
+    TTY_Table                 hdmx;
+    TTY_Table                 head;
+    TTY_Table                 hhea;
+    TTY_Table                 hmtx;
+    TTY_Table                 LTSH;
+    TTY_Table                 loca;
+    TTY_Table                 maxp;
+    TTY_Table                 OS2;
+    TTY_Table                 prep;
+    TTY_Table                 VDMX;
+    TTY_Table                 vhea;
+    TTY_Table                 vmtx; /* Only marked as existing if vhea also exists */
+    TTY_Encoding              encoding;
+    TTY_U32*                  glyfOffsets; /* Decoded loca offsets, NULL unless TTY_FONT_CACHE_LOCA is used */
+    TTY_U16*                  cmapPageDir; /* Maps code point >> 8 to a page, NULL unless TTY_FONT_CACHE_CMAP is used */
+    TTY_U16*                  cmapPages;   /* Glyph indices, 256 per page */
+    TTY_U16*                  bmpGlyphIndices; /* Indexed by code point, NULL unless TTY_FONT_CACHE_BMP is used */
+    TTY_U32*                  componentStarts; /* Index of each glyph's first component, NULL unless TTY_FONT_CACHE_COMPOSITES is used */
+    TTY_Composite_Component*  components;
+    TTY_Hor_Metric*           horMetrics; /* Indexed by glyph, NULL unless TTY_FONT_CACHE_HMTX is used */
+    TTY_Vert_Metric*          vertMetrics; /* Indexed by glyph, NULL unless TTY_FONT_CACHE_VMTX is used and the font has a vmtx table */
+    TTY_Glyph_Complexity*     complexity;  /* Indexed by glyph, NULL unless TTY_FONT_CACHE_COMPLEXITY is used */
+    TTY_U32                   numGlyphs;
+    TTY_U16                   upem;
+    TTY_S16                   ascender;
+    TTY_S16                   descender;
+    TTY_S16                   lineGap;
+    TTY_S16                   maxHoriExtent;
+    TTY_S16                   typoAscender;  /* OS/2 sTypoAscender, or the hhea ascender if there is no OS/2 table */
+    TTY_S16                   typoDescender; /* OS/2 sTypoDescender, or the hhea descender if there is no OS/2 table */
+    TTY_U16                   numHMetrics;   /* hhea.numberOfHMetrics */
+    TTY_U16                   numVMetrics;   /* vhea.numOfLongVerMetrics, 0 if there is no vmtx table */
+    TTY_S16                   locaFormat; /* head.indexToLocFormat */
+    TTY_Bool                  hasHinting;
+    TTY_Bool                  isFontProgramPending; /* TTY_FONT_DEFER_FONT_PROGRAM was used and fpgm hasn't been executed or restored yet */
+    TTY_Font_Stats            stats;
+    TTY_Outline_Cache         outlineCache;
+    const TTY_Compiled_Module* compiledModule; /* NULL unless `tty_font_register_compiled_module` was used */
+    TTY_Compiled_Runtime      compiledRuntime;
+    TTY_Compiled_Program*     compiledGlyphs;  /* Indexed by glyph, NULL for glyphs that are interpreted */
 } TTY_Font;
 
 /* Each instance needs its own zone0 data since the data must persist for the 
@@ -204,6 +412,16 @@ typedef struct {
     TTY_Zone          zone0;
 } TTY_Instance_Hinting_Data;
 
+/* Same as `TTY_Font_Stats`, but for an instance. The CVT and CV program 
+   entries accumulate across calls to `tty_instance_resize`. */
+typedef struct {
+    TTY_U64  allocNs;
+    TTY_U64  cvtScaleNs;
+    TTY_U64  cvProgramNs;
+    TTY_U64  bytesAllocated;
+    TTY_U32  cvProgramInsCount;
+} TTY_Instance_Stats;
+
 typedef struct {
     TTY_Instance_Hinting_Data  hint;
     TTY_U32                    ppem;
@@ -212,15 +430,23 @@ typedef struct {
     TTY_S32                    lineGap;
     TTY_V2                     maxGlyphSize;
     TTY_F10Dot22               scale;
+    TTY_U8*                    hdmxWidths;   /* Hinted advance widths of the instance's ppem from hdmx, NULL if there are none */
+    TTY_U8*                    bitmapStrike; /* BitmapSize record of the instance's ppem in EBLC or CBLC, NULL if there is none */
     TTY_Bool                   useHinting;
     TTY_Bool                   useSubpixelRendering; /* TODO: Implement subpixel rendering */
+    TTY_Bool                   useGasp;              /* useHinting is updated whenever the ppem changes */
+    TTY_Bool                   useEmbeddedBitmaps;
     TTY_Bool                   isRotated;            /* TODO: Implement rotation */
     TTY_Bool                   isStretched;          /* TODO: Implement stretching */
+    TTY_Instance_Stats         stats;
+    TTY_Outline_Cache          hintedCache; /* See `tty_instance_enable_hinted_cache` */
 } TTY_Instance;
 
-/* advance, offset, and size are not calculated until the glyph is rendered */
+/* advance, offset, and size are not calculated until the glyph is rendered or
+   `tty_get_glyph_metrics` is called */
 typedef struct {
     TTY_U8*  glyfBlock;
+    TTY_U32  glyfSize; /* Size of glyfBlock in bytes */
     TTY_U32  idx;
     TTY_V2   advance;
     TTY_V2   offset;
@@ -262,7 +488,8 @@ typedef struct {
 
 
 /* 
- * Creates a `TTY_Font` using the TTF file specified by `path`.
+ * Creates a `TTY_Font` using the TTF file specified by `path`. If the file is
+ * a TrueType collection, its first face is loaded.
  *
  * Returns one of the following:
  *     TTY_ERROR_NONE                - The font was successfully loaded.
@@ -275,8 +502,151 @@ typedef struct {
  */
 TTY_Error tty_font_init(TTY_Font* font, const char* path);
 
+/*
+ * Same as `tty_font_init`, but `flags` is a combination of `TTY_Font_Flag`
+ * values which enable optional lookup tables that trade memory for speed.
+ */
+TTY_Error tty_font_init_ex(TTY_Font* font, const char* path, TTY_U32 flags);
+
+/*
+ * Creates a `TTY_Font` by memory-mapping the TTF file specified by `path`
+ * instead of reading the whole file into memory. Only the parts of the file
+ * that are accessed (e.g. cmap, loca, and the glyf records of rendered glyphs)
+ * are paged in. The mapping is released by `tty_font_free`.
+ *
+ * Returns the same errors as `tty_font_init`, except that
+ * TTY_ERROR_FAILED_TO_READ_FILE is also returned if the file could not be
+ * mapped.
+ */
+TTY_Error tty_font_init_mmap(TTY_Font* font, const char* path);
+
+/*
+ * Same as `tty_font_init_mmap`, but takes `TTY_Font_Flag` values like 
+ * `tty_font_init_ex`.
+ */
+TTY_Error tty_font_init_mmap_ex(TTY_Font* font, const char* path, TTY_U32 flags);
+
+/*
+ * Creates a `TTY_Font` from TTF file data that is already in memory (e.g. a
+ * font embedded in the executable or loaded from an asset pack). The data is 
+ * used in place and is not copied, so it must remain valid and unmodified 
+ * until `tty_font_free` is called. `tty_font_free` does not free `data`.
+ *
+ * Returns the same errors as `tty_font_init`, except for
+ * TTY_ERROR_FAILED_TO_READ_FILE.
+ */
+TTY_Error tty_font_init_from_memory(TTY_Font* font, const TTY_U8* data, TTY_S32 size);
+
+/*
+ * Same as `tty_font_init_from_memory`, but takes `TTY_Font_Flag` values like
+ * `tty_font_init_ex`.
+ */
+TTY_Error tty_font_init_from_memory_ex(TTY_Font* font, const TTY_U8* data, TTY_S32 size, TTY_U32 flags);
+
+/*
+ * Creates a `TTY_Font` from face `faceIdx` of `collection`. The font uses the
+ * collection's file data in place, so every face of a collection shares one 
+ * buffer or mapping, including any tables that the faces have in common. The
+ * collection must not be freed until all of its fonts have been freed.
+ *
+ * Returns the same errors as `tty_font_init_from_memory`. 
+ * TTY_ERROR_FILE_IS_CORRUPTED is also returned if `faceIdx` is out of range.
+ */
+TTY_Error tty_font_init_from_collection(TTY_Font* font, TTY_Collection* collection, TTY_U32 faceIdx);
+
+/*
+ * Same as `tty_font_init_from_collection`, but takes `TTY_Font_Flag` values
+ * like `tty_font_init_ex`.
+ */
+TTY_Error tty_font_init_from_collection_ex(TTY_Font* font, TTY_Collection* collection, TTY_U32 faceIdx, TTY_U32 flags);
+
 void tty_font_free(TTY_Font* font);
 
+/*
+ * Enables an LRU cache of decoded glyph outlines (in font units) that holds at
+ * most `maxBytes` bytes. Since the outlines don't depend on the instance, a 
+ * glyph that is rendered at several sizes, or rendered again after being 
+ * evicted from an atlas cache, only has its glyf data parsed once. Only simple
+ * glyphs are cached, this includes the components of composite glyphs. Any 
+ * previously cached outlines are discarded and passing 0 disables the cache.
+ * The hit and miss counts are available in `font->outlineCache`.
+ *
+ * Returns one of the following:
+ *     TTY_ERROR_NONE          - The cache was enabled.
+ *     TTY_ERROR_OUT_OF_MEMORY - Not enough memory could be allocated for the cache's hash table.
+ */
+TTY_Error tty_font_enable_outline_cache(TTY_Font* font, TTY_U32 maxBytes);
+
+/*
+ * Serializes the state produced by the font program (the function table, as 
+ * file offsets) into `data`. If `data` is NULL, the
+ * required size is written to `size`. Otherwise, `size` must contain the 
+ * capacity of `data` and is set to the number of bytes written. The snapshot
+ * is keyed by a checksum of the font's table directory and hinting tables.
+ *
+ * Returns one of the following:
+ *     TTY_ERROR_NONE                - The snapshot was successfully created, or its size was written.
+ *     TTY_ERROR_BUFFER_TOO_SMALL    - `size` is smaller than the size of the snapshot. Nothing is written to `data`.
+ *     TTY_ERROR_UNSUPPORTED_FEATURE - The font doesn't have hinting.
+ *     TTY_ERROR_UNKNOWN_INSTRUCTION - The font program was pending and has an instruction that is not yet handled.
+ */
+TTY_Error tty_font_save_program_snapshot(TTY_Font* font, TTY_U8* data, TTY_U32* size);
+
+/*
+ * Restores the state produced by the font program from a snapshot created by
+ * `tty_font_save_program_snapshot` so that it doesn't need to be executed. The
+ * font must have been created with TTY_FONT_DEFER_FONT_PROGRAM. If the font
+ * program isn't pending, this does nothing.
+ *
+ * Returns one of the following:
+ *     TTY_ERROR_NONE              - The snapshot was restored.
+ *     TTY_ERROR_SNAPSHOT_MISMATCH - The snapshot doesn't belong to this font or is invalid. The font is unchanged and
+ *                                   its font program will be executed when the first hinted instance is created.
+ */
+TTY_Error tty_font_load_program_snapshot(TTY_Font* font, const TTY_U8* data, TTY_U32 size);
+
+/*
+ * Returns the checksum of the font's table directory and hinting tables that
+ * snapshots and compiled modules are keyed by.
+ */
+TTY_U64 tty_font_get_checksum(TTY_Font* font);
+
+/*
+ * Registers the programs that tools/compile_font.c translated to C for this 
+ * font. The compiled code is used in place of the interpreter for the glyph 
+ * programs in the module and for every function whose definition matches the
+ * location of a compiled function, including functions that are defined 
+ * after registration. Anything else is still interpreted. `module` must 
+ * outlive the font and passing NULL unregisters the current module.
+ *
+ * Returns one of the following:
+ *     TTY_ERROR_NONE                - The module was registered.
+ *     TTY_ERROR_OUT_OF_MEMORY       - Not enough memory could be allocated for the compiled program tables.
+ *     TTY_ERROR_UNSUPPORTED_FEATURE - The font doesn't have hinting.
+ *     TTY_ERROR_MODULE_MISMATCH     - The module was generated from a different font. The current module is kept.
+ */
+TTY_Error tty_font_register_compiled_module(TTY_Font* font, const TTY_Compiled_Module* module);
+
+/*
+ * Creates a `TTY_Collection` by reading the TrueType collection (.ttc) 
+ * specified by `path` into memory. A regular TTF file is treated as a 
+ * collection with a single face.
+ *
+ * Returns one of the following:
+ *     TTY_ERROR_NONE                - The collection was successfully loaded.
+ *     TTY_ERROR_OUT_OF_MEMORY       - Not enough memory could be allocated to load the file.
+ *     TTY_ERROR_FAILED_TO_READ_FILE - The file contents could not be read.
+ */
+TTY_Error tty_collection_init(TTY_Collection* collection, const char* path);
+
+/*
+ * Same as `tty_collection_init`, except the file is memory-mapped instead of 
+ * read into memory.
+ */
+TTY_Error tty_collection_init_mmap(TTY_Collection* collection, const char* path);
+
+void tty_collection_free(TTY_Collection* collection);
+
 /*
  * Creates a `TTY_Instance` which is an instance of a 'TTY_Font'. Each 
  * `TTY_Instance` corresponds to exactly one font and exactly one size (ppem).
@@ -297,8 +667,82 @@ TTY_Error tty_instance_init(TTY_Font* font, TTY_Instance* instance, TTY_U32 ppem
  */
 TTY_Error tty_instance_resize(TTY_Font* font, TTY_Instance* instance, TTY_U32 ppem);
 
+/*
+ * Serializes the state produced by executing the CV program for `instance` 
+ * (the CVT, storage area, zone 0, and the function table as file offsets) 
+ * into `data`. If `data` is NULL, the required size is written to `size`. 
+ * Otherwise, `size` must contain the capacity of `data` and is set to the 
+ * number of bytes written. The snapshot is keyed by the font checksum and the
+ * instance's ppem and flags.
+ *
+ * Returns one of the following:
+ *     TTY_ERROR_NONE                - The snapshot was successfully created, or its size was written.
+ *     TTY_ERROR_BUFFER_TOO_SMALL    - `size` is smaller than the size of the snapshot. Nothing is written to `data`.
+ *     TTY_ERROR_UNSUPPORTED_FEATURE - The instance doesn't use hinting.
+ */
+TTY_Error tty_instance_save_snapshot(TTY_Font* font, TTY_Instance* instance, TTY_U8* data, TTY_U32* size);
+
+/*
+ * Same as `tty_instance_init`, except the state produced by the CV program is
+ * restored from a snapshot created by `tty_instance_save_snapshot` instead of
+ * executing it. Only the instance's state is restored, the font isn't 
+ * modified other than executing a deferred font program (see 
+ * TTY_FONT_DEFER_FONT_PROGRAM). The snapshot is ignored if the instance 
+ * doesn't use hinting.
+ *
+ * Returns the same errors as `tty_instance_init`, in addition to:
+ *     TTY_ERROR_SNAPSHOT_MISMATCH - The snapshot doesn't belong to this font, ppem, and flags, is invalid, or was saved 
+ *                                   when the font's function table was different (i.e. the CV program defines
+ *                                   functions that the font doesn't have yet). The instance was still created by
+ *                                   executing the CV program, so it must be freed, and a new snapshot should be
+ *                                   saved.
+ */
+TTY_Error tty_instance_init_from_snapshot(TTY_Font* font, TTY_Instance* instance, TTY_U32 ppem, TTY_U32 flags, const TTY_U8* data, TTY_U32 size);
+
 void tty_instance_free(TTY_Instance* instance);
 
+/*
+ * Enables an LRU cache of hinted glyph outlines (the hinted points, including
+ * the phantom points that determine the advance) that holds at most 
+ * `maxBytes` bytes. Rendering or measuring a glyph that is in the cache 
+ * doesn't execute its glyph program, which helps when glyphs are rendered 
+ * again after being evicted from an atlas cache. The cache is emptied 
+ * whenever the instance is resized and is only used while the instance uses
+ * hinting. Any previously cached outlines are discarded and passing 0 
+ * disables the cache. The hit and miss counts are available in 
+ * `instance->hintedCache`.
+ *
+ * Returns one of the following:
+ *     TTY_ERROR_NONE          - The cache was enabled.
+ *     TTY_ERROR_OUT_OF_MEMORY - Not enough memory could be allocated for the cache's hash table.
+ */
+TTY_Error tty_instance_enable_hinted_cache(TTY_Font* font, TTY_Instance* instance, TTY_U32 maxBytes);
+
+/*
+ * Creates a `TTY_Render_Context` which holds the scratch data that is written
+ * to while a glyph of `font` is loaded, hinted, and rasterized. Every font has
+ * a render context of its own which is used by the functions that don't take 
+ * one, so those functions must not be called on the same font from more than
+ * one thread at a time. Passing a separate render context to each thread's 
+ * calls of the `_with_context` functions allows the font and its instances to
+ * be shared between threads, since rendering doesn't modify them, as long as:
+ *     - The font's outline cache and the instances' hinted caches are disabled.
+ *     - Instances are not created, resized, or freed while glyphs are rendered.
+ *     - `tty_get_glyph_complexity` is only used if the font was created with 
+ *       TTY_FONT_CACHE_COMPLEXITY.
+ * A render context can be used with any instance of the font it was created 
+ * for, but not with other fonts. The glyph programs of hinted glyphs are 
+ * decoded the first time each glyph is rendered with the render context and
+ * kept until it is freed.
+ *
+ * Returns one of the following:
+ *     TTY_ERROR_NONE          - The render context was successfully created.
+ *     TTY_ERROR_OUT_OF_MEMORY - Not enough memory could be allocated for the render context.
+ */
+TTY_Error tty_render_context_init(TTY_Font* font, TTY_Render_Context* render);
+
+void tty_render_context_free(TTY_Render_Context* render);
+
 
 /* 
  * Returns one of the following:
@@ -307,12 +751,42 @@ void tty_instance_free(TTY_Instance* instance);
  */
 TTY_Error tty_get_glyph_index(TTY_Font* font, TTY_U32 codePoint, TTY_U32* idx);
 
+/*
+ * Decodes `len` bytes of UTF-8 text and writes the glyph index of each code 
+ * point to `indices`, which must have room for `len` entries. Malformed UTF-8 
+ * is decoded as U+FFFD. Code points that are not in the font are written as 
+ * glyph 0 and counted in `numMissing`.
+ *
+ * Returns one of the following:
+ *     TTY_ERROR_NONE - The text was converted and `numIndices` entries were written.
+ */
+TTY_Error tty_get_glyph_indices_utf8(TTY_Font* font, const char* text, TTY_U32 len, TTY_U32* indices, TTY_U32* numIndices, TTY_U32* numMissing);
+
 /*
  * Returns one of the following:
  *     TTY_ERROR_NONE - The glyph was successfully loaded.
  */
 TTY_Error tty_glyph_init(TTY_Font* font, TTY_Glyph* glyph, TTY_U32 idx);
 
+/*
+ * Gets the number of points, contours, contour segments, and glyph program 
+ * bytes of the glyph. These are looked up if the font was created with 
+ * TTY_FONT_CACHE_COMPLEXITY, otherwise the glyph is decoded.
+ *
+ * Returns one of the following:
+ *     TTY_ERROR_NONE - The complexity was successfully calculated.
+ */
+TTY_Error tty_get_glyph_complexity(TTY_Font* font, TTY_U32 idx, TTY_Glyph_Complexity* complexity);
+
+/*
+ * Estimates how many edges the glyph's outline is flattened into at the 
+ * instance's size. The estimate is an upper bound for the unhinted outline,
+ * which makes it useful for sizing buffers and balancing work between 
+ * threads. Hinting can move points far enough to exceed the bound, so the
+ * estimate includes a margin of one half for instances that use hinting.
+ */
+TTY_U32 tty_estimate_glyph_edges(TTY_Instance* instance, TTY_Glyph_Complexity* complexity);
+
 
 /*
  * Returns one of the following:
@@ -324,25 +798,75 @@ TTY_Error tty_image_init(TTY_Image* image, TTY_U8* pixels, TTY_U32 w, TTY_U32 h,
 void tty_image_free(TTY_Image* image);
 
 
+/*
+ * Calculates the glyph's advance, offset, and size without rasterizing it. 
+ * These are the same values that rendering the glyph would produce. The 
+ * glyph program is executed if the instance uses hinting, unless the glyph 
+ * has an embedded bitmap at the instance's ppem, in which case the bitmap's 
+ * metrics are used.
+ *
+ * Returns one of the following:
+ *    TTY_ERROR_NONE                - The metrics were calculated successfully.
+ *    TTY_ERROR_FILE_IS_CORRUPTED   - The glyph is a composite glyph that is truncated, nests too deeply, or matches a point which doesn't exist.
+ *    TTY_ERROR_UNKNOWN_INSTRUCTION - The instance uses hinting and the glyph program has an instruction that is not yet handled.
+ */
+TTY_Error tty_get_glyph_metrics(TTY_Font* font, TTY_Instance* instance, TTY_Glyph* glyph);
+
+/* Same as `tty_get_glyph_metrics`, but uses `render` instead of the font's render context */
+TTY_Error tty_get_glyph_metrics_with_context(TTY_Font* font, TTY_Instance* instance, TTY_Render_Context* render, TTY_Glyph* glyph);
+
+/*
+ * Gets the glyph's horizontal advance in pixels. If the glyph has an embedded
+ * bitmap at the instance's ppem, the bitmap's advance is used. Otherwise, if 
+ * the instance uses hinting, the advance is taken from the font's hdmx table,
+ * or scaled linearly if the font's LTSH table says the glyph's advance is 
+ * linear at the instance's ppem. Otherwise, the glyph program is executed the
+ * same as `tty_get_glyph_metrics`.
+ *
+ * Returns one of the following:
+ *    TTY_ERROR_NONE                - The advance was calculated successfully.
+ *    TTY_ERROR_FILE_IS_CORRUPTED   - The glyph is a composite glyph that is truncated, nests too deeply, or matches a point which doesn't exist.
+ *    TTY_ERROR_UNKNOWN_INSTRUCTION - The instance uses hinting and the glyph program has an instruction that is not yet handled.
+ */
+TTY_Error tty_get_glyph_x_advance(TTY_Font* font, TTY_Instance* instance, TTY_Glyph* glyph, TTY_S32* advance);
+
+/* Same as `tty_get_glyph_x_advance`, but uses `render` instead of the font's render context */
+TTY_Error tty_get_glyph_x_advance_with_context(TTY_Font* font, TTY_Instance* instance, TTY_Render_Context* render, TTY_Glyph* glyph, TTY_S32* advance);
+
 /* 
+ * Renders the glyph into a newly allocated image that tightly bounds it. If 
+ * the font has an embedded bitmap strike (EBLC/EBDT, or a grayscale CBLC/CBDT
+ * strike) for the instance's ppem which contains the glyph, the bitmap is 
+ * copied into the image instead of rasterizing the outline. This can be 
+ * disabled with TTY_INSTANCE_NO_EMBEDDED_BITMAPS.
+ *
  * Returns one of the following:
  *    TTY_ERROR_NONE                - The glyph was rendered successfully.
  *    TTY_ERROR_OUT_OF_MEMORY       - Not enough memory could be allocated to render the glyph.
- *    TTY_ERROR_UNSUPPORTED_FEATURE - The glyph is a composite glyph that uses point matching.
+ *    TTY_ERROR_FILE_IS_CORRUPTED   - The glyph is a composite glyph that is truncated, nests too deeply, or matches a point which doesn't exist.
  *    TTY_ERROR_UNKNOWN_INSTRUCTION - The instance uses hinting and the glyph program has an instruction that is not yet handled.
  */
 TTY_Error tty_render_glyph(TTY_Font* font, TTY_Instance* instance, TTY_Glyph* glyph, TTY_Image* image);
 
+/* Same as `tty_render_glyph`, but uses `render` instead of the font's render context */
+TTY_Error tty_render_glyph_with_context(TTY_Font* font, TTY_Instance* instance, TTY_Render_Context* render, TTY_Glyph* glyph, TTY_Image* image);
+
 /* 
+ * Same as `tty_render_glyph`, but renders the glyph into `image` with its
+ * top-left corner at (x, y).
+ *
  * Returns one of the following:
  *    TTY_ERROR_NONE                        - The glyph was rendered successfully.
  *    TTY_ERROR_OUT_OF_MEMORY               - Not enough memory could be allocated to render the glyph.
- *    TTY_ERROR_UNSUPPORTED_FEATURE         - The glyph is a composite glyph that uses point matching.
+ *    TTY_ERROR_FILE_IS_CORRUPTED           - The glyph is a composite glyph that is truncated, nests too deeply, or matches a point which doesn't exist.
  *    TTY_ERROR_UNKNOWN_INSTRUCTION         - The instance uses hinting and the glyph program has an instruction that is not yet handled.
  *    TTY_ERROR_GLYPH_DOES_NOT_FIT_IN_IMAGE - The provided image is not large enough to contain the rasterized glyph.
  */
 TTY_Error tty_render_glyph_to_existing_image(TTY_Font* font, TTY_Instance* instance, TTY_Glyph* glyph, TTY_Image* image, TTY_U32 x, TTY_U32 y);
 
+/* Same as `tty_render_glyph_to_existing_image`, but uses `render` instead of the font's render context */
+TTY_Error tty_render_glyph_to_existing_image_with_context(TTY_Font* font, TTY_Instance* instance, TTY_Render_Context* render, TTY_Glyph* glyph, TTY_Image* image, TTY_U32 x, TTY_U32 y);
+
 /*
  * Returns one of the following:
  *     TTY_ERROR_NONE          - The cache was successfully created.
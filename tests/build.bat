@@ -0,0 +1,17 @@
+@echo off
+
+:: The compiled module tests use a module generated from the first test font
+cl /Fe.\compile_font ../tools/compile_font.c ../src/*.c -I../src
+if not %errorlevel%==0 exit /b %errorlevel%
+
+.\compile_font.exe ../examples/fonts/Roboto-Regular.ttf compiled_module.c testModule
+if not %errorlevel%==0 exit /b %errorlevel%
+
+cl /Fe.\render_tests render_tests.c compiled_module.c ../src/*.c -I../src
+
+if %errorlevel%==0 (
+    del *.obj
+    if "%1"=="run" (
+        .\render_tests.exe
+    )
+)
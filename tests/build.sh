@@ -0,0 +1,10 @@
+#!/bin/bash
+
+# The compiled module tests use a module generated from the first test font
+gcc -Wall -std=c11 -ocompile_font.out ../tools/compile_font.c ../src/*.c -I../src &&
+./compile_font.out ../examples/fonts/Roboto-Regular.ttf compiled_module.c testModule &&
+gcc -Wall -std=c11 -orender_tests.out render_tests.c compiled_module.c ../src/*.c -I../src
+
+if [ $? = 0 ] && [ "$1" = "run" ]; then
+    ./render_tests.out
+fi
@@ -0,0 +1,1358 @@
+#include <stdlib.h>
+#include <stdio.h>
+#include <string.h>
+#include "truety.h"
+
+static const char* fontPaths[] = {
+    "../examples/fonts/Roboto-Regular.ttf",
+    "../examples/fonts/BakbakOne-Regular.ttf",
+};
+
+#define NUM_FONTS (sizeof(fontPaths) / sizeof(fontPaths[0]))
+
+/* Generated from fontPaths[0] by build.sh */
+extern const TTY_Compiled_Module testModule;
+
+static int numFailures = 0;
+
+#define CHECK(cond, ...)                                  \
+    do {                                                  \
+        if (!(cond)) {                                    \
+            printf("    FAILED: " __VA_ARGS__);           \
+            printf("\n");                                 \
+            numFailures++;                                \
+        }                                                 \
+    } while (0)
+
+
+/* ----- */
+/* Files */
+/* ----- */
+static TTY_U8* read_file(const char* path, TTY_S32* size) {
+    FILE* file = fopen(path, "rb");
+    if (file == NULL) {
+        return NULL;
+    }
+
+    fseek(file, 0, SEEK_END);
+    *size = ftell(file);
+    fseek(file, 0, SEEK_SET);
+
+    TTY_U8* data = (TTY_U8*)malloc(*size);
+    if (data != NULL && fread(data, 1, *size, file) != (size_t)*size) {
+        free(data);
+        data = NULL;
+    }
+
+    fclose(file);
+    return data;
+}
+
+static TTY_U32 get_u32(const TTY_U8* data) {
+    return (TTY_U32)data[0] << 24 | data[1] << 16 | data[2] << 8 | data[3];
+}
+
+static void set_u16(TTY_U8* data, TTY_U32 val) {
+    data[0] = (TTY_U8)(val >> 8);
+    data[1] = (TTY_U8)val;
+}
+
+static void set_u32(TTY_U8* data, TTY_U32 val) {
+    set_u16(data, val >> 16);
+    set_u16(data + 2, val);
+}
+
+// Copies the font in `data` with the table `tag` replaced by `table`, or with
+// `table` added if the font doesn't have the table. The example fonts don't
+// have every kind of table, so tests build the fonts they need this way.
+static TTY_U8* build_font_with_table(const TTY_U8* data, const char* tag, const TTY_U8* table, TTY_U32 tableSize, TTY_S32* size) {
+    TTY_U32 numTables    = data[4] << 8 | data[5];
+    TTY_U32 numNewTables = numTables + 1;
+    TTY_U32 totalSize    = 12 + 16 * numNewTables + ((tableSize + 3) & ~3u);
+
+    for (TTY_U32 i = 0; i < numTables; i++) {
+        const TTY_U8* record = data + 12 + 16 * i;
+        if (memcmp(record, tag, 4) == 0) {
+            numNewTables--;
+            totalSize -= 16;
+        }
+        else {
+            totalSize += (get_u32(record + 12) + 3) & ~3u;
+        }
+    }
+
+    TTY_U8* font = (TTY_U8*)calloc(totalSize, 1);
+    if (font == NULL) {
+        return NULL;
+    }
+
+    memcpy(font, data, 12);
+    set_u16(font + 4, numNewTables);
+
+    TTY_U32 off = 12 + 16 * numNewTables;
+
+    for (TTY_U32 i = 0, j = 0; i <= numTables; i++) {
+        const TTY_U8* record = data + 12 + 16 * i;
+        const TTY_U8* src;
+        TTY_U32       srcSize;
+
+        if (i == numTables) {
+            if (numNewTables == numTables) {
+                break;
+            }
+            record  = (const TTY_U8*)tag;
+            src     = table;
+            srcSize = tableSize;
+        }
+        else if (memcmp(record, tag, 4) == 0) {
+            src     = table;
+            srcSize = tableSize;
+        }
+        else {
+            src     = data + get_u32(record + 8);
+            srcSize = get_u32(record + 12);
+        }
+
+        TTY_U8* newRecord = font + 12 + 16 * j++;
+        memcpy(newRecord, record, 4);
+        set_u32(newRecord +  8, off);
+        set_u32(newRecord + 12, srcSize);
+        memcpy(font + off, src, srcSize);
+        off += (srcSize + 3) & ~3u;
+    }
+
+    *size = (TTY_S32)totalSize;
+    return font;
+}
+
+
+/* --------------- */
+/* Rendered Glyphs */
+/* --------------- */
+typedef struct {
+    TTY_Error  error;
+    TTY_V2     offset;
+    TTY_V2     advance;
+    TTY_V2     size;
+    TTY_Image  image;
+} Rendered_Glyph;
+
+static void render(TTY_Font* font, TTY_Instance* instance, TTY_U32 glyphIdx, Rendered_Glyph* result) {
+    memset(result, 0, sizeof(Rendered_Glyph));
+
+    TTY_Glyph glyph;
+    result->error = tty_glyph_init(font, &glyph, glyphIdx);
+    if (result->error == TTY_ERROR_NONE) {
+        result->error   = tty_render_glyph(font, instance, &glyph, &result->image);
+        result->offset  = glyph.offset;
+        result->advance = glyph.advance;
+        result->size    = glyph.size;
+    }
+}
+
+static void rendered_glyph_free(Rendered_Glyph* glyph) {
+    if (glyph->error == TTY_ERROR_NONE) {
+        tty_image_free(&glyph->image);
+    }
+}
+
+static int rendered_glyphs_equal(Rendered_Glyph* a, Rendered_Glyph* b) {
+    if (a->error     != b->error     ||
+        a->offset.x  != b->offset.x  || a->offset.y  != b->offset.y  ||
+        a->advance.x != b->advance.x || a->advance.y != b->advance.y ||
+        a->size.x    != b->size.x    || a->size.y    != b->size.y) {
+        return 0;
+    }
+    if (a->error != TTY_ERROR_NONE) {
+        return 1;
+    }
+    if (a->image.size.x != b->image.size.x || a->image.size.y != b->image.size.y) {
+        return 0;
+    }
+    if (a->image.pixels == NULL || b->image.pixels == NULL) {
+        return a->image.pixels == b->image.pixels;
+    }
+    return memcmp(a->image.pixels, b->image.pixels, a->image.size.x * a->image.size.y * a->image.numChannels) == 0;
+}
+
+// Renders every glyph in order with the reference instance, then every glyph
+// again with the other instance, in reverse order if `reverse` is set, and 
+// checks that each glyph is the same both times
+static void check_renders_match(TTY_Font* reference, TTY_Instance* referenceInstance, TTY_Font* font, TTY_Instance* instance, int reverse, const char* desc) {
+    Rendered_Glyph* glyphs = (Rendered_Glyph*)malloc(reference->numGlyphs * sizeof(Rendered_Glyph));
+    if (glyphs == NULL) {
+        CHECK(0, "%s: out of memory", desc);
+        return;
+    }
+
+    for (TTY_U32 i = 0; i < reference->numGlyphs; i++) {
+        render(reference, referenceInstance, i, glyphs + i);
+    }
+
+    TTY_U32 numMismatches = 0;
+    for (TTY_U32 i = 0; i < reference->numGlyphs; i++) {
+        TTY_U32        glyphIdx = reverse ? reference->numGlyphs - 1 - i : i;
+        Rendered_Glyph glyph;
+        render(font, instance, glyphIdx, &glyph);
+        if (!rendered_glyphs_equal(glyphs + glyphIdx, &glyph)) {
+            numMismatches++;
+        }
+        rendered_glyph_free(&glyph);
+    }
+    CHECK(numMismatches == 0, "%s: %u glyphs differ", desc, numMismatches);
+
+    for (TTY_U32 i = 0; i < reference->numGlyphs; i++) {
+        rendered_glyph_free(glyphs + i);
+    }
+    free(glyphs);
+}
+
+// Checks that two fonts created from the same file render every glyph the 
+// same at `ppem`
+static void check_fonts_render_the_same(TTY_Font* reference, TTY_Font* font, TTY_U32 ppem, const char* desc) {
+    TTY_Instance referenceInstance, instance;
+    if (tty_instance_init(reference, &referenceInstance, ppem, TTY_INSTANCE_DEFAULT)) {
+        CHECK(0, "%s: failed to create the reference instance", desc);
+        return;
+    }
+    if (tty_instance_init(font, &instance, ppem, TTY_INSTANCE_DEFAULT)) {
+        CHECK(0, "%s: failed to create the instance", desc);
+        tty_instance_free(&referenceInstance);
+        return;
+    }
+
+    check_renders_match(reference, &referenceInstance, font, &instance, 0, desc);
+
+    tty_instance_free(&referenceInstance);
+    tty_instance_free(&instance);
+}
+
+
+/* ----- */
+/* Tests */
+/* ----- */
+static void test_render_is_independent_of_previous_glyphs(TTY_Font* font, const char* path) {
+    static const TTY_U32 ppems[] = {9, 12, 18, 31};
+
+    for (TTY_U32 i = 0; i < sizeof(ppems) / sizeof(ppems[0]); i++) {
+        TTY_Instance instance;
+        if (tty_instance_init(font, &instance, ppems[i], TTY_INSTANCE_DEFAULT)) {
+            continue;
+        }
+
+        char desc[256];
+        snprintf(desc, sizeof(desc), "%s at %u ppem", path, ppems[i]);
+        check_renders_match(font, &instance, font, &instance, 1, desc);
+
+        // The same glyph rendered twice in a row
+        TTY_U32 numMismatches = 0;
+        for (TTY_U32 j = 0; j < font->numGlyphs; j++) {
+            Rendered_Glyph a, b;
+            render(font, &instance, j, &a);
+            render(font, &instance, j, &b);
+            if (!rendered_glyphs_equal(&a, &b)) {
+                numMismatches++;
+            }
+            rendered_glyph_free(&a);
+            rendered_glyph_free(&b);
+        }
+        CHECK(numMismatches == 0, "%s: %u glyphs differ when rendered twice in a row", desc, numMismatches);
+
+        tty_instance_free(&instance);
+    }
+}
+
+static void test_hinted_cache_matches_uncached(TTY_Font* font, const char* path) {
+    static const TTY_U32 ppems[] = {12, 20};
+
+    for (TTY_U32 i = 0; i < sizeof(ppems) / sizeof(ppems[0]); i++) {
+        TTY_Instance uncached, cached;
+        if (tty_instance_init(font, &uncached, ppems[i], TTY_INSTANCE_DEFAULT)) {
+            continue;
+        }
+        if (tty_instance_init(font, &cached, ppems[i], TTY_INSTANCE_DEFAULT)) {
+            tty_instance_free(&uncached);
+            continue;
+        }
+
+        // The cache is small enough that glyphs are evicted, so each pass 
+        // renders a different mix of cached and uncached glyphs since the 
+        // order alternates
+        CHECK(tty_instance_enable_hinted_cache(font, &cached, 1 << 16) == TTY_ERROR_NONE, "%s: failed to enable the hinted cache", path);
+
+        for (TTY_U32 pass = 0; pass < 3; pass++) {
+            char desc[256];
+            snprintf(desc, sizeof(desc), "%s at %u ppem with the hinted cache (pass %u)", path, ppems[i], pass);
+            check_renders_match(font, &uncached, font, &cached, pass % 2, desc);
+        }
+        CHECK(!cached.useHinting || cached.hintedCache.numHits > 0, "%s at %u ppem: the hinted cache was never hit", path, ppems[i]);
+
+        tty_instance_free(&uncached);
+        tty_instance_free(&cached);
+    }
+}
+
+static void test_mmap_font_matches_read_font(TTY_Font* font, const char* path) {
+    TTY_Font mapped;
+    if (tty_font_init_mmap(&mapped, path)) {
+        CHECK(0, "%s: failed to memory-map the font", path);
+        return;
+    }
+
+    CHECK(mapped.numGlyphs == font->numGlyphs, "%s: the mapped font has %u glyphs instead of %u", path, mapped.numGlyphs, font->numGlyphs);
+    CHECK(tty_font_get_checksum(&mapped) == tty_font_get_checksum(font), "%s: the mapped font has a different checksum", path);
+
+    char desc[256];
+    snprintf(desc, sizeof(desc), "%s memory-mapped", path);
+    check_fonts_render_the_same(font, &mapped, 12, desc);
+
+    tty_font_free(&mapped);
+
+    CHECK(tty_font_init_mmap(&mapped, "does-not-exist.ttf") == TTY_ERROR_FAILED_TO_READ_FILE, "mapping a missing file didn't fail");
+}
+
+static void test_memory_font_matches_read_font(TTY_Font* font, const char* path) {
+    TTY_S32 size;
+    TTY_U8* data = read_file(path, &size);
+    if (data == NULL) {
+        CHECK(0, "%s: failed to read the file", path);
+        return;
+    }
+
+    TTY_Font memoryFont;
+    if (tty_font_init_from_memory(&memoryFont, data, size)) {
+        CHECK(0, "%s: failed to load the font from memory", path);
+        free(data);
+        return;
+    }
+
+    CHECK(memoryFont.fileData == data, "%s: the font data was copied", path);
+    CHECK(tty_font_get_checksum(&memoryFont) == tty_font_get_checksum(font), "%s: the font loaded from memory has a different checksum", path);
+
+    char desc[256];
+    snprintf(desc, sizeof(desc), "%s loaded from memory", path);
+    check_fonts_render_the_same(font, &memoryFont, 12, desc);
+
+    tty_font_free(&memoryFont);
+
+    // Data that ends within the header, the table directory, and the glyf
+    // table
+    TTY_S32 truncatedSizes[] = {0, 11, 40, (TTY_S32)font->glyf.off + 1};
+    for (TTY_U32 i = 0; i < sizeof(truncatedSizes) / sizeof(truncatedSizes[0]); i++) {
+        CHECK(tty_font_init_from_memory(&memoryFont, data, truncatedSizes[i]) == TTY_ERROR_FILE_IS_CORRUPTED, "%s: loading the first %d bytes didn't fail", path, truncatedSizes[i]);
+    }
+
+    free(data);
+}
+
+static void test_loca_cache_matches_uncached(TTY_Font* font, const char* path) {
+    TTY_Font cached;
+    if (tty_font_init_ex(&cached, path, TTY_FONT_CACHE_LOCA)) {
+        CHECK(0, "%s: failed to load the font with TTY_FONT_CACHE_LOCA", path);
+        return;
+    }
+
+    CHECK(cached.glyfOffsets != NULL, "%s: the loca table wasn't decoded", path);
+
+    char desc[256];
+    snprintf(desc, sizeof(desc), "%s with the loca cache", path);
+    check_fonts_render_the_same(font, &cached, 12, desc);
+
+    tty_font_free(&cached);
+}
+
+static void test_bmp_cache_matches_uncached(TTY_Font* font, const char* path) {
+    TTY_Font cached;
+    if (tty_font_init_ex(&cached, path, TTY_FONT_CACHE_BMP)) {
+        CHECK(0, "%s: failed to load the font with TTY_FONT_CACHE_BMP", path);
+        return;
+    }
+
+    CHECK(cached.bmpGlyphIndices != NULL, "%s: the BMP glyph indices weren't cached", path);
+
+    // The code points past the BMP are still looked up in the subtable
+    TTY_U32 numMismatches = 0;
+    for (TTY_U32 cp = 0; cp < 0x20000; cp++) {
+        TTY_U32 uncachedIdx, cachedIdx;
+        tty_get_glyph_index(font, cp, &uncachedIdx);
+        tty_get_glyph_index(&cached, cp, &cachedIdx);
+        if (uncachedIdx != cachedIdx) {
+            numMismatches++;
+        }
+    }
+    CHECK(numMismatches == 0, "%s: %u code points map to different glyphs with the BMP cache", path, numMismatches);
+
+    tty_font_free(&cached);
+}
+
+typedef struct {
+    const char*  desc;
+    const char*  text;
+    TTY_U32      codePoints[48];
+    TTY_U32      numCodePoints;
+} UTF8_Case;
+
+static const UTF8_Case utf8Cases[] = {
+    {"empty", "", {0}, 0},
+    {"ASCII", "The quick brown fox jumps over the lazy dog", {
+        'T', 'h', 'e', ' ', 'q', 'u', 'i', 'c', 'k', ' ', 'b', 'r', 'o', 'w', 'n', ' ', 'f', 'o', 'x', ' ', 'j', 'u',
+        'm', 'p', 's', ' ', 'o', 'v', 'e', 'r', ' ', 't', 'h', 'e', ' ', 'l', 'a', 'z', 'y', ' ', 'd', 'o', 'g'}, 43},
+    {"2, 3, and 4 byte sequences", "a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80z", {'a', 0xE9, 0x20AC, 0x1F600, 'z'}, 5},
+    {"lone continuation byte", "a\x80" "b", {'a', 0xFFFD, 'b'}, 3},
+    {"overlong encoding", "\xC0\xAF", {0xFFFD, 0xFFFD}, 2},
+    {"truncated sequence followed by ASCII", "\xE2\x82" "A", {0xFFFD, 'A'}, 2},
+    {"truncated sequence at the end", "A\xF0\x9F\x98", {'A', 0xFFFD}, 2},
+    {"surrogate", "\xED\xA0\x80", {0xFFFD, 0xFFFD, 0xFFFD}, 3},
+    {"code point above U+10FFFF", "\xF4\x90\x80\x80", {0xFFFD, 0xFFFD, 0xFFFD, 0xFFFD}, 4},
+    {"invalid lead byte", "\xF5\xFF", {0xFFFD, 0xFFFD}, 2},
+};
+
+static void check_utf8_cases(TTY_Font* font, const char* desc) {
+    for (TTY_U32 i = 0; i < sizeof(utf8Cases) / sizeof(utf8Cases[0]); i++) {
+        const UTF8_Case* test = utf8Cases + i;
+        TTY_U32          len  = (TTY_U32)strlen(test->text);
+        TTY_U32          indices[64];
+        TTY_U32          numIndices, numMissing;
+
+        TTY_Error error = tty_get_glyph_indices_utf8(font, test->text, len, indices, &numIndices, &numMissing);
+        CHECK(error == TTY_ERROR_NONE, "%s: %s: error %d", desc, test->desc, error);
+        if (error != TTY_ERROR_NONE) {
+            continue;
+        }
+
+        CHECK(numIndices == test->numCodePoints, "%s: %s: decoded %u code points instead of %u", desc, test->desc, numIndices, test->numCodePoints);
+        if (numIndices != test->numCodePoints) {
+            continue;
+        }
+
+        TTY_U32 expectedMissing = 0;
+        for (TTY_U32 j = 0; j < numIndices; j++) {
+            TTY_U32 idx;
+            tty_get_glyph_index(font, test->codePoints[j], &idx);
+            CHECK(indices[j] == idx, "%s: %s: code point %u is glyph %u instead of %u", desc, test->desc, j, indices[j], idx);
+            expectedMissing += idx == 0;
+        }
+        CHECK(numMissing == expectedMissing, "%s: %s: %u missing glyphs instead of %u", desc, test->desc, numMissing, expectedMissing);
+    }
+}
+
+static void test_utf8_glyph_indices(TTY_Font* font, const char* path) {
+    check_utf8_cases(font, path);
+
+    // ASCII is looked up directly in the BMP cache
+    TTY_Font cached;
+    if (tty_font_init_ex(&cached, path, TTY_FONT_CACHE_BMP)) {
+        CHECK(0, "%s: failed to load the font with TTY_FONT_CACHE_BMP", path);
+        return;
+    }
+
+    char desc[256];
+    snprintf(desc, sizeof(desc), "%s with the BMP cache", path);
+    check_utf8_cases(&cached, desc);
+
+    tty_font_free(&cached);
+}
+
+// Writes the example fonts into one collection file. Each face keeps its own
+// tables, which are offset by where the face is placed in the file.
+static int write_collection(const char* collectionPath) {
+    TTY_U32 headerSize = 12 + 4 * NUM_FONTS;
+    TTY_U8  header[12 + 4 * NUM_FONTS];
+    TTY_U8* faces[NUM_FONTS];
+    TTY_S32 faceSizes[NUM_FONTS];
+    TTY_U32 faceOff = headerSize;
+    int     success = 1;
+
+    memcpy(header, "ttcf", 4);
+    set_u32(header + 4, 0x00010000);
+    set_u32(header + 8, NUM_FONTS);
+
+    for (TTY_U32 i = 0; i < NUM_FONTS; i++) {
+        faces[i] = read_file(fontPaths[i], faceSizes + i);
+        if (faces[i] == NULL) {
+            success = 0;
+            continue;
+        }
+
+        TTY_U32 numTables = faces[i][4] << 8 | faces[i][5];
+        for (TTY_U32 j = 0; j < numTables; j++) {
+            TTY_U8* record = faces[i] + 12 + 16 * j;
+            set_u32(record + 8, get_u32(record + 8) + faceOff);
+        }
+
+        set_u32(header + 12 + 4 * i, faceOff);
+        faceOff += (faceSizes[i] + 3) & ~3u;
+    }
+
+    FILE* file = success ? fopen(collectionPath, "wb") : NULL;
+    if (file != NULL) {
+        static const TTY_U8 padding[3] = {0};
+        fwrite(header, 1, headerSize, file);
+        for (TTY_U32 i = 0; i < NUM_FONTS; i++) {
+            fwrite(faces[i], 1, faceSizes[i], file);
+            fwrite(padding, 1, (4 - faceSizes[i] % 4) % 4, file);
+        }
+        success = fclose(file) == 0;
+    }
+    else {
+        success = 0;
+    }
+
+    for (TTY_U32 i = 0; i < NUM_FONTS; i++) {
+        free(faces[i]);
+    }
+    return success;
+}
+
+static void check_collection_faces(TTY_Collection* collection, const char* desc) {
+    CHECK(collection->numFaces == NUM_FONTS, "%s: the collection has %u faces instead of %u", desc, collection->numFaces, (TTY_U32)NUM_FONTS);
+
+    for (TTY_U32 i = 0; i < NUM_FONTS; i++) {
+        TTY_Font reference, face;
+        if (tty_font_init(&reference, fontPaths[i])) {
+            CHECK(0, "%s: failed to load %s", desc, fontPaths[i]);
+            continue;
+        }
+        if (tty_font_init_from_collection(&face, collection, i)) {
+            CHECK(0, "%s: failed to load face %u", desc, i);
+            tty_font_free(&reference);
+            continue;
+        }
+
+        CHECK(face.fileData == collection->fileData, "%s: face %u doesn't share the collection's data", desc, i);
+        CHECK(face.numGlyphs == reference.numGlyphs, "%s: face %u has %u glyphs instead of %u", desc, i, face.numGlyphs, reference.numGlyphs);
+
+        char faceDesc[256];
+        snprintf(faceDesc, sizeof(faceDesc), "%s face %u", desc, i);
+        check_fonts_render_the_same(&reference, &face, 12, faceDesc);
+
+        tty_font_free(&face);
+        tty_font_free(&reference);
+    }
+
+    TTY_Font font;
+    CHECK(tty_font_init_from_collection(&font, collection, NUM_FONTS) == TTY_ERROR_FILE_IS_CORRUPTED, "%s: loading a face that is out of range didn't fail", desc);
+}
+
+static void test_collection_faces_match_fonts() {
+    static const char* collectionPath = "render_tests.ttc";
+
+    if (!write_collection(collectionPath)) {
+        CHECK(0, "failed to write %s", collectionPath);
+        return;
+    }
+
+    TTY_Collection collection;
+    if (tty_collection_init(&collection, collectionPath) == TTY_ERROR_NONE) {
+        check_collection_faces(&collection, "collection");
+        tty_collection_free(&collection);
+    }
+    else {
+        CHECK(0, "failed to load %s", collectionPath);
+    }
+
+    if (tty_collection_init_mmap(&collection, collectionPath) == TTY_ERROR_NONE) {
+        check_collection_faces(&collection, "memory-mapped collection");
+        tty_collection_free(&collection);
+    }
+    else {
+        CHECK(0, "failed to memory-map %s", collectionPath);
+    }
+
+    remove(collectionPath);
+
+    // A standalone font is a collection with one face
+    if (tty_collection_init(&collection, fontPaths[0]) == TTY_ERROR_NONE) {
+        TTY_Font font;
+        CHECK(collection.numFaces == 1, "%s: the font has %u faces as a collection instead of 1", fontPaths[0], collection.numFaces);
+        if (tty_font_init_from_collection(&font, &collection, 0) == TTY_ERROR_NONE) {
+            tty_font_free(&font);
+        }
+        else {
+            CHECK(0, "%s: failed to load the font from a collection", fontPaths[0]);
+        }
+        tty_collection_free(&collection);
+    }
+    else {
+        CHECK(0, "%s: failed to load the font as a collection", fontPaths[0]);
+    }
+}
+
+static void test_format_12_cmap_cache_matches_uncached(const char* path) {
+    // The groups are sorted by start code point. The second and third groups
+    // overlap the first one and each other, which well-formed fonts don't do.
+    static const TTY_U32 groups[][3] = {
+        {0x00020, 0x0007E,   3},
+        {0x00041, 0x0005A, 100},
+        {0x00050, 0x00060, 300},
+        {0x04E00, 0x04F10, 400},
+        {0x1F600, 0x1F610, 200},
+    };
+    #define NUM_GROUPS (sizeof(groups) / sizeof(groups[0]))
+
+    TTY_U8 cmap[12 + 16 + 12 * NUM_GROUPS] = {0};
+    set_u16(cmap +  2, 1);                       // numTables
+    set_u16(cmap +  4, 3);                       // platformID (Windows)
+    set_u16(cmap +  6, 10);                      // encodingID (Unicode full repertoire)
+    set_u32(cmap +  8, 12);                      // subtable offset
+    set_u16(cmap + 12, 12);                      // format
+    set_u32(cmap + 16, 16 + 12 * NUM_GROUPS);    // length
+    set_u32(cmap + 24, NUM_GROUPS);              // numGroups
+    for (TTY_U32 i = 0; i < NUM_GROUPS; i++) {
+        set_u32(cmap + 28 + 12 * i    , groups[i][0]);
+        set_u32(cmap + 28 + 12 * i + 4, groups[i][1]);
+        set_u32(cmap + 28 + 12 * i + 8, groups[i][2]);
+    }
+
+    TTY_S32 size, fontSize;
+    TTY_U8* data = read_file(path, &size);
+    TTY_U8* fontData = data == NULL ? NULL : build_font_with_table(data, "cmap", cmap, sizeof(cmap), &fontSize);
+    free(data);
+    if (fontData == NULL) {
+        CHECK(0, "%s: failed to build a font with a format 12 cmap", path);
+        return;
+    }
+
+    TTY_Font uncached, cached;
+    if (tty_font_init_from_memory(&uncached, fontData, fontSize)) {
+        CHECK(0, "%s: failed to load the font with a format 12 cmap", path);
+        free(fontData);
+        return;
+    }
+    if (tty_font_init_from_memory_ex(&cached, fontData, fontSize, TTY_FONT_CACHE_CMAP)) {
+        CHECK(0, "%s: failed to load the font with a format 12 cmap and TTY_FONT_CACHE_CMAP", path);
+        tty_font_free(&uncached);
+        free(fontData);
+        return;
+    }
+
+    CHECK(uncached.encoding.format == 12, "%s: the format 12 subtable wasn't selected", path);
+    CHECK(cached.cmapPageDir != NULL, "%s: the cmap page table wasn't built", path);
+
+    // Code points outside of every group, in a group, and in overlapping
+    // groups, which have to map to the same group with and without the cache
+    TTY_U32 numMismatches = 0;
+    for (TTY_U32 cp = 0; cp <= 0x10FFFF; cp++) {
+        TTY_U32 uncachedIdx, cachedIdx;
+        tty_get_glyph_index(&uncached, cp, &uncachedIdx);
+        tty_get_glyph_index(&cached, cp, &cachedIdx);
+        if (uncachedIdx != cachedIdx) {
+            numMismatches++;
+        }
+    }
+    CHECK(numMismatches == 0, "%s: %u code points map to different glyphs with the cmap page table", path, numMismatches);
+
+    static const TTY_U32 expected[][2] = {
+        {0x00021,   4},
+        {0x04E05, 405},
+        {0x04F11,   0},
+        {0x1F601, 201},
+        {0x1F611,   0},
+        {0x10FFFF,  0},
+    };
+    for (TTY_U32 i = 0; i < sizeof(expected) / sizeof(expected[0]); i++) {
+        TTY_U32 idx;
+        tty_get_glyph_index(&cached, expected[i][0], &idx);
+        CHECK(idx == expected[i][1], "%s: U+%04X maps to glyph %u instead of %u", path, expected[i][0], idx, expected[i][1]);
+    }
+
+    #undef NUM_GROUPS
+    tty_font_free(&uncached);
+    tty_font_free(&cached);
+    free(fontData);
+}
+
+static void test_font_program_snapshot(TTY_Font* font, const char* path) {
+    TTY_U32 size;
+    if (tty_font_save_program_snapshot(font, NULL, &size)) {
+        CHECK(!font->hasHinting, "%s: failed to get the size of the font program snapshot", path);
+        return;
+    }
+
+    TTY_U8* snapshot = (TTY_U8*)malloc(size);
+    if (snapshot == NULL) {
+        CHECK(0, "%s: out of memory", path);
+        return;
+    }
+
+    TTY_U32 tooSmall = size - 1;
+    CHECK(tty_font_save_program_snapshot(font, snapshot, &tooSmall) == TTY_ERROR_BUFFER_TOO_SMALL, "%s: saving into a buffer that is too small didn't fail", path);
+    CHECK(tty_font_save_program_snapshot(font, snapshot, &size) == TTY_ERROR_NONE, "%s: failed to save the font program snapshot", path);
+
+    TTY_Font restored;
+    if (tty_font_init_ex(&restored, path, TTY_FONT_DEFER_FONT_PROGRAM) == TTY_ERROR_NONE) {
+        CHECK(restored.isFontProgramPending, "%s: the font program wasn't deferred", path);
+        CHECK(tty_font_load_program_snapshot(&restored, snapshot, size) == TTY_ERROR_NONE, "%s: failed to load the font program snapshot", path);
+        CHECK(!restored.isFontProgramPending, "%s: the font program is still pending after loading the snapshot", path);
+
+        char desc[256];
+        snprintf(desc, sizeof(desc), "%s restored from a font program snapshot", path);
+        check_fonts_render_the_same(font, &restored, 12, desc);
+        tty_font_free(&restored);
+    }
+    else {
+        CHECK(0, "%s: failed to load the font with TTY_FONT_DEFER_FONT_PROGRAM", path);
+    }
+
+    // A snapshot that is truncated or from another library version leaves the
+    // font program pending, so it is executed when an instance is created
+    if (tty_font_init_ex(&restored, path, TTY_FONT_DEFER_FONT_PROGRAM) == TTY_ERROR_NONE) {
+        CHECK(tty_font_load_program_snapshot(&restored, snapshot, size - 1) == TTY_ERROR_SNAPSHOT_MISMATCH, "%s: loading a truncated snapshot didn't fail", path);
+
+        snapshot[7] ^= 0xFF;
+        CHECK(tty_font_load_program_snapshot(&restored, snapshot, size) == TTY_ERROR_SNAPSHOT_MISMATCH, "%s: loading a snapshot with another version didn't fail", path);
+        snapshot[7] ^= 0xFF;
+
+        CHECK(restored.isFontProgramPending, "%s: a rejected snapshot changed the font", path);
+
+        char desc[256];
+        snprintf(desc, sizeof(desc), "%s after rejecting font program snapshots", path);
+        check_fonts_render_the_same(font, &restored, 12, desc);
+        tty_font_free(&restored);
+    }
+    else {
+        CHECK(0, "%s: failed to load the font with TTY_FONT_DEFER_FONT_PROGRAM", path);
+    }
+
+    free(snapshot);
+}
+
+static void test_instance_snapshot(TTY_Font* font, const char* path) {
+    TTY_Instance instance;
+    if (tty_instance_init(font, &instance, 12, TTY_INSTANCE_DEFAULT)) {
+        CHECK(0, "%s: failed to create the instance", path);
+        return;
+    }
+
+    TTY_U32 size;
+    if (tty_instance_save_snapshot(font, &instance, NULL, &size)) {
+        CHECK(!instance.useHinting, "%s: failed to get the size of the instance snapshot", path);
+        tty_instance_free(&instance);
+        return;
+    }
+
+    TTY_U8* snapshot = (TTY_U8*)malloc(size);
+    if (snapshot == NULL) {
+        CHECK(0, "%s: out of memory", path);
+        tty_instance_free(&instance);
+        return;
+    }
+
+    TTY_U32 tooSmall = size - 1;
+    CHECK(tty_instance_save_snapshot(font, &instance, snapshot, &tooSmall) == TTY_ERROR_BUFFER_TOO_SMALL, "%s: saving into a buffer that is too small didn't fail", path);
+    CHECK(tty_instance_save_snapshot(font, &instance, snapshot, &size) == TTY_ERROR_NONE, "%s: failed to save the instance snapshot", path);
+
+    TTY_Instance restored;
+    if (tty_instance_init_from_snapshot(font, &restored, 12, TTY_INSTANCE_DEFAULT, snapshot, size) == TTY_ERROR_NONE) {
+        char desc[256];
+        snprintf(desc, sizeof(desc), "%s restored from an instance snapshot", path);
+        check_renders_match(font, &instance, font, &restored, 0, desc);
+        tty_instance_free(&restored);
+    }
+    else {
+        CHECK(0, "%s: failed to load the instance snapshot", path);
+    }
+
+    // A snapshot saved for another ppem or other flags is rejected, but the
+    // instance is still created by executing the CV program
+    static const struct {
+        TTY_U32     ppem;
+        TTY_U32     flags;
+        const char* desc;
+    } mismatches[] = {
+        {13, TTY_INSTANCE_DEFAULT,                "another ppem"},
+        {12, TTY_INSTANCE_SUBPIXEL_RENDERING_RGB, "other flags"},
+    };
+
+    for (TTY_U32 i = 0; i < sizeof(mismatches) / sizeof(mismatches[0]); i++) {
+        TTY_Error error = tty_instance_init_from_snapshot(font, &restored, mismatches[i].ppem, mismatches[i].flags, snapshot, size);
+        CHECK(error == TTY_ERROR_SNAPSHOT_MISMATCH, "%s: loading an instance snapshot with %s returned %d", path, mismatches[i].desc, error);
+        if (error == TTY_ERROR_NONE || error == TTY_ERROR_SNAPSHOT_MISMATCH) {
+            tty_instance_free(&restored);
+        }
+    }
+
+    TTY_Error error = tty_instance_init_from_snapshot(font, &restored, 12, TTY_INSTANCE_DEFAULT, snapshot, size - 1);
+    CHECK(error == TTY_ERROR_SNAPSHOT_MISMATCH, "%s: loading a truncated instance snapshot returned %d", path, error);
+    if (error == TTY_ERROR_NONE || error == TTY_ERROR_SNAPSHOT_MISMATCH) {
+        char desc[256];
+        snprintf(desc, sizeof(desc), "%s after rejecting an instance snapshot", path);
+        check_renders_match(font, &instance, font, &restored, 0, desc);
+        tty_instance_free(&restored);
+    }
+
+    free(snapshot);
+    tty_instance_free(&instance);
+}
+
+static void test_metrics_match_render(TTY_Font* font, const char* path) {
+    static const TTY_U32 flags[] = {TTY_INSTANCE_DEFAULT, TTY_INSTANCE_NO_HINTING};
+
+    for (TTY_U32 i = 0; i < sizeof(flags) / sizeof(flags[0]); i++) {
+        TTY_Instance instance;
+        if (tty_instance_init(font, &instance, 12, flags[i])) {
+            CHECK(0, "%s: failed to create the instance", path);
+            continue;
+        }
+
+        TTY_U32 numMismatches        = 0;
+        TTY_U32 numAdvanceMismatches = 0;
+
+        for (TTY_U32 j = 0; j < font->numGlyphs; j++) {
+            Rendered_Glyph rendered;
+            render(font, &instance, j, &rendered);
+
+            TTY_Glyph glyph;
+            TTY_Error error = tty_glyph_init(font, &glyph, j);
+            if (error == TTY_ERROR_NONE) {
+                error = tty_get_glyph_metrics(font, &instance, &glyph);
+            }
+
+            if (error != rendered.error ||
+                (error == TTY_ERROR_NONE &&
+                 (glyph.offset.x  != rendered.offset.x  || glyph.offset.y  != rendered.offset.y  ||
+                  glyph.advance.x != rendered.advance.x || glyph.advance.y != rendered.advance.y ||
+                  glyph.size.x    != rendered.size.x    || glyph.size.y    != rendered.size.y))) {
+                numMismatches++;
+            }
+
+            // Hinted advances can come from the hdmx table instead, which is
+            // checked separately
+            if (!instance.useHinting && rendered.error == TTY_ERROR_NONE) {
+                TTY_S32 advance;
+                tty_glyph_init(font, &glyph, j);
+                if (tty_get_glyph_x_advance(font, &instance, &glyph, &advance) || advance != rendered.advance.x) {
+                    numAdvanceMismatches++;
+                }
+            }
+
+            rendered_glyph_free(&rendered);
+        }
+
+        CHECK(numMismatches == 0, "%s: the metrics of %u glyphs differ from the rendered glyphs (flags %u)", path, numMismatches, flags[i]);
+        CHECK(numAdvanceMismatches == 0, "%s: the x advances of %u glyphs differ from the rendered glyphs (flags %u)", path, numAdvanceMismatches, flags[i]);
+
+        tty_instance_free(&instance);
+    }
+}
+
+static void test_hdmx_advances(TTY_Font* font, const char* path) {
+    if (!font->hdmx.exists) {
+        return;
+    }
+
+    const TTY_U8* hdmx       = font->fileData + font->hdmx.off;
+    TTY_S32       numRecords = (TTY_S16)(hdmx[2] << 8 | hdmx[3]);
+    TTY_U32       recordSize = get_u32(hdmx + 4);
+
+    for (TTY_S32 i = 0; i < numRecords; i++) {
+        const TTY_U8* record = hdmx + 8 + i * recordSize;
+
+        TTY_Instance instance;
+        if (tty_instance_init(font, &instance, record[0], TTY_INSTANCE_DEFAULT)) {
+            CHECK(0, "%s: failed to create the instance", path);
+            continue;
+        }
+
+        CHECK(instance.hdmxWidths == record + 2, "%s: the instance at %u ppem doesn't use the hdmx widths", path, record[0]);
+
+        TTY_U32 numMismatches = 0;
+        for (TTY_U32 j = 0; j < font->numGlyphs; j++) {
+            TTY_Glyph glyph;
+            TTY_S32   advance;
+            tty_glyph_init(font, &glyph, j);
+            if (tty_get_glyph_x_advance(font, &instance, &glyph, &advance) || advance != record[2 + j]) {
+                numMismatches++;
+            }
+        }
+        CHECK(numMismatches == 0, "%s: %u advances differ from the hdmx widths at %u ppem", path, numMismatches, record[0]);
+
+        tty_instance_free(&instance);
+    }
+
+    // Sizes without a record fall back to executing the glyph programs
+    TTY_U32 ppem = 1;
+    for (TTY_S32 i = 0; i < numRecords; i++) {
+        if (hdmx[8 + i * recordSize] >= ppem) {
+            ppem = hdmx[8 + i * recordSize] + 1;
+        }
+    }
+
+    TTY_Instance instance;
+    if (tty_instance_init(font, &instance, ppem, TTY_INSTANCE_DEFAULT) == TTY_ERROR_NONE) {
+        CHECK(instance.hdmxWidths == NULL, "%s: the instance at %u ppem uses the hdmx widths of another size", path, ppem);
+        tty_instance_free(&instance);
+    }
+}
+
+// Builds a font with an LTSH table that marks the even glyphs as linear at
+// every size and the odd glyphs as never linear
+static void test_ltsh_advances(const char* path) {
+    TTY_S32 fileSize;
+    TTY_U8* data = read_file(path, &fileSize);
+    if (data == NULL) {
+        CHECK(0, "%s: failed to read the file", path);
+        return;
+    }
+
+    TTY_Font font;
+    if (tty_font_init_from_memory(&font, data, fileSize)) {
+        CHECK(0, "%s: failed to load the font from memory", path);
+        free(data);
+        return;
+    }
+    TTY_U32 numGlyphs = font.numGlyphs;
+    tty_font_free(&font);
+
+    TTY_U8* ltsh = (TTY_U8*)malloc(4 + numGlyphs);
+    if (ltsh == NULL) {
+        CHECK(0, "%s: out of memory", path);
+        free(data);
+        return;
+    }
+
+    set_u16(ltsh, 0);
+    set_u16(ltsh + 2, numGlyphs);
+    for (TTY_U32 i = 0; i < numGlyphs; i++) {
+        ltsh[4 + i] = i % 2 == 0 ? 1 : 255;
+    }
+
+    TTY_S32 size;
+    TTY_U8* fontData = build_font_with_table(data, "LTSH", ltsh, 4 + numGlyphs, &size);
+    if (fontData == NULL || tty_font_init_from_memory(&font, fontData, size)) {
+        CHECK(0, "%s: failed to load the font with an LTSH table", path);
+        free(fontData);
+        free(ltsh);
+        free(data);
+        return;
+    }
+
+    CHECK(font.LTSH.exists, "%s: the LTSH table wasn't found", path);
+
+    TTY_Instance hinted, unhinted;
+    if (tty_instance_init(&font, &hinted, 12, TTY_INSTANCE_DEFAULT) == TTY_ERROR_NONE) {
+        if (tty_instance_init(&font, &unhinted, 12, TTY_INSTANCE_NO_HINTING) == TTY_ERROR_NONE) {
+            TTY_U32 numMismatches = 0;
+
+            for (TTY_U32 i = 0; i < numGlyphs; i++) {
+                TTY_Glyph glyph;
+                TTY_S32   advance, expected;
+                TTY_Error error;
+
+                if (i % 2 == 0) {
+                    tty_glyph_init(&font, &glyph, i);
+                    tty_get_glyph_x_advance(&font, &unhinted, &glyph, &expected);
+                }
+                else {
+                    Rendered_Glyph rendered;
+                    render(&font, &hinted, i, &rendered);
+                    if (rendered.error != TTY_ERROR_NONE) {
+                        continue;
+                    }
+                    expected = rendered.advance.x;
+                    rendered_glyph_free(&rendered);
+                }
+
+                tty_glyph_init(&font, &glyph, i);
+                error = tty_get_glyph_x_advance(&font, &hinted, &glyph, &advance);
+                if (error != TTY_ERROR_NONE || advance != expected) {
+                    numMismatches++;
+                }
+            }
+            CHECK(numMismatches == 0, "%s: %u advances don't follow the LTSH table", path, numMismatches);
+
+            tty_instance_free(&unhinted);
+        }
+        tty_instance_free(&hinted);
+    }
+    else {
+        CHECK(0, "%s: failed to create the instance", path);
+    }
+
+    tty_font_free(&font);
+    free(fontData);
+
+    // A table that doesn't cover every glyph is ignored
+    set_u16(ltsh + 2, numGlyphs - 1);
+    fontData = build_font_with_table(data, "LTSH", ltsh, 3 + numGlyphs, &size);
+    if (fontData != NULL && tty_font_init_from_memory(&font, fontData, size) == TTY_ERROR_NONE) {
+        CHECK(!font.LTSH.exists, "%s: a truncated LTSH table wasn't ignored", path);
+        tty_font_free(&font);
+    }
+    else {
+        CHECK(0, "%s: failed to load the font with a truncated LTSH table", path);
+    }
+
+    free(fontData);
+    free(ltsh);
+    free(data);
+}
+
+// Builds fonts with a gasp table that turns grid-fitting off up to 8 ppem, on
+// up to 16 ppem, requests symmetric grid-fitting up to 24 ppem, and turns it
+// off above that. Symmetric grid-fitting only counts in version 1 tables.
+static void test_gasp_ranges(const char* path) {
+    TTY_S32 fileSize;
+    TTY_U8* data = read_file(path, &fileSize);
+    if (data == NULL) {
+        CHECK(0, "%s: failed to read the file", path);
+        return;
+    }
+
+    TTY_U8 gasp[] = {
+        0x00, 0x00, 0x00, 0x04,
+        0x00, 0x08, 0x00, 0x00,
+        0x00, 0x10, 0x00, 0x01,
+        0x00, 0x18, 0x00, 0x04,
+        0xFF, 0xFF, 0x00, 0x00,
+    };
+
+    for (TTY_U32 version = 0; version <= 1; version++) {
+        set_u16(gasp, version);
+
+        TTY_S32  size;
+        TTY_U8*  fontData = build_font_with_table(data, "gasp", gasp, sizeof(gasp), &size);
+        TTY_Font font;
+        if (fontData == NULL || tty_font_init_from_memory(&font, fontData, size)) {
+            CHECK(0, "%s: failed to load the font with a version %u gasp table", path, version);
+            free(fontData);
+            continue;
+        }
+
+        // The same instance is resized through every range to check that
+        // useHinting is updated along with the ppem
+        TTY_Instance instance;
+        if (tty_instance_init(&font, &instance, 6, TTY_INSTANCE_USE_GASP) == TTY_ERROR_NONE) {
+            for (TTY_U32 ppem = 6; ppem <= 30; ppem++) {
+                TTY_Bool expected = (ppem > 8 && ppem <= 16) || (version == 1 && ppem > 16 && ppem <= 24);
+
+                if (ppem != 6 && tty_instance_resize(&font, &instance, ppem)) {
+                    CHECK(0, "%s: failed to resize the instance to %u ppem", path, ppem);
+                    break;
+                }
+                CHECK(instance.useHinting == expected, "%s: version %u gasp table, hinting is %s at %u ppem", path, version, instance.useHinting ? "on" : "off", ppem);
+            }
+            tty_instance_free(&instance);
+        }
+        else {
+            CHECK(0, "%s: failed to create the instance", path);
+        }
+
+        // Sizes that the gasp table doesn't grid-fit render like an unhinted
+        // instance
+        TTY_Instance unhinted;
+        if (tty_instance_init(&font, &instance, 30, TTY_INSTANCE_USE_GASP) == TTY_ERROR_NONE) {
+            if (tty_instance_init(&font, &unhinted, 30, TTY_INSTANCE_NO_HINTING) == TTY_ERROR_NONE) {
+                char desc[256];
+                snprintf(desc, sizeof(desc), "%s with a version %u gasp table at 30 ppem", path, version);
+                check_renders_match(&font, &unhinted, &font, &instance, 0, desc);
+                tty_instance_free(&unhinted);
+            }
+            tty_instance_free(&instance);
+        }
+
+        // Without the flag, the gasp table is ignored
+        if (tty_instance_init(&font, &instance, 30, TTY_INSTANCE_DEFAULT) == TTY_ERROR_NONE) {
+            CHECK(instance.useHinting == font.hasHinting, "%s: the gasp table was used without TTY_INSTANCE_USE_GASP", path);
+            tty_instance_free(&instance);
+        }
+
+        tty_font_free(&font);
+        free(fontData);
+    }
+
+    free(data);
+}
+
+// Bitmap strike used by test_embedded_bitmaps. The strike at 20 ppem has 2
+// bits per pixel and covers glyphs 1-3. Glyphs 1 and 2 use index format 1 and
+// byte-aligned images with small metrics (image format 1). Glyph 3 uses index
+// format 2 and a bit-aligned image with the metrics in the index subtable
+// (image format 5). The strike at 21 ppem has an invalid bit depth.
+static const TTY_U8 testEBLC[] = {
+    0x00, 0x02, 0x00, 0x00,                         // version
+    0x00, 0x00, 0x00, 0x02,                         // numSizes
+
+    // BitmapSize at 20 ppem
+    0x00, 0x00, 0x00, 0x68,                         // indexSubTableArrayOffset
+    0x00, 0x00, 0x00, 0x38,                         // indexTablesSize
+    0x00, 0x00, 0x00, 0x02,                         // numberofIndexSubTables
+    0x00, 0x00, 0x00, 0x00,                         // colorRef
+    0x10, 0xFC, 0x08, 0x00, 0x00, 0x00,             // hori
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,             // vert
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x01, 0x00, 0x03,                         // startGlyphIndex, endGlyphIndex
+    0x14, 0x14, 0x02, 0x01,                         // ppemX, ppemY, bitDepth, flags
+
+    // BitmapSize at 21 ppem, bit depths of 3 aren't allowed
+    0x00, 0x00, 0x00, 0x68,
+    0x00, 0x00, 0x00, 0x38,
+    0x00, 0x00, 0x00, 0x02,
+    0x00, 0x00, 0x00, 0x00,
+    0x10, 0xFC, 0x08, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    0x00, 0x01, 0x00, 0x03,
+    0x15, 0x15, 0x03, 0x01,
+
+    // IndexSubTableArray
+    0x00, 0x01, 0x00, 0x02, 0x00, 0x00, 0x00, 0x10, // glyphs 1-2
+    0x00, 0x03, 0x00, 0x03, 0x00, 0x00, 0x00, 0x24, // glyph 3
+
+    // IndexSubTable1
+    0x00, 0x01, 0x00, 0x01,                         // indexFormat, imageFormat
+    0x00, 0x00, 0x00, 0x04,                         // imageDataOffset
+    0x00, 0x00, 0x00, 0x00,                         // sbitOffsets
+    0x00, 0x00, 0x00, 0x07,
+    0x00, 0x00, 0x00, 0x0D,
+
+    // IndexSubTable2
+    0x00, 0x02, 0x00, 0x05,                         // indexFormat, imageFormat
+    0x00, 0x00, 0x00, 0x11,                         // imageDataOffset
+    0x00, 0x00, 0x00, 0x02,                         // imageSize
+    0x02, 0x03, 0xFF, 0x04, 0x06, 0x00, 0x00, 0x00, // bigMetrics
+};
+
+static const TTY_U8 testEBDT[] = {
+    0x00, 0x02, 0x00, 0x00,                         // version
+
+    // Glyph 1, pixels 0 1 2 / 3 3 0
+    0x02, 0x03, 0x01, 0x02, 0x05,                   // smallMetrics
+    0x18, 0xF0,
+
+    // Glyph 2, pixels 3
+    0x01, 0x01, 0x00, 0x00, 0x02,                   // smallMetrics
+    0xC0,
+
+    // Glyph 3, pixels 3 2 1 / 0 1 2
+    0xE4, 0x60,
+};
+
+typedef struct {
+    TTY_U32  glyphIdx;
+    TTY_V2   offset;
+    TTY_S32  advance;
+    TTY_V2   size;
+    TTY_U8   pixels[6];
+} Bitmap_Case;
+
+static const Bitmap_Case bitmapCases[] = {
+    {1, { 1, 2}, 5, {3, 2}, {0, 85, 170, 255, 255, 0}},
+    {2, { 0, 0}, 2, {1, 1}, {255}},
+    {3, {-1, 4}, 6, {3, 2}, {255, 170, 85, 0, 85, 170}},
+};
+
+static void check_bitmap_glyph(TTY_Font* font, TTY_Instance* instance, const Bitmap_Case* expected, const char* path) {
+    TTY_U32        idx = expected->glyphIdx;
+    Rendered_Glyph rendered;
+    render(font, instance, idx, &rendered);
+
+    if (rendered.error != TTY_ERROR_NONE) {
+        CHECK(0, "%s: failed to render bitmap glyph %u", path, idx);
+        return;
+    }
+
+    TTY_U32 numPixels = expected->size.x * expected->size.y;
+
+    CHECK(rendered.offset.x  == expected->offset.x && rendered.offset.y == expected->offset.y, "%s: bitmap glyph %u has the wrong offset", path, idx);
+    CHECK(rendered.advance.x == expected->advance,                                              "%s: bitmap glyph %u has the wrong advance", path, idx);
+    CHECK(rendered.size.x    == expected->size.x   && rendered.size.y   == expected->size.y,   "%s: bitmap glyph %u has the wrong size", path, idx);
+    CHECK(rendered.image.size.x == (TTY_U32)expected->size.x &&
+          rendered.image.size.y == (TTY_U32)expected->size.y &&
+          memcmp(rendered.image.pixels, expected->pixels, numPixels) == 0,
+          "%s: bitmap glyph %u has the wrong pixels", path, idx);
+
+    TTY_Glyph glyph;
+    TTY_S32   advance;
+
+    tty_glyph_init(font, &glyph, idx);
+    CHECK(tty_get_glyph_metrics(font, instance, &glyph) == TTY_ERROR_NONE &&
+          glyph.offset.x == rendered.offset.x && glyph.offset.y == rendered.offset.y &&
+          glyph.advance.x == rendered.advance.x && glyph.advance.y == rendered.advance.y &&
+          glyph.size.x == rendered.size.x && glyph.size.y == rendered.size.y,
+          "%s: the metrics of bitmap glyph %u differ from the rendered glyph", path, idx);
+
+    tty_glyph_init(font, &glyph, idx);
+    CHECK(tty_get_glyph_x_advance(font, instance, &glyph, &advance) == TTY_ERROR_NONE && advance == expected->advance, "%s: the x advance of bitmap glyph %u is wrong", path, idx);
+
+    rendered_glyph_free(&rendered);
+}
+
+static void test_embedded_bitmaps(const char* path) {
+    TTY_S32 fileSize;
+    TTY_U8* data = read_file(path, &fileSize);
+    if (data == NULL) {
+        CHECK(0, "%s: failed to read the file", path);
+        return;
+    }
+
+    TTY_S32 withEBLCSize, size;
+    TTY_U8* withEBLC = build_font_with_table(data, "EBLC", testEBLC, sizeof(testEBLC), &withEBLCSize);
+    TTY_U8* fontData = withEBLC == NULL ? NULL : build_font_with_table(withEBLC, "EBDT", testEBDT, sizeof(testEBDT), &size);
+
+    TTY_Font outlineFont, font;
+    if (tty_font_init_from_memory(&outlineFont, data, fileSize)) {
+        CHECK(0, "%s: failed to load the font from memory", path);
+        free(fontData);
+        free(withEBLC);
+        free(data);
+        return;
+    }
+    if (fontData == NULL || tty_font_init_from_memory(&font, fontData, size)) {
+        CHECK(0, "%s: failed to load the font with embedded bitmaps", path);
+        tty_font_free(&outlineFont);
+        free(fontData);
+        free(withEBLC);
+        free(data);
+        return;
+    }
+
+    TTY_Instance instance, outlineInstance;
+    if (tty_instance_init(&font, &instance, 20, TTY_INSTANCE_DEFAULT) == TTY_ERROR_NONE) {
+        CHECK(instance.useEmbeddedBitmaps, "%s: the instance doesn't use the embedded bitmaps", path);
+
+        for (TTY_U32 i = 0; i < sizeof(bitmapCases) / sizeof(bitmapCases[0]); i++) {
+            check_bitmap_glyph(&font, &instance, bitmapCases + i, path);
+        }
+
+        // Glyphs outside of the strike are rasterized
+        if (tty_instance_init(&outlineFont, &outlineInstance, 20, TTY_INSTANCE_DEFAULT) == TTY_ERROR_NONE) {
+            Rendered_Glyph a, b;
+            render(&outlineFont, &outlineInstance, 4, &a);
+            render(&font, &instance, 4, &b);
+            CHECK(rendered_glyphs_equal(&a, &b), "%s: a glyph outside of the bitmap strike differs from the outline", path);
+            rendered_glyph_free(&a);
+            rendered_glyph_free(&b);
+            tty_instance_free(&outlineInstance);
+        }
+
+        tty_instance_free(&instance);
+    }
+    else {
+        CHECK(0, "%s: failed to create the instance", path);
+    }
+
+    // The outlines are used when the bitmaps are disabled and at sizes that
+    // don't have a usable strike
+    static const struct {
+        TTY_U32     ppem;
+        TTY_U32     flags;
+        const char* desc;
+    } outlineCases[] = {
+        {20, TTY_INSTANCE_NO_EMBEDDED_BITMAPS, "with embedded bitmaps disabled"},
+        {21, TTY_INSTANCE_DEFAULT,             "with an invalid bitmap strike"},
+        {22, TTY_INSTANCE_DEFAULT,             "without a bitmap strike"},
+    };
+
+    for (TTY_U32 i = 0; i < sizeof(outlineCases) / sizeof(outlineCases[0]); i++) {
+        if (tty_instance_init(&outlineFont, &outlineInstance, outlineCases[i].ppem, TTY_INSTANCE_DEFAULT)) {
+            CHECK(0, "%s: failed to create the instance", path);
+            continue;
+        }
+        if (tty_instance_init(&font, &instance, outlineCases[i].ppem, outlineCases[i].flags) == TTY_ERROR_NONE) {
+            char desc[256];
+            snprintf(desc, sizeof(desc), "%s %s", path, outlineCases[i].desc);
+            check_renders_match(&outlineFont, &outlineInstance, &font, &instance, 0, desc);
+            tty_instance_free(&instance);
+        }
+        else {
+            CHECK(0, "%s: failed to create the instance", path);
+        }
+        tty_instance_free(&outlineInstance);
+    }
+
+    tty_font_free(&font);
+    tty_font_free(&outlineFont);
+    free(fontData);
+    free(withEBLC);
+    free(data);
+}
+
+static void test_compiled_module_matches_interpreter(const char* path) {
+    static const TTY_U32 ppems[] = {9, 12, 18, 31};
+
+    TTY_Font font;
+    if (tty_font_init(&font, path)) {
+        CHECK(0, "%s: failed to load the font", path);
+        return;
+    }
+
+    // The module is registered both after the font program was executed, and
+    // before, so that the functions are bound to compiled code as they're
+    // defined
+    static const TTY_U32 fontFlags[] = {TTY_FONT_DEFAULT, TTY_FONT_DEFER_FONT_PROGRAM};
+
+    for (TTY_U32 i = 0; i < sizeof(fontFlags) / sizeof(fontFlags[0]); i++) {
+        TTY_Font compiled;
+        if (tty_font_init_ex(&compiled, path, fontFlags[i])) {
+            CHECK(0, "%s: failed to load the font", path);
+            continue;
+        }
+
+        TTY_Error error = tty_font_register_compiled_module(&compiled, &testModule);
+        CHECK(error == TTY_ERROR_NONE, "%s: failed to register the compiled module, error %d", path, error);
+
+        for (TTY_U32 j = 0; j < sizeof(ppems) / sizeof(ppems[0]); j++) {
+            char desc[256];
+            snprintf(desc, sizeof(desc), "%s with a compiled module (font flags %u) at %u ppem", path, fontFlags[i], ppems[j]);
+            check_fonts_render_the_same(&font, &compiled, ppems[j], desc);
+        }
+
+        CHECK(tty_font_register_compiled_module(&compiled, NULL) == TTY_ERROR_NONE && compiled.compiledModule == NULL, "%s: failed to unregister the compiled module", path);
+        tty_font_free(&compiled);
+    }
+
+    tty_font_free(&font);
+
+    // A module generated from another font is rejected
+    for (TTY_U32 i = 0; i < NUM_FONTS; i++) {
+        if (strcmp(fontPaths[i], path) == 0 || tty_font_init(&font, fontPaths[i])) {
+            continue;
+        }
+        TTY_Error error = tty_font_register_compiled_module(&font, &testModule);
+        CHECK(error == TTY_ERROR_MODULE_MISMATCH, "%s: registering the compiled module of %s returned %d", fontPaths[i], path, error);
+        CHECK(font.compiledModule == NULL, "%s: a mismatched module was registered", fontPaths[i]);
+        tty_font_free(&font);
+    }
+}
+
+int main() {
+    for (TTY_U32 i = 0; i < NUM_FONTS; i++) {
+        TTY_Font font;
+        if (tty_font_init(&font, fontPaths[i])) {
+            printf("Failed to load %s\n", fontPaths[i]);
+            return 1;
+        }
+
+        printf("Testing %s\n", fontPaths[i]);
+        test_render_is_independent_of_previous_glyphs(&font, fontPaths[i]);
+        test_hinted_cache_matches_uncached(&font, fontPaths[i]);
+        test_mmap_font_matches_read_font(&font, fontPaths[i]);
+        test_memory_font_matches_read_font(&font, fontPaths[i]);
+        test_loca_cache_matches_uncached(&font, fontPaths[i]);
+        test_bmp_cache_matches_uncached(&font, fontPaths[i]);
+        test_utf8_glyph_indices(&font, fontPaths[i]);
+        test_font_program_snapshot(&font, fontPaths[i]);
+        test_instance_snapshot(&font, fontPaths[i]);
+        test_metrics_match_render(&font, fontPaths[i]);
+        test_hdmx_advances(&font, fontPaths[i]);
+        test_ltsh_advances(fontPaths[i]);
+        test_gasp_ranges(fontPaths[i]);
+
+        tty_font_free(&font);
+    }
+
+    test_format_12_cmap_cache_matches_uncached(fontPaths[0]);
+    test_collection_faces_match_fonts();
+    test_embedded_bitmaps(fontPaths[0]);
+    test_compiled_module_matches_interpreter(fontPaths[0]);
+
+    if (numFailures != 0) {
+        printf("%d checks failed\n", numFailures);
+        return 1;
+    }
+    printf("All checks passed\n");
+    return 0;
+}
@@ -0,0 +1,10 @@
+@echo off
+
+cl /Fe.\compile_font compile_font.c ../src/*.c -I../src
+
+if %errorlevel%==0 (
+    del *.obj
+    if not "%1"=="" (
+        .\compile_font.exe %*
+    )
+)
@@ -0,0 +1,7 @@
+#!/bin/bash
+
+gcc -Wall -std=c11 -ocompile_font.out compile_font.c ../src/*.c -I../src
+
+if [ $? = 0 ] && [ "$1" != "" ]; then
+    ./compile_font.out "$@"
+fi
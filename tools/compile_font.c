@@ -0,0 +1,1029 @@
+/*
+ * Translates the function definitions and glyph programs of a font into a C
+ * source file that defines a `TTY_Compiled_Module`. Build the generated file
+ * with the program that uses the font and pass the module to
+ * `tty_font_register_compiled_module`.
+ *
+ * Usage: ./compile_font.out <font file> <output file> <module name>
+ *
+ * Values that are pushed and consumed between two uses of the interpreter
+ * stack are kept in locals, or folded if they are constants, instead of
+ * being pushed. Branches become if statements and gotos, and calls to
+ * functions whose ids are constants call the compiled function directly as
+ * long as the runtime has the same function bound to that id. Instructions
+ * that read or modify the graphics state, points, or CVT are executed by the
+ * interpreter's handler for the instruction through the runtime.
+ *
+ * A program is left to the interpreter if it has a jump whose offset isn't a
+ * constant, unbalanced IF/ELSE/EIF instructions, a function or instruction
+ * definition, a JROF, or push data that runs past its end. It is also left to
+ * the interpreter if more than MAX_EXEC_PERCENT of its ops would be executed
+ * by the interpreter anyway, since those programs aren't any faster compiled.
+ */
+#include <stdlib.h>
+#include <stdio.h>
+#include <stdarg.h>
+#include <string.h>
+#include "truety.h"
+
+#define MAX_LABEL_PASSES  8
+#define MAX_MINDEX_LOCALS 16
+#define MAX_EXEC_PERCENT  50
+
+enum {
+    INS_ABS      = 0x64,
+    INS_ADD      = 0x60,
+    INS_AND      = 0x5A,
+    INS_CALL     = 0x2B,
+    INS_CINDEX   = 0x25,
+    INS_DEPTH    = 0x24,
+    INS_DIV      = 0x62,
+    INS_DUP      = 0x20,
+    INS_EIF      = 0x59,
+    INS_ELSE     = 0x1B,
+    INS_ENDF     = 0x2D,
+    INS_EQ       = 0x54,
+    INS_FDEF     = 0x2C,
+    INS_FLOOR    = 0x66,
+    INS_GT       = 0x52,
+    INS_GTEQ     = 0x53,
+    INS_IDEF     = 0x89,
+    INS_IF       = 0x58,
+    INS_JMPR     = 0x1C,
+    INS_JROF     = 0x79,
+    INS_JROT     = 0x78,
+    INS_LOOPCALL = 0x2A,
+    INS_LT       = 0x50,
+    INS_LTEQ     = 0x51,
+    INS_MAX      = 0x8B,
+    INS_MIN      = 0x8C,
+    INS_MINDEX   = 0x26,
+    INS_MUL      = 0x63,
+    INS_NEG      = 0x65,
+    INS_NEQ      = 0x55,
+    INS_NOT      = 0x5C,
+    INS_NPUSHB   = 0x40,
+    INS_NPUSHW   = 0x41,
+    INS_OR       = 0x5B,
+    INS_POP      = 0x21,
+    INS_PUSHB    = 0xB0,
+    INS_PUSHB_MAX= 0xB7,
+    INS_PUSHW    = 0xB8,
+    INS_PUSHW_MAX= 0xBF,
+    INS_ROLL     = 0x8A,
+    INS_SUB      = 0x61,
+    INS_SWAP     = 0x23,
+};
+
+typedef struct {
+    char*   data;
+    size_t  size;
+    size_t  cap;
+} Buffer;
+
+typedef struct {
+    TTY_U32  byteOff;
+    TTY_U32  numValues;
+    TTY_U32  valueOff;
+    TTY_U8   ins;
+} Op;
+
+typedef struct {
+    Op*       ops;
+    TTY_S32*  values;
+    TTY_U32   numOps;
+    TTY_U32   size;
+} Program;
+
+/* A value above the interpreter stack, either a constant or a local */
+typedef struct {
+    TTY_Bool  isConst;
+    TTY_S32   value; /* The constant, or the index of the local */
+} Value;
+
+typedef struct {
+    const char**  funcNames; /* The compiled function of each function id, if it is known */
+    TTY_U32       numFuncIds;
+    Buffer        code;
+    Value*        vals;
+    TTY_U32       numVals;
+    TTY_U32       valsCap;
+    TTY_Bool*     isLocalRead;
+    TTY_U32       numLocals;
+    TTY_U32       localsCap;
+    TTY_Bool*     isLabel;  /* Ops that are jump targets, found by the previous pass */
+    TTY_Bool*     isTarget; /* Ops that are jump targets, found by the current pass */
+    TTY_U32       depth;
+    TTY_Bool*     hasElse;  /* For each open IF block */
+    TTY_U32       numOps;   /* Ops of the program other than pushes */
+    TTY_U32       numExecs; /* Ops that are executed by the interpreter */
+} Compiler;
+
+typedef struct {
+    TTY_U32  off;
+    TTY_U32  size;
+    TTY_U8*  bytes;
+    char     name[32];
+    TTY_Bool isCompiled;
+} Func;
+
+typedef struct {
+    TTY_U32   glyphIdx;
+    TTY_U8*   bytes;
+    TTY_U32   size;
+    TTY_Bool  isCompiled;
+} Glyph_Program;
+
+
+/* ------- */
+/* Helpers */
+/* ------- */
+static void* xrealloc(void* ptr, size_t size) {
+    ptr = realloc(ptr, size == 0 ? 1 : size);
+    if (ptr == NULL) {
+        fprintf(stderr, "Error: Out of memory\n");
+        exit(1);
+    }
+    return ptr;
+}
+
+static void buffer_printf(Buffer* buffer, const char* fmt, ...) {
+    va_list args;
+
+    while (1) {
+        va_start(args, fmt);
+        int len = vsnprintf(buffer->data + buffer->size, buffer->cap - buffer->size, fmt, args);
+        va_end(args);
+
+        if (len < 0) {
+            return;
+        }
+        if (buffer->size + len < buffer->cap) {
+            buffer->size += len;
+            return;
+        }
+
+        buffer->cap  = 2 * (buffer->size + len + 1);
+        buffer->data = xrealloc(buffer->data, buffer->cap);
+    }
+}
+
+static TTY_U16 get_u16(TTY_U8* data) {
+    return data[0] << 8 | data[1];
+}
+
+static TTY_S16 get_s16(TTY_U8* data) {
+    return (TTY_S16)get_u16(data);
+}
+
+
+/* -------- */
+/* Decoding */
+/* -------- */
+static TTY_Bool is_push(TTY_U8 ins) {
+    return ins == INS_NPUSHB || ins == INS_NPUSHW || (ins >= INS_PUSHB && ins <= INS_PUSHW_MAX);
+}
+
+// Decodes the same ops as the interpreter. Returns TTY_FALSE if a push runs
+// past the end of the program.
+static TTY_Bool decode_program(TTY_U8* bytes, TTY_U32 size, Program* program) {
+    program->ops    = xrealloc(program->ops, size * sizeof(Op));
+    program->values = xrealloc(program->values, size * sizeof(TTY_S32));
+    program->numOps = 0;
+    program->size   = size;
+
+    TTY_U32 numValues = 0;
+    TTY_U32 off       = 0;
+
+    while (off < size) {
+        Op* op = program->ops + program->numOps++;
+        op->byteOff   = off;
+        op->ins       = bytes[off++];
+        op->numValues = 0;
+        op->valueOff  = numValues;
+
+        if (is_push(op->ins)) {
+            TTY_U32 width = op->ins == INS_NPUSHW || op->ins >= INS_PUSHW ? 2 : 1;
+
+            if (op->ins == INS_NPUSHB || op->ins == INS_NPUSHW) {
+                if (off >= size) {
+                    return TTY_FALSE;
+                }
+                op->numValues = bytes[off++];
+            }
+            else {
+                op->numValues = 1 + (op->ins & 0x7);
+            }
+
+            if (op->numValues * width > size - off) {
+                return TTY_FALSE;
+            }
+
+            for (TTY_U32 i = 0; i < op->numValues; i++, off += width) {
+                program->values[numValues++] = width == 1 ? bytes[off] : get_s16(bytes + off);
+            }
+        }
+    }
+
+    return TTY_TRUE;
+}
+
+
+/* -------------- */
+/* Virtual Stack  */
+/* -------------- */
+static void emit(Compiler* c, const char* fmt, ...) {
+    char    line[256];
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(line, sizeof(line), fmt, args);
+    va_end(args);
+    buffer_printf(&c->code, "%*s%s\n", 4 * (c->depth + 1), "", line);
+}
+
+static const char* value_str(Compiler* c, Value value, char* str) {
+    if (!value.isConst) {
+        c->isLocalRead[value.value] = TTY_TRUE;
+        sprintf(str, "v%d", (int)value.value);
+    }
+    else if (value.value == INT32_MIN) {
+        sprintf(str, "(-2147483647 - 1)");
+    }
+    else if (value.value < 0) {
+        sprintf(str, "(%d)", (int)value.value);
+    }
+    else {
+        sprintf(str, "%d", (int)value.value);
+    }
+    return str;
+}
+
+static void push_value(Compiler* c, Value value) {
+    if (c->numVals == c->valsCap) {
+        c->valsCap = c->valsCap == 0 ? 64 : 2 * c->valsCap;
+        c->vals    = xrealloc(c->vals, c->valsCap * sizeof(Value));
+    }
+    c->vals[c->numVals++] = value;
+}
+
+static void push_const(Compiler* c, TTY_S32 value) {
+    push_value(c, (Value){ TTY_TRUE, value });
+}
+
+static Value pop_value(Compiler* c) {
+    return c->vals[--c->numVals];
+}
+
+static Value new_local(Compiler* c) {
+    if (c->numLocals == c->localsCap) {
+        c->localsCap   = c->localsCap == 0 ? 64 : 2 * c->localsCap;
+        c->isLocalRead = xrealloc(c->isLocalRead, c->localsCap * sizeof(TTY_Bool));
+    }
+    c->isLocalRead[c->numLocals] = TTY_FALSE;
+    return (Value){ TTY_FALSE, (TTY_S32)c->numLocals++ };
+}
+
+// Pops values from the interpreter stack into locals until `count` values are
+// above it. The popped values go below the values that are already there.
+static void ensure_values(Compiler* c, TTY_U32 count) {
+    if (c->numVals < count) {
+        emit(c, "TTY_C_CHECK_POP(%d);", (int)(count - c->numVals));
+    }
+    while (c->numVals < count) {
+        Value local = new_local(c);
+        emit(c, "TTY_C_POP(v%d);", (int)local.value);
+
+        push_value(c, local);
+        memmove(c->vals + 1, c->vals, (c->numVals - 1) * sizeof(Value));
+        c->vals[0] = local;
+    }
+}
+
+// Moves the values onto the interpreter stack
+static void flush_values(Compiler* c) {
+    if (c->numVals > 0) {
+        emit(c, "TTY_C_CHECK_PUSH(%d);", (int)c->numVals);
+    }
+    for (TTY_U32 i = 0; i < c->numVals; i++) {
+        char str[32];
+        emit(c, "TTY_C_PUSH(%s);", value_str(c, c->vals[i], str));
+    }
+    c->numVals = 0;
+}
+
+
+/* ----------- */
+/* Translation */
+/* ----------- */
+// The same as tty_c_div in the generated code and DIV in the interpreter
+static TTY_S32 div_f26dot6(TTY_S32 n2, TTY_S32 n1) {
+    TTY_Bool isNeg = TTY_FALSE;
+    if (n2 < 0) {
+        n2    = -n2;
+        isNeg = TTY_TRUE;
+    }
+    if (n1 < 0) {
+        n1    = -n1;
+        isNeg = !isNeg;
+    }
+    TTY_S32 result = ((TTY_S64)n2 << 6) / n1;
+    return isNeg ? -result : result;
+}
+
+static TTY_Bool fold_binary(TTY_U8 ins, TTY_S32 n2, TTY_S32 n1, TTY_S32* result) {
+    // n1 was on top of n2
+    switch (ins) {
+        case INS_DIV:
+            // Division by zero is left to happen at run time
+            if (n1 == 0) {
+                return TTY_FALSE;
+            }
+            *result = div_f26dot6(n2, n1);
+            return TTY_TRUE;
+        case INS_ADD:  *result = (TTY_S32)((TTY_U32)n2 + (TTY_U32)n1); return TTY_TRUE;
+        case INS_SUB:  *result = (TTY_S32)((TTY_U32)n2 - (TTY_U32)n1); return TTY_TRUE;
+        case INS_MUL:  *result = (TTY_S32)(((TTY_S64)n1 * (TTY_S64)n2 + 0x20) >> 6); return TTY_TRUE;
+        case INS_MAX:  *result = n1 > n2 ? n1 : n2; return TTY_TRUE;
+        case INS_MIN:  *result = n1 < n2 ? n1 : n2; return TTY_TRUE;
+        case INS_LT:   *result = n2 <  n1; return TTY_TRUE;
+        case INS_LTEQ: *result = n2 <= n1; return TTY_TRUE;
+        case INS_GT:   *result = n2 >  n1; return TTY_TRUE;
+        case INS_GTEQ: *result = n2 >= n1; return TTY_TRUE;
+        case INS_EQ:   *result = n2 == n1; return TTY_TRUE;
+        case INS_NEQ:  *result = n2 != n1; return TTY_TRUE;
+        case INS_AND:  *result = n2 != 0 && n1 != 0; return TTY_TRUE;
+        case INS_OR:   *result = n2 != 0 || n1 != 0; return TTY_TRUE;
+    }
+    return TTY_FALSE;
+}
+
+static TTY_Bool fold_unary(TTY_U8 ins, TTY_S32 val, TTY_S32* result) {
+    switch (ins) {
+        case INS_ABS:   *result = (TTY_S32)labs(val); return TTY_TRUE;
+        case INS_NEG:   *result = (TTY_S32)(0u - (TTY_U32)val); return TTY_TRUE;
+        case INS_FLOOR: *result = (TTY_S32)((TTY_U32)val & 0xFFFFFFC0u); return TTY_TRUE;
+        case INS_NOT:   *result = !val; return TTY_TRUE;
+    }
+    return TTY_FALSE;
+}
+
+static void compile_binary(Compiler* c, TTY_U8 ins) {
+    ensure_values(c, 2);
+    Value n1 = pop_value(c);
+    Value n2 = pop_value(c);
+
+    TTY_S32 result;
+    if (n1.isConst && n2.isConst && fold_binary(ins, n2.value, n1.value, &result)) {
+        push_const(c, result);
+        return;
+    }
+
+    char  a[32], b[32];
+    Value local = new_local(c);
+    value_str(c, n2, a);
+    value_str(c, n1, b);
+
+    switch (ins) {
+        case INS_ADD:  emit(c, "v%d = TTY_C_ADD(%s, %s);", local.value, a, b);        break;
+        case INS_SUB:  emit(c, "v%d = TTY_C_SUB(%s, %s);", local.value, a, b);        break;
+        case INS_MUL:  emit(c, "v%d = TTY_C_MUL(%s, %s);", local.value, a, b);        break;
+        case INS_DIV:  emit(c, "v%d = tty_c_div(%s, %s);", local.value, a, b);        break;
+        case INS_MAX:  emit(c, "v%d = %s > %s ? %s : %s;", local.value, b, a, b, a);  break;
+        case INS_MIN:  emit(c, "v%d = %s < %s ? %s : %s;", local.value, b, a, b, a);  break;
+        case INS_LT:   emit(c, "v%d = %s < %s;", local.value, a, b);                  break;
+        case INS_LTEQ: emit(c, "v%d = %s <= %s;", local.value, a, b);                 break;
+        case INS_GT:   emit(c, "v%d = %s > %s;", local.value, a, b);                  break;
+        case INS_GTEQ: emit(c, "v%d = %s >= %s;", local.value, a, b);                 break;
+        case INS_EQ:   emit(c, "v%d = %s == %s;", local.value, a, b);                 break;
+        case INS_NEQ:  emit(c, "v%d = %s != %s;", local.value, a, b);                 break;
+        case INS_AND:  emit(c, "v%d = %s != 0 && %s != 0;", local.value, a, b);       break;
+        case INS_OR:   emit(c, "v%d = %s != 0 || %s != 0;", local.value, a, b);       break;
+    }
+    push_value(c, local);
+}
+
+static void compile_unary(Compiler* c, TTY_U8 ins) {
+    ensure_values(c, 1);
+    Value val = pop_value(c);
+
+    TTY_S32 result;
+    if (val.isConst && fold_unary(ins, val.value, &result)) {
+        push_const(c, result);
+        return;
+    }
+
+    char  a[32];
+    Value local = new_local(c);
+    value_str(c, val, a);
+
+    switch (ins) {
+        case INS_ABS:   emit(c, "v%d = (TTY_S32)labs(%s);", local.value, a); break;
+        case INS_NEG:   emit(c, "v%d = TTY_C_NEG(%s);", local.value, a);     break;
+        case INS_FLOOR: emit(c, "v%d = TTY_C_FLOOR(%s);", local.value, a);   break;
+        case INS_NOT:   emit(c, "v%d = !%s;", local.value, a);               break;
+    }
+    push_value(c, local);
+}
+
+static void compile_exec(Compiler* c, TTY_U8 ins) {
+    c->numExecs++;
+    flush_values(c);
+    emit(c, "TTY_C_EXEC(0x%02X);", ins);
+}
+
+static void compile_call(Compiler* c, Value funcId, const char* count) {
+    char id[32];
+    value_str(c, funcId, id);
+
+    if (funcId.isConst && count == NULL && (TTY_U32)funcId.value < c->numFuncIds && c->funcNames[funcId.value] != NULL) {
+        emit(c, "TTY_C_CALL_STATIC(%s, %s);", id, c->funcNames[funcId.value]);
+    }
+    else {
+        emit(c, "TTY_C_CALL((TTY_U32)%s, %s);", id, count == NULL ? "1" : count);
+    }
+}
+
+// Emits a jump to the first op at or after the target offset. Jumps are
+// clamped to the program like they are by the interpreter.
+static TTY_Bool compile_jump(Compiler* c, Program* program, TTY_U32 opIdx, Value off, const char* cond) {
+    if (!off.isConst) {
+        return TTY_FALSE;
+    }
+
+    TTY_S64 target = (TTY_S64)program->ops[opIdx].byteOff + off.value;
+    target = target < 0 ? 0 : target;
+    target = target > program->size ? program->size : target;
+
+    TTY_U32 targetIdx = 0;
+    while (targetIdx < program->numOps && program->ops[targetIdx].byteOff < target) {
+        targetIdx++;
+    }
+
+    char stmt[64];
+    if (targetIdx == program->numOps) {
+        sprintf(stmt, "return TTY_TRUE;");
+    }
+    else {
+        sprintf(stmt, "goto L%d;", (int)targetIdx);
+        c->isTarget[targetIdx] = TTY_TRUE;
+    }
+
+    if (cond == NULL) {
+        emit(c, "%s", stmt);
+    }
+    else {
+        emit(c, "if (%s != 0) %s", cond, stmt);
+    }
+    return TTY_TRUE;
+}
+
+// Translates the program's ops into statements. Returns TTY_FALSE if the
+// program has to be interpreted.
+static TTY_Bool compile_ops(Compiler* c, Program* program) {
+    c->code.size = 0;
+    c->numVals   = 0;
+    c->numLocals = 0;
+    c->depth     = 0;
+    c->numOps    = 0;
+    c->numExecs  = 0;
+    memset(c->isTarget, 0, program->numOps);
+
+    for (TTY_U32 i = 0; i < program->numOps; i++) {
+        Op*  op = program->ops + i;
+        char a[32], b[32];
+
+        if (c->isLabel[i]) {
+            flush_values(c);
+            buffer_printf(&c->code, "L%d:;\n", (int)i);
+        }
+
+        if (is_push(op->ins)) {
+            for (TTY_U32 j = 0; j < op->numValues; j++) {
+                push_const(c, program->values[op->valueOff + j]);
+            }
+            continue;
+        }
+        c->numOps++;
+
+        switch (op->ins) {
+            case INS_ADD:
+            case INS_SUB:
+            case INS_MUL:
+            case INS_DIV:
+            case INS_MAX:
+            case INS_MIN:
+            case INS_LT:
+            case INS_LTEQ:
+            case INS_GT:
+            case INS_GTEQ:
+            case INS_EQ:
+            case INS_NEQ:
+            case INS_AND:
+            case INS_OR:
+                compile_binary(c, op->ins);
+                break;
+            case INS_ABS:
+            case INS_NEG:
+            case INS_FLOOR:
+            case INS_NOT:
+                compile_unary(c, op->ins);
+                break;
+            case INS_DUP:
+                ensure_values(c, 1);
+                push_value(c, c->vals[c->numVals - 1]);
+                break;
+            case INS_POP:
+                if (c->numVals > 0) {
+                    c->numVals--;
+                }
+                else {
+                    emit(c, "TTY_C_DROP();");
+                }
+                break;
+            case INS_SWAP: {
+                ensure_values(c, 2);
+                Value e2 = c->vals[c->numVals - 1];
+                c->vals[c->numVals - 1] = c->vals[c->numVals - 2];
+                c->vals[c->numVals - 2] = e2;
+                break;
+            }
+            case INS_ROLL: {
+                ensure_values(c, 3);
+                Value top = c->vals[c->numVals - 3];
+                c->vals[c->numVals - 3] = c->vals[c->numVals - 2];
+                c->vals[c->numVals - 2] = c->vals[c->numVals - 1];
+                c->vals[c->numVals - 1] = top;
+                break;
+            }
+            case INS_DEPTH: {
+                Value local = new_local(c);
+                emit(c, "v%d = (TTY_S32)stack->count + %d;", local.value, (int)c->numVals);
+                push_value(c, local);
+                break;
+            }
+            case INS_CINDEX: {
+                ensure_values(c, 1);
+                Value pos = c->vals[c->numVals - 1];
+                if (!pos.isConst || pos.value < 1) {
+                    compile_exec(c, op->ins);
+                    break;
+                }
+
+                c->numVals--;
+                if ((TTY_U32)pos.value <= c->numVals) {
+                    push_value(c, c->vals[c->numVals - pos.value]);
+                }
+                else {
+                    Value local = new_local(c);
+                    emit(c, "TTY_C_PEEK(v%d, %d);", local.value, (int)(pos.value - c->numVals));
+                    push_value(c, local);
+                }
+                break;
+            }
+            case INS_MINDEX: {
+                ensure_values(c, 1);
+                Value pos = c->vals[c->numVals - 1];
+                if (!pos.isConst || pos.value < 1 || pos.value > MAX_MINDEX_LOCALS) {
+                    compile_exec(c, op->ins);
+                    break;
+                }
+
+                c->numVals--;
+                ensure_values(c, pos.value);
+
+                Value val = c->vals[c->numVals - pos.value];
+                memmove(c->vals + c->numVals - pos.value, c->vals + c->numVals - pos.value + 1, (pos.value - 1) * sizeof(Value));
+                c->vals[c->numVals - 1] = val;
+                break;
+            }
+            case INS_IF: {
+                ensure_values(c, 1);
+                Value cond = pop_value(c);
+                flush_values(c);
+                emit(c, "if (%s != 0) {", value_str(c, cond, a));
+                c->hasElse[c->depth++] = TTY_FALSE;
+                break;
+            }
+            case INS_ELSE:
+                if (c->depth == 0 || c->hasElse[c->depth - 1]) {
+                    return TTY_FALSE;
+                }
+                flush_values(c);
+                c->depth--;
+                emit(c, "}");
+                emit(c, "else {");
+                c->hasElse[c->depth++] = TTY_TRUE;
+                break;
+            case INS_EIF:
+                if (c->depth == 0) {
+                    return TTY_FALSE;
+                }
+                flush_values(c);
+                c->depth--;
+                emit(c, "}");
+                break;
+            case INS_JMPR: {
+                ensure_values(c, 1);
+                Value off = pop_value(c);
+                flush_values(c);
+                if (!compile_jump(c, program, i, off, NULL)) {
+                    return TTY_FALSE;
+                }
+                break;
+            }
+            case INS_JROT: {
+                ensure_values(c, 2);
+                Value val = pop_value(c);
+                Value off = pop_value(c);
+                flush_values(c);
+                if (val.isConst && val.value == 0) {
+                    break;
+                }
+                if (!compile_jump(c, program, i, off, val.isConst ? NULL : value_str(c, val, a))) {
+                    return TTY_FALSE;
+                }
+                break;
+            }
+            case INS_CALL: {
+                ensure_values(c, 1);
+                Value funcId = pop_value(c);
+                flush_values(c);
+                compile_call(c, funcId, NULL);
+                break;
+            }
+            case INS_LOOPCALL: {
+                ensure_values(c, 2);
+                Value funcId = pop_value(c);
+                Value times  = pop_value(c);
+                flush_values(c);
+                compile_call(c, funcId, value_str(c, times, b));
+                break;
+            }
+            case INS_FDEF:
+            case INS_ENDF:
+            case INS_IDEF:
+            case INS_JROF:
+                return TTY_FALSE;
+            default:
+                compile_exec(c, op->ins);
+                break;
+        }
+    }
+
+    if (c->depth != 0) {
+        return TTY_FALSE;
+    }
+
+    flush_values(c);
+    return TTY_TRUE;
+}
+
+// Compiles the program until the ops that are jumped to stop changing, since
+// the values above the interpreter stack are moved onto it at each target
+static TTY_Bool compile_program(Compiler* c, Program* program) {
+    c->isLabel  = xrealloc(c->isLabel, program->numOps + 1);
+    c->isTarget = xrealloc(c->isTarget, program->numOps + 1);
+    c->hasElse  = xrealloc(c->hasElse, program->numOps + 1);
+    memset(c->isLabel, 0, program->numOps);
+
+    for (TTY_U32 pass = 0; pass < MAX_LABEL_PASSES; pass++) {
+        if (!compile_ops(c, program)) {
+            return TTY_FALSE;
+        }
+
+        TTY_Bool hasNewLabels = TTY_FALSE;
+        for (TTY_U32 i = 0; i < program->numOps; i++) {
+            if (c->isTarget[i] && !c->isLabel[i]) {
+                c->isLabel[i] = TTY_TRUE;
+                hasNewLabels  = TTY_TRUE;
+            }
+        }
+
+        if (!hasNewLabels) {
+            // Programs whose ops are mostly executed by the interpreter anyway
+            // run faster as interpreted ops than as calls from compiled code
+            return c->numExecs * 100 <= c->numOps * MAX_EXEC_PERCENT;
+        }
+    }
+
+    return TTY_FALSE;
+}
+
+static void write_program(FILE* file, Compiler* c, const char* name) {
+    fprintf(file, "static TTY_Bool %s(struct TTY_Program_Context* ctx, const TTY_Compiled_Runtime* rt, TTY_Interp_Stack* stack) {\n", name);
+
+    for (TTY_U32 i = 0; i < c->numLocals; i++) {
+        fprintf(file, i % 12 == 0 ? "    TTY_S32 v%d" : ", v%d", (int)i);
+        if (i % 12 == 11 || i == c->numLocals - 1) {
+            fprintf(file, ";\n");
+        }
+    }
+    for (TTY_U32 i = 0; i < c->numLocals; i++) {
+        if (!c->isLocalRead[i]) {
+            fprintf(file, "    (void)v%d;\n", (int)i);
+        }
+    }
+
+    fwrite(c->code.data, 1, c->code.size, file);
+    fprintf(file, "    return TTY_TRUE;\n}\n\n");
+}
+
+
+/* --------------- */
+/* Font Inspection */
+/* --------------- */
+static int compare_funcs(const void* a, const void* b) {
+    TTY_U32 offA = ((const Func*)a)->off;
+    TTY_U32 offB = ((const Func*)b)->off;
+    return offA < offB ? -1 : offA > offB;
+}
+
+// Finds the function definitions of a font or CV program. Like the
+// interpreter, a function ends at the first ENDF after its FDEF.
+static void find_funcs(TTY_Font* font, TTY_Table* table, Func** funcs, TTY_U32* numFuncs) {
+    Program program = {0};
+    TTY_U8* bytes   = font->fileData + table->off;
+
+    if (!table->exists) {
+        return;
+    }
+    decode_program(bytes, table->size, &program);
+
+    for (TTY_U32 i = 0; i < program.numOps; i++) {
+        if (program.ops[i].ins != INS_FDEF) {
+            continue;
+        }
+
+        TTY_U32 end = i + 1;
+        while (end < program.numOps && program.ops[end].ins != INS_ENDF) {
+            end++;
+        }
+
+        TTY_U32 startOff = i + 1 < program.numOps ? program.ops[i + 1].byteOff : table->size;
+        TTY_U32 endOff   = end    < program.numOps ? program.ops[end].byteOff   : table->size;
+
+        *funcs = xrealloc(*funcs, (*numFuncs + 1) * sizeof(Func));
+        Func* func = *funcs + (*numFuncs)++;
+        func->off        = table->off + startOff;
+        func->size       = endOff - startOff;
+        func->bytes      = bytes + startOff;
+        func->isCompiled = TTY_FALSE;
+        sprintf(func->name, "func_%u", (unsigned)func->off);
+
+        i = end;
+    }
+
+    free(program.ops);
+    free(program.values);
+}
+
+static void find_glyph_program(TTY_Font* font, TTY_U32 glyphIdx, Glyph_Program* program) {
+    TTY_Glyph glyph;
+    program->glyphIdx   = glyphIdx;
+    program->bytes      = NULL;
+    program->size       = 0;
+    program->isCompiled = TTY_FALSE;
+
+    if (tty_glyph_init(font, &glyph, glyphIdx) != TTY_ERROR_NONE || glyph.glyfBlock == NULL) {
+        return;
+    }
+
+    TTY_U32 off = 10;
+    if (glyph.numContours >= 0) {
+        off += 2 * glyph.numContours;
+    }
+    else {
+        // Skip the components, the instructions follow the last one
+        TTY_U16 flags;
+        do {
+            flags = get_u16(glyph.glyfBlock + off);
+            off  += 4;
+            off  += flags & 0x0001 ? 4 : 2;
+            if (flags & 0x0008) {
+                off += 2;
+            }
+            else if (flags & 0x0040) {
+                off += 4;
+            }
+            else if (flags & 0x0080) {
+                off += 8;
+            }
+        } while (flags & 0x0020);
+
+        if (!(flags & 0x0100)) {
+            return;
+        }
+    }
+
+    program->size  = get_u16(glyph.glyfBlock + off);
+    program->bytes = glyph.glyfBlock + off + 2;
+}
+
+
+/* ---- */
+/* Main */
+/* ---- */
+static void write_prologue(FILE* file, const char* fontPath) {
+    fprintf(file,
+        "/* Generated by compile_font from %s, do not edit */\n"
+        "#include <stdlib.h>\n"
+        "#include \"truety.h\"\n"
+        "\n"
+        "#define TTY_C_ADD(a, b) ((TTY_S32)((TTY_U32)(a) + (TTY_U32)(b)))\n"
+        "#define TTY_C_SUB(a, b) ((TTY_S32)((TTY_U32)(a) - (TTY_U32)(b)))\n"
+        "#define TTY_C_MUL(a, b) ((TTY_S32)(((TTY_S64)(a) * (TTY_S64)(b) + 0x20) >> 6))\n"
+        "#define TTY_C_NEG(a)    ((TTY_S32)(0u - (TTY_U32)(a)))\n"
+        "#define TTY_C_FLOOR(a)  ((TTY_S32)((TTY_U32)(a) & 0xFFFFFFC0u))\n"
+        "\n"
+        "/* A program that over- or underflows the stack stops with an error. Pushes\n"
+        "   and pops follow a check for the number of values that they move. */\n"
+        "#define TTY_C_CHECK_PUSH(num)\\\n"
+        "    if (stack->cap - stack->count < (num)) return TTY_FALSE\n"
+        "\n"
+        "#define TTY_C_CHECK_POP(num)\\\n"
+        "    if (stack->count < (num)) return TTY_FALSE\n"
+        "\n"
+        "#define TTY_C_PUSH(val) (stack->buff[stack->count++] = (TTY_U32)(val))\n"
+        "#define TTY_C_POP(var)  ((var) = (TTY_S32)stack->buff[--stack->count])\n"
+        "\n"
+        "#define TTY_C_DROP()\\\n"
+        "    if (stack->count == 0) return TTY_FALSE; else stack->count--\n"
+        "\n"
+        "#define TTY_C_PEEK(var, pos)\\\n"
+        "    if (stack->count < (pos)) return TTY_FALSE; else (var) = (TTY_S32)stack->buff[stack->count - (pos)]\n"
+        "\n"
+        "#define TTY_C_EXEC(ins)\\\n"
+        "    if (!rt->execute(ctx, ins)) return TTY_FALSE\n"
+        "\n"
+        "#define TTY_C_CALL(funcId, count)\\\n"
+        "    if (!rt->call(ctx, funcId, count)) return TTY_FALSE\n"
+        "\n"
+        "#define TTY_C_CALL_STATIC(funcId, func)\\\n"
+        "    if (!(rt->funcs[funcId] == func ? func(ctx, rt, stack) : rt->call(ctx, funcId, 1))) return TTY_FALSE\n"
+        "\n"
+        "static inline TTY_S32 tty_c_div(TTY_S32 n2, TTY_S32 n1) {\n"
+        "    TTY_Bool isNeg = TTY_FALSE;\n"
+        "    if (n2 < 0) {\n"
+        "        n2    = -n2;\n"
+        "        isNeg = TTY_TRUE;\n"
+        "    }\n"
+        "    if (n1 < 0) {\n"
+        "        n1    = -n1;\n"
+        "        isNeg = !isNeg;\n"
+        "    }\n"
+        "    TTY_S32 result = ((TTY_S64)n2 << 6) / n1;\n"
+        "    return isNeg ? -result : result;\n"
+        "}\n"
+        "\n",
+        fontPath);
+}
+
+int main(int argc, char** argv) {
+    if (argc != 4) {
+        fprintf(stderr, "Usage: %s <font file> <output file> <module name>\n", argv[0]);
+        return 1;
+    }
+
+    const char* fontPath   = argv[1];
+    const char* outputPath = argv[2];
+    const char* moduleName = argv[3];
+
+    TTY_Font font;
+    if (tty_font_init(&font, fontPath)) {
+        fprintf(stderr, "Error: Failed to load %s\n", fontPath);
+        return 1;
+    }
+    if (!font.hasHinting) {
+        fprintf(stderr, "Error: %s doesn't have hinting\n", fontPath);
+        return 1;
+    }
+
+    // The CV program is executed so that the function ids it defines are known
+    TTY_Instance instance;
+    TTY_Bool     hasInstance = tty_instance_init(&font, &instance, 12, TTY_INSTANCE_DEFAULT) == TTY_ERROR_NONE;
+
+    Func*   funcs    = NULL;
+    TTY_U32 numFuncs = 0;
+    find_funcs(&font, &font.fpgm, &funcs, &numFuncs);
+    find_funcs(&font, &font.prep, &funcs, &numFuncs);
+    qsort(funcs, numFuncs, sizeof(Func), compare_funcs);
+
+    Compiler c       = {0};
+    Program  program = {0};
+
+    // Functions are compiled once to find out which ones can be called
+    // directly, then compiled again with that knowledge
+    c.numFuncIds = font.hint.funcs.cap;
+    c.funcNames  = calloc(c.numFuncIds + 1, sizeof(const char*));
+
+    for (TTY_U32 i = 0; i < numFuncs; i++) {
+        funcs[i].isCompiled = decode_program(funcs[i].bytes, funcs[i].size, &program) && compile_program(&c, &program);
+    }
+
+    for (TTY_U32 id = 0; id < c.numFuncIds; id++) {
+        TTY_Program* body = font.hint.funcs.bodies + id;
+        if (body->ops == NULL) {
+            continue;
+        }
+
+        TTY_U32 off = body->bytes - font.fileData + body->start;
+        for (TTY_U32 i = 0; i < numFuncs; i++) {
+            if (funcs[i].isCompiled && funcs[i].off == off && funcs[i].size == body->end - body->start) {
+                c.funcNames[id] = funcs[i].name;
+            }
+        }
+    }
+
+    FILE* file = fopen(outputPath, "w");
+    if (file == NULL) {
+        fprintf(stderr, "Error: Failed to open %s\n", outputPath);
+        return 1;
+    }
+    write_prologue(file, fontPath);
+
+    for (TTY_U32 i = 0; i < numFuncs; i++) {
+        if (funcs[i].isCompiled) {
+            fprintf(file, "static TTY_Bool %s(struct TTY_Program_Context* ctx, const TTY_Compiled_Runtime* rt, TTY_Interp_Stack* stack);\n", funcs[i].name);
+        }
+    }
+    fprintf(file, "\n");
+
+    TTY_U32 numCompiledFuncs = 0;
+    for (TTY_U32 i = 0; i < numFuncs; i++) {
+        if (funcs[i].isCompiled) {
+            decode_program(funcs[i].bytes, funcs[i].size, &program);
+            compile_program(&c, &program);
+            write_program(file, &c, funcs[i].name);
+            numCompiledFuncs++;
+        }
+    }
+
+    Glyph_Program* glyphs            = calloc(font.numGlyphs + 1, sizeof(Glyph_Program));
+    TTY_U32        numGlyphPrograms  = 0;
+    TTY_U32        numCompiledGlyphs = 0;
+
+    for (TTY_U32 i = 0; i < font.numGlyphs; i++) {
+        find_glyph_program(&font, i, glyphs + i);
+        if (glyphs[i].size == 0) {
+            continue;
+        }
+        numGlyphPrograms++;
+
+        if (decode_program(glyphs[i].bytes, glyphs[i].size, &program) && compile_program(&c, &program)) {
+            char name[32];
+            sprintf(name, "glyph_%u", (unsigned)i);
+            write_program(file, &c, name);
+            glyphs[i].isCompiled = TTY_TRUE;
+            numCompiledGlyphs++;
+        }
+    }
+
+    if (numCompiledFuncs > 0) {
+        fprintf(file, "static const TTY_Compiled_Func funcs[] = {\n");
+        for (TTY_U32 i = 0; i < numFuncs; i++) {
+            if (funcs[i].isCompiled) {
+                fprintf(file, "    { %u, %u, %s },\n", (unsigned)funcs[i].off, (unsigned)funcs[i].size, funcs[i].name);
+            }
+        }
+        fprintf(file, "};\n\n");
+    }
+
+    if (numCompiledGlyphs > 0) {
+        fprintf(file, "static const TTY_Compiled_Glyph glyphs[] = {\n");
+        for (TTY_U32 i = 0; i < font.numGlyphs; i++) {
+            if (glyphs[i].isCompiled) {
+                fprintf(file, "    { %u, glyph_%u },\n", (unsigned)i, (unsigned)i);
+            }
+        }
+        fprintf(file, "};\n\n");
+    }
+
+    fprintf(file, "const TTY_Compiled_Module %s = {\n", moduleName);
+    fprintf(file, "    0x%016llXull,\n", (unsigned long long)tty_font_get_checksum(&font));
+    fprintf(file, "    %u,\n", (unsigned)numCompiledFuncs);
+    fprintf(file, "    %u,\n", (unsigned)numCompiledGlyphs);
+    fprintf(file, "    %s,\n", numCompiledFuncs  > 0 ? "funcs"  : "NULL");
+    fprintf(file, "    %s,\n", numCompiledGlyphs > 0 ? "glyphs" : "NULL");
+    fprintf(file, "};\n");
+    fclose(file);
+
+    printf("Compiled %u of %u functions and %u of %u glyph programs into %s\n",
+           (unsigned)numCompiledFuncs, (unsigned)numFuncs, (unsigned)numCompiledGlyphs, (unsigned)numGlyphPrograms, outputPath);
+
+    free(glyphs);
+    free(funcs);
+    free(c.funcNames);
+    free(c.code.data);
+    free(c.vals);
+    free(c.isLocalRead);
+    free(c.isLabel);
+    free(c.isTarget);
+    free(c.hasElse);
+    free(program.ops);
+    free(program.values);
+    if (hasInstance) {
+        tty_instance_free(&instance);
+    }
+    tty_font_free(&font);
+    return 0;
+}